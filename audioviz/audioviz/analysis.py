@@ -0,0 +1,205 @@
+"""Incremental spectrum analysis on top of the native streaming STFT.
+
+Frames are computed on demand as the playhead advances, so startup cost and
+memory do not grow with track length. Samples come either from an audio
+chunk stream (SpectrumStream) or from a SampleRing fed by the audio device
+callback (RingSpectrum).
+"""
+
+from collections.abc import Iterator
+from typing import Optional
+
+import numpy as np
+
+import libaudioviz
+
+from .audio import AudioChunk
+
+
+class SpectrumStream:
+    """
+    Magnitude frames of an audio chunk stream, analysed lazily in order.
+    
+    Frame indices match scipy.signal.stft(..., nperseg, noverlap=nperseg - hop)
+    over the whole stream.
+    """
+    
+    def __init__(
+        self,
+        chunks: Iterator[AudioChunk],
+        num_samples: int,
+        channels: int,
+        nperseg: int,
+        hop: int,
+    ):
+        """
+        Args:
+            chunks: Audio chunks, e.g. from stream_audio()
+            num_samples: Total sample frames in the stream (for frame_count)
+            channels: Number of interleaved channels per chunk
+            nperseg: FFT window size
+            hop: Samples between consecutive frames
+        """
+        self._chunks = chunks
+        self._stft = libaudioviz.StreamingSTFT(nperseg, hop, channels)
+        self._frame = np.zeros((channels, self._stft.bins), dtype=np.float32)
+        self._next_index = 0
+        self.frame_count = libaudioviz.StreamingSTFT.frame_count(num_samples, nperseg, hop)
+    
+    @property
+    def bins(self) -> int:
+        """Frequency bins per frame (nperseg // 2 + 1)."""
+        return self._stft.bins
+    
+    def frame(self, index: int) -> Optional[np.ndarray]:
+        """
+        Advance to frame `index` and return its (channels, bins) magnitudes.
+        
+        Intermediate frames are analysed and dropped. Asking for an earlier
+        frame returns the most recent one. The returned array is reused by the
+        next call. Returns None once the stream is exhausted.
+        """
+        while self._next_index <= index:
+            # A chunk shorter than a hop, or the final flush, may add no frame
+            while self._stft.frames_available == 0:
+                if not self._feed():
+                    return None
+            self._stft.pop(self._frame)
+            self._next_index += 1
+        return self._frame
+    
+    def _feed(self) -> bool:
+        """Push the next chunk into the analyser. Returns False when nothing is left."""
+        if self._stft.finished:
+            return False
+        chunk = next(self._chunks, None)
+        if chunk is None:
+            self._stft.finish()
+        else:
+            self._stft.push(np.ascontiguousarray(chunk.samples, dtype=np.float32))
+        return True
+
+
+class RingSpectrum:
+    """
+    Magnitude frames of the samples arriving through a SampleRing.
+    
+    The consumer decides how far to read (e.g. up to what has been played),
+    and always gets the newest complete frame back.
+    """
+    
+    def __init__(self, ring: libaudioviz.SampleRing, nperseg: int, hop: int):
+        """
+        Args:
+            ring: Ring buffer filled by the audio callback
+            nperseg: FFT window size
+            hop: Samples between consecutive frames
+        """
+        self._ring = ring
+        self._nperseg = nperseg
+        self._hop = hop
+        self._stft = libaudioviz.StreamingSTFT(nperseg, hop, ring.channels)
+        self._block = np.empty((hop, ring.channels), dtype=np.float32)
+        self._frame = np.zeros((ring.channels, self._stft.bins), dtype=np.float32)
+        self._consumed = 0
+        # Frames analysed in total; ring frame and frame count at the last STFT start
+        self.frames = 0
+        self._start = 0
+        self._start_frames = 0
+    
+    @property
+    def bins(self) -> int:
+        """Frequency bins per frame (nperseg // 2 + 1)."""
+        return self._stft.bins
+    
+    def advance(self, target_frames: int) -> np.ndarray:
+        """
+        Analyse ring samples up to ring frame `target_frames` and return the
+        newest (channels, bins) magnitudes. The array is reused between calls
+        and stays zero until the first frame is complete.
+        """
+        while self._consumed < target_frames:
+            wanted = min(target_frames - self._consumed, len(self._block))
+            n = self._ring.pop_into(self._block[:wanted])
+            if n == 0:
+                break
+            self._consumed += n
+            self._stft.push(self._block[:n])
+            while self._stft.frames_available:
+                self._stft.pop(self._frame)
+                self.frames += 1
+        return self._frame
+    
+    @property
+    def consumed(self) -> int:
+        """Ring frames read (or skipped) so far."""
+        return self._consumed
+    
+    def newest_frame_end(self) -> Optional[int]:
+        """Ring frame just past the newest sample in the current magnitudes, or None before the first frame."""
+        since_start = self.frames - self._start_frames
+        if since_start == 0:
+            return None
+        return self._start + (since_start - 1) * self._hop + self._nperseg // 2
+    
+    def catch_up(self, max_backlog: int) -> int:
+        """
+        Drop all but the newest `max_backlog` unread ring frames, so a stalled
+        consumer resumes at current audio instead of working through old audio.
+        The STFT restarts after the gap. Returns the frames dropped.
+        """
+        excess = self._ring.available - max_backlog
+        if excess <= 0:
+            return 0
+        dropped = self._ring.skip(excess)
+        self._consumed += dropped
+        self._stft.reset()
+        self._start = self._consumed
+        self._start_frames = self.frames
+        return dropped
+
+
+BAND_SCALES = ('log', 'mel', 'bark')
+
+
+def band_rebinner(
+    nperseg: int,
+    sample_rate: int,
+    bands: int,
+    scale: str = 'log',
+) -> Optional[libaudioviz.BandRebinner]:
+    """
+    Rebinner from nperseg // 2 + 1 linear bins to `bands` display bands.
+    
+    Returns None when bands <= 0, meaning frames are drawn bin by bin.
+    """
+    if bands <= 0:
+        return None
+    return libaudioviz.BandRebinner(nperseg // 2 + 1, sample_rate, bands, scale)
+
+
+class BandMapper:
+    """
+    Rebins frames to a band count that may change from frame to frame.
+    
+    One rebinner and output buffer is kept per band count, so switching
+    between detail levels does not rebuild weights.
+    """
+    
+    def __init__(self, nperseg: int, sample_rate: int, scale: str = 'log'):
+        self._nperseg = nperseg
+        self._sample_rate = sample_rate
+        self._scale = scale
+        self._rebinners: dict[int, tuple[libaudioviz.BandRebinner, np.ndarray]] = {}
+    
+    def __call__(self, magnitudes: np.ndarray, bands: int) -> np.ndarray:
+        """Return `magnitudes` as `bands` bands; 0 or the bin count passes them through."""
+        if bands <= 0 or bands == len(magnitudes):
+            return magnitudes
+        entry = self._rebinners.get(bands)
+        if entry is None:
+            rebinner = band_rebinner(self._nperseg, self._sample_rate, bands, self._scale)
+            entry = (rebinner, np.empty(bands, dtype=np.float32))
+            self._rebinners[bands] = entry
+        rebinner, out = entry
+        return rebinner.apply(magnitudes, out=out)
@@ -1,16 +1,24 @@
-"""Audio file loading using soundfile with streaming support."""
+"""Audio file loading using soundfile with streaming support.
+
+prefetch_audio decodes natively on a background thread when libaudioviz can
+read the file, and falls back to soundfile otherwise. open_wav maps PCM WAV
+files for zero-copy access.
+"""
 
 from collections.abc import Generator
 from dataclasses import dataclass
 from pathlib import Path
+from typing import Optional
 
 import numpy as np
 import soundfile as sf
 
+import libaudioviz
+
 
 @dataclass(frozen=True, slots=True)
 class AudioChunk:
-    """A chunk of audio data with metadata."""
+    """A chunk of audio data with metadata (float32 samples unless requested otherwise)."""
     samples: np.ndarray
     sample_rate: int
     channels: int
@@ -50,7 +58,7 @@ def audio_info(filepath: str | Path) -> AudioInfo:
 def stream_audio(
     filepath: str | Path,
     chunk_size: int = 4096,
-    dtype: str | None = None,
+    dtype: str | None = 'float32',
 ) -> Generator[AudioChunk, None, None]:
     """
     Stream audio file in chunks for memory-efficient processing.
@@ -59,7 +67,8 @@ def stream_audio(
         filepath: Path to the audio file.
         chunk_size: Number of frames per chunk (default: 4096).
         dtype: Output dtype ('float32', 'float64', 'int16', 'int32').
-               If None, uses native format (no conversion).
+               Defaults to float32, what the native analysis consumes; if
+               None, uses soundfile's default (float64).
         
     Yields:
         AudioChunk containing samples, sample_rate, channels, and is_last flag.
@@ -86,3 +95,65 @@ def stream_audio(
                 channels=channels,
                 is_last=is_last,
             )
+
+
+def prefetch_audio(
+    filepath: str | Path,
+    chunk_size: int = 4096,
+    depth: int = 4,
+) -> Generator[AudioChunk, None, None]:
+    """
+    Stream float32 audio decoded ahead of the consumer on a native thread.
+    
+    Up to `depth` chunks are decoded in advance, so slow storage stalls the
+    decoder instead of the caller, and memory stays bounded by the pool. Falls
+    back to stream_audio when libaudioviz cannot decode the file natively
+    (not a plain WAV and no libsndfile support compiled in).
+    
+    Args:
+        filepath: Path to the audio file.
+        chunk_size: Number of frames per chunk (default: 4096).
+        depth: Number of chunks decoded ahead (default: 4).
+        
+    Yields:
+        AudioChunk with float32 samples, shaped like stream_audio's.
+    """
+    try:
+        decoder = libaudioviz.PrefetchDecoder(str(filepath), chunk_size, depth)
+    except RuntimeError:
+        if not Path(filepath).exists():
+            raise FileNotFoundError(filepath) from None
+        yield from stream_audio(filepath, chunk_size)
+        return
+    
+    decoded = 0
+    while (samples := decoder.read()) is not None:
+        # Same layout as soundfile: mono comes back 1-D
+        if decoder.channels == 1:
+            samples = samples.reshape(-1)
+        decoded += len(samples)
+        yield AudioChunk(
+            samples=samples,
+            sample_rate=decoder.sample_rate,
+            channels=decoder.channels,
+            is_last=len(samples) < chunk_size or decoded >= decoder.frames,
+        )
+
+
+def open_wav(filepath: str | Path) -> Optional[libaudioviz.WavFile]:
+    """
+    Memory-map a PCM or float32 WAV file for zero-copy reads.
+    
+    Samples stay in the page cache in their stored encoding and are converted
+    to float32 only where they are read, so a long file costs no decoded copy.
+    
+    Returns:
+        The mapped WavFile, or None if the file is not a WAV libaudioviz can map
+        (callers then fall back to prefetch_audio).
+    """
+    try:
+        return libaudioviz.WavFile(str(filepath))
+    except RuntimeError:
+        if not Path(filepath).exists():
+            raise FileNotFoundError(filepath) from None
+        return None
@@ -0,0 +1,300 @@
+"""On-disk spectrogram cache keyed by audio content.
+
+The first launch on a track analyses it once and writes a memory-mapped cache
+file; later launches open that file instantly and read frames straight from
+the mapping. Files are keyed by a hash of their size, modification time and
+first and last blocks, plus nperseg and hop, so edited files and other
+analysis settings never reuse a stale cache.
+"""
+
+import hashlib
+import os
+import threading
+from pathlib import Path
+from typing import Optional
+
+import numpy as np
+
+import libaudioviz
+
+from .audio import AudioInfo, open_wav, prefetch_audio
+
+
+def cache_dir() -> Path:
+    """Cache directory: $AUDIOVIZ_CACHE_DIR, else ~/.cache/audioviz."""
+    override = os.environ.get('AUDIOVIZ_CACHE_DIR')
+    if override:
+        return Path(override)
+    base = os.environ.get('XDG_CACHE_HOME') or Path.home() / '.cache'
+    return Path(base) / 'audioviz'
+
+
+def file_key(filepath: str | Path, block_size: int = 1 << 20) -> bytes:
+    """
+    32-byte BLAKE2b digest identifying the file's current contents.
+
+    Hashes the size, modification time and the first and last `block_size`
+    bytes rather than the whole file, so a cache hit costs two reads however
+    long the track is. Rewriting the file changes its mtime, which
+    invalidates the key.
+    """
+    stat = os.stat(filepath)
+    digest = hashlib.blake2b(digest_size=32)
+    digest.update(stat.st_size.to_bytes(8, 'little'))
+    digest.update(stat.st_mtime_ns.to_bytes(8, 'little', signed=True))
+    with open(filepath, 'rb') as f:
+        digest.update(f.read(block_size))
+        if stat.st_size > block_size:
+            f.seek(max(stat.st_size - block_size, block_size))
+            digest.update(f.read(block_size))
+    return digest.digest()
+
+
+def cache_path(key: bytes, nperseg: int, hop: int, directory: Optional[Path] = None) -> Path:
+    """Location of the cache for one file key and analysis setting."""
+    directory = cache_dir() if directory is None else directory
+    return directory / f"{key.hex()}-{nperseg}-{hop}.avzspec"
+
+
+def build_cache(
+    filepath: str | Path,
+    info: AudioInfo,
+    nperseg: int,
+    hop: int,
+    destination: Path,
+    key: bytes,
+    chunk_frames: int = 1024,
+    threads: int = 0,
+    cancel: Optional[threading.Event] = None,
+) -> Optional[libaudioviz.SpectrogramCache]:
+    """
+    Analyse the whole file into a new cache at `destination` and open it.
+    
+    Frames are written `chunk_frames` at a time, so memory stays bounded
+    however long the track is. WAV files are analysed straight from the
+    mapping on the thread pool; `threads` limits it (0: every core), e.g. to
+    leave a core free when building behind live playback. Other formats
+    stream from the prefetch decoder through the native STFT. Setting
+    `cancel` stops the build between chunks; nothing is written and None is
+    returned.
+    """
+    destination.parent.mkdir(parents=True, exist_ok=True)
+    writer = libaudioviz.SpectrogramCacheWriter(
+        str(destination), nperseg, hop, info.channels, info.sample_rate, key,
+    )
+    wav = open_wav(filepath)
+    if wav is not None:
+        total = libaudioviz.StreamingSTFT.frame_count(wav.frames, nperseg, hop)
+        out = np.empty((chunk_frames, wav.channels, nperseg // 2 + 1), dtype=np.float32)
+        for first in range(0, total, chunk_frames):
+            if cancel is not None and cancel.is_set():
+                return None  # The uncommitted file is removed with the writer
+            count = min(chunk_frames, total - first)
+            writer.append(libaudioviz.batch_stft(
+                wav, nperseg, hop, out=out[:count], threads=threads, first_frame=first, frames=count,
+            ))
+    else:
+        stft = libaudioviz.StreamingSTFT(nperseg, hop, info.channels)
+        out = np.empty((chunk_frames, info.channels, nperseg // 2 + 1), dtype=np.float32)
+        filled = 0
+        chunks = prefetch_audio(filepath)
+        while not stft.finished:
+            if cancel is not None and cancel.is_set():
+                return None
+            chunk = next(chunks, None)
+            if chunk is None:
+                stft.finish()  # Trailing padding, as scipy and batch_stft add
+            else:
+                stft.push(np.ascontiguousarray(chunk.samples, dtype=np.float32))
+            while stft.frames_available > 0:
+                stft.pop(out[filled])
+                filled += 1
+                if filled == chunk_frames:
+                    writer.append(out)
+                    filled = 0
+        if filled:
+            writer.append(out[:filled])
+    writer.commit()
+    return libaudioviz.SpectrogramCache(str(destination))
+
+
+def open_cache(
+    filepath: str | Path,
+    info: AudioInfo,
+    nperseg: int,
+    hop: int,
+    directory: Optional[Path] = None,
+) -> libaudioviz.SpectrogramCache:
+    """
+    Open the cache for `filepath`, building it first if it is missing or stale.
+
+    Args:
+        filepath: Audio file the spectrogram describes
+        info: Metadata for `filepath` (from audio_info)
+        nperseg: FFT window size
+        hop: Samples between consecutive frames
+        directory: Cache directory (default: cache_dir())
+    """
+    key = file_key(filepath)
+    path = cache_path(key, nperseg, hop, directory)
+    cache = load_cache(path, key, info, nperseg, hop)
+    if cache is not None:
+        return cache
+    return build_cache(filepath, info, nperseg, hop, path, key)
+
+
+def load_cache(
+    path: Path,
+    key: bytes,
+    info: AudioInfo,
+    nperseg: int,
+    hop: int,
+) -> Optional[libaudioviz.SpectrogramCache]:
+    """Open the cache at `path` if it exists and matches key and settings; None if it must be (re)built."""
+    if not path.exists():
+        return None
+    try:
+        cache = libaudioviz.SpectrogramCache(str(path))
+    except RuntimeError:
+        return None  # Truncated, corrupt or older format
+    if (cache.key == key and cache.nperseg == nperseg and cache.hop == hop
+            and cache.channels == info.channels):
+        return cache
+    return None
+
+
+class BackgroundCacheBuild:
+    """
+    build_cache() on a worker thread, so playback can start on live analysis
+    and switch to the cache once it is written.
+    """
+
+    def __init__(
+        self,
+        filepath: str | Path,
+        info: AudioInfo,
+        nperseg: int,
+        hop: int,
+        destination: Path,
+        key: bytes,
+    ):
+        """Start building; the arguments are those of build_cache()."""
+        self._cancel = threading.Event()
+        self._cache: Optional[libaudioviz.SpectrogramCache] = None
+        self._error: Optional[BaseException] = None
+        # One core stays with playback and rendering
+        threads = max(1, (os.cpu_count() or 2) - 1)
+        self._thread = threading.Thread(
+            target=self._run,
+            args=(filepath, info, nperseg, hop, destination, key, threads),
+            name='audioviz-cache-build',
+            daemon=True,
+        )
+        self._thread.start()
+
+    def _run(self, filepath, info, nperseg, hop, destination, key, threads) -> None:
+        try:
+            self._cache = build_cache(
+                filepath, info, nperseg, hop, destination, key,
+                threads=threads, cancel=self._cancel,
+            )
+        except Exception as e:
+            self._error = e
+
+    @property
+    def done(self) -> bool:
+        """Whether the build has finished, failed or been cancelled."""
+        return not self._thread.is_alive()
+
+    def result(self) -> Optional[libaudioviz.SpectrogramCache]:
+        """The finished cache (None if cancelled). Re-raises a build failure."""
+        self._thread.join()
+        if self._error is not None:
+            raise self._error
+        return self._cache
+
+    def cancel(self) -> None:
+        """Stop the build at the next chunk and wait for the worker."""
+        self._cancel.set()
+        self._thread.join()
+
+
+class CachedSpectrum:
+    """
+    Magnitude frames read from a spectrogram cache.
+
+    Mirrors RingSpectrum.advance() so the render loop does not care where
+    frames come from. When playback still feeds a SampleRing, the ring is
+    drained so the producer never stalls.
+    """
+
+    def __init__(
+        self,
+        cache: libaudioviz.SpectrogramCache,
+        ring: Optional[libaudioviz.SampleRing] = None,
+        prefetch_frames: int = 256,
+    ):
+        """
+        Args:
+            cache: Opened spectrogram cache
+            ring: Playback ring to drain, if any
+            prefetch_frames: Frames ahead of the playhead to ask the OS to page in
+        """
+        self._cache = cache
+        self._ring = ring
+        self._prefetch_frames = prefetch_frames
+        self._prefetched_until = 0
+        self._frame = np.zeros((cache.channels, cache.bins), dtype=np.float32)
+        self._blend = np.zeros_like(self._frame)
+        self.frame_count = cache.frames
+
+    @property
+    def bins(self) -> int:
+        """Frequency bins per frame (nperseg // 2 + 1)."""
+        return self._cache.bins
+
+    def frame(self, index: int) -> Optional[np.ndarray]:
+        """Decode frame `index` into the reused (channels, bins) array, or None past the end."""
+        if index >= self.frame_count:
+            return None
+        if index + self._prefetch_frames // 2 >= self._prefetched_until:
+            self._cache.prefetch(index, self._prefetch_frames)
+            self._prefetched_until = index + self._prefetch_frames
+        return self._cache.frame(index, self._frame)
+
+    def advance(self, target_frames: int) -> np.ndarray:
+        """
+        Return the newest frame complete after `target_frames` samples, like
+        RingSpectrum.advance(). Stays zero until the first frame is complete.
+        """
+        if self._ring is not None:
+            self._ring.skip(self._ring.available)
+
+        # Frame i ends nperseg // 2 samples past i * hop (scipy boundary padding)
+        reach = target_frames - self._cache.nperseg // 2
+        if reach < 0 or self.frame_count == 0:
+            return self._frame
+        index = min(reach // self._cache.hop, self.frame_count - 1)
+        return self.frame(index)
+
+    def interpolate(self, index: int, fraction: float) -> np.ndarray:
+        """
+        Blend frame `index` toward the next one by `fraction` (0..1), for a
+        scheduler that renders between STFT frames. The result is a reused
+        array; indices past the end hold the last frame.
+        """
+        if self._ring is not None:
+            self._ring.skip(self._ring.available)
+
+        if index < 0 or self.frame_count == 0:
+            return self._frame
+        index = min(index, self.frame_count - 1)
+        current = self.frame(index)
+        if fraction <= 0.0 or index + 1 >= self.frame_count:
+            return current
+
+        following = self._cache.frame(index + 1, self._blend)
+        np.subtract(following, current, out=following)
+        following *= fraction
+        following += current
+        return following
@@ -1,65 +1,319 @@
 """Command-line interface for AudioViz."""
 
 import argparse
-import scipy.signal
+from concurrent.futures import Future, ThreadPoolExecutor
+import os
+from pathlib import Path
 import sys
-import numpy as np
 import time
-import sounddevice as sd
+from typing import BinaryIO, Optional
 
-from .audio import audio_info, stream_audio
-from .state_manager import StateManager, StateManagerConfig
-from .visualizers import get_visualizer
-from .primitives import FrameCommands
+from .audio import AudioInfo, audio_info, open_wav, prefetch_audio
+from .analysis import BAND_SCALES, BandMapper, RingSpectrum
+from .cache import BackgroundCacheBuild, CachedSpectrum, cache_path, file_key, load_cache
+from .export import export_video
+from .live import LATENCY_BUDGET_MS, LIVE_HOP, LiveInput
+from .outputs import Output, OutputSpec
+from .playback import RingPlayback
+from .quality import QualityController, QualityLevel, quality_ladder
+from .startup import StartupTimeline
+from .visualizers import MODE_ORDER
 
 import libaudioviz
 
 
-def render_frame(renderer: libaudioviz.Renderer, commands: FrameCommands) -> None:
+# Longest sleep while holding a frame, so input stays responsive
+HOLD_POLL_MS = 5.0
+
+# Sleep while no new live audio has arrived; well under one capture period
+LIVE_POLL_MS = 1.0
+
+
+def print_stats(renderer: libaudioviz.Renderer, title: str = "Frame stats") -> None:
+    """Print the renderer's frame counters and per-stage timings."""
+    stats = renderer.get_stats()
+    print(f"\n{title}:")
+    print(f"  Frames: {stats['frames']}  late: {stats['late_frames']}  "
+          f"dropped: {stats['dropped_frames']}  unchanged (not redrawn): {stats['unchanged_frames']}")
+    print(f"  Heap allocations while recording: {stats['heap_allocations']}")
+    if stats['target_interval_ms'] > 0:
+        print(f"  Target interval: {stats['target_interval_ms']:.2f} ms")
+    print(f"  {'stage':<8} {'count':>7} {'mean':>8} {'p50':>8} {'p95':>8} {'p99':>8} {'max':>8}  (ms)")
+    for name, stage in stats['stages'].items():
+        if stage['count'] == 0:
+            continue
+        print(f"  {name:<8} {stage['count']:>7} {stage['mean_ms']:>8.3f} {stage['p50_ms']:>8.3f} "
+              f"{stage['p95_ms']:>8.3f} {stage['p99_ms']:>8.3f} {stage['max_ms']:>8.3f}")
+
+
+def print_output_stats(outputs: list[Output]) -> None:
+    """Print frame stats for each output, titled by its mode and size when there are several."""
+    if len(outputs) == 1:
+        print_stats(outputs[0].renderer)
+        return
+    for i, output in enumerate(outputs):
+        spec = output.spec
+        print_stats(output.renderer, f"Output {i} ({spec.mode} {spec.width}x{spec.height}@{spec.display})")
+
+
+def print_schedule(scheduler: libaudioviz.FrameScheduler) -> None:
+    """Print how often the scheduler rendered, held and skipped, and the pacing jitter."""
+    summary = scheduler.summary()
+    print(f"  Scheduler: rendered {summary['rendered']}  held {summary['held']}  "
+          f"skipped frames {summary['skipped']}")
+    if summary['presents'] > 1:
+        print(f"  Present interval: mean {summary['mean_interval_ms']:.2f} ms  "
+              f"jitter {summary['jitter_ms']:.2f} ms  max deviation {summary['max_deviation_ms']:.2f} ms")
+
+
+def unchanged_tolerance(args: argparse.Namespace) -> Optional[float]:
+    """Pixel tolerance for skipping unchanged frames, or None when every frame is redrawn."""
+    return None if args.redraw_unchanged else args.unchanged_tolerance
+
+
+def open_outputs(args: argparse.Namespace, specs: list[OutputSpec], threaded: bool) -> list[Output]:
+    """One window per output, all fed from the same analysis."""
+    auto_switch = None if args.no_auto_switch else 5.0
+    tolerance = unchanged_tolerance(args)
+    return [
+        Output(spec, threaded=threaded, auto_switch_interval=auto_switch, unchanged_tolerance_px=tolerance)
+        for spec in specs
+    ]
+
+
+def load_audio(args: argparse.Namespace, info: AudioInfo, timeline: StartupTimeline) -> RingPlayback:
+    """Map the track, or start decoding it, and open the playback device."""
+    with timeline.phase("audio"):
+        # WAV plays from the mapping; other formats stream from the prefetch
+        # decoder, so neither is held in memory whole
+        wav = open_wav(args.audio_file)
+        if wav is not None:
+            return RingPlayback(wav, info.sample_rate, blocksize=args.blocksize)
+        return RingPlayback(prefetch_audio(args.audio_file), info.sample_rate,
+                            blocksize=args.blocksize, channels=info.channels)
+
+
+def find_cache(
+    filepath: str, info: AudioInfo, nperseg: int, hop: int, timeline: StartupTimeline,
+) -> tuple[Optional[libaudioviz.SpectrogramCache], bytes, Path]:
+    """Look the spectrogram cache up; returns (cache or None if it must be built, key, path)."""
+    with timeline.phase("cache lookup"):
+        key = file_key(filepath)
+        path = cache_path(key, nperseg, hop)
+        return load_cache(path, key, info, nperseg, hop), key, path
+
+
+def start_cache(
+    lookup: Future, args: argparse.Namespace, info: AudioInfo, hop: int,
+) -> tuple[Optional[libaudioviz.SpectrogramCache], Optional[BackgroundCacheBuild]]:
+    """The cache the finished lookup found, or a background build of it when it is missing."""
+    try:
+        cache, key, path = lookup.result()
+    except OSError as e:
+        print(f"  Spectrogram cache unavailable ({e}); staying on live analysis", file=sys.stderr)
+        return None, None
+    if cache is not None:
+        print("  Opened spectrogram cache")
+        return cache, None
+    print("  Building spectrogram cache in the background; analysing live until it is ready")
+    return None, BackgroundCacheBuild(args.audio_file, info, args.nperseg, hop, path, key)
+
+
+def adopt_cache(build: BackgroundCacheBuild) -> Optional[libaudioviz.SpectrogramCache]:
+    """The finished background cache, or None if the build failed or was cancelled."""
+    try:
+        cache = build.result()
+    except Exception as e:
+        print(f"  Spectrogram cache build failed ({e}); staying on live analysis", file=sys.stderr)
+        return None
+    if cache is not None:
+        print("  Spectrogram cache ready")
+    return cache
+
+
+def output_spec(text: str) -> OutputSpec:
+    """Argparse type for --output, reporting malformed specs as usage errors."""
+    try:
+        return OutputSpec.parse(text)
+    except ValueError as e:
+        raise argparse.ArgumentTypeError(str(e)) from e
+
+
+def claim_stdout() -> BinaryIO:
     """
-    Send draw commands to the C++ renderer.
+    Take over stdout as a binary frame sink.
     
-    Args:
-        renderer: The C++ renderer instance
-        commands: Frame commands containing background color and draw batches
+    Fd 1 is redirected to stderr afterwards so that no other output (Python
+    prints or native logging) can interleave with the frames.
     """
-    # Clear with background color
-    bg = commands.background
-    renderer.clear(bg.r, bg.g, bg.b, bg.a)
+    sys.stdout.flush()
+    sink = os.fdopen(os.dup(sys.stdout.fileno()), 'wb')
+    os.dup2(sys.stderr.fileno(), sys.stdout.fileno())
+    return sink
+
+
+def run_export(args: argparse.Namespace, info: AudioInfo, sink: BinaryIO) -> int:
+    """Render the whole track headless and stream RGBA frames into `sink`."""
+    width, height = 1200, 800
     
-    # Draw each batch
-    for batch in commands.batches:
-        r, g, b, a = batch.color.as_tuple()
-        
-        if batch.rectangles:
-            # Convert Python Rect objects to C++ Rect objects
-            cpp_rects = [
-                libaudioviz.Rect(rect.x, rect.y, rect.width, rect.height) 
-                for rect in batch.rectangles
-            ]
-            renderer.draw_rectangles(cpp_rects, r, g, b, a)
-        
-        if batch.lines:
-            # Convert Python Line objects to C++ Line objects
-            cpp_lines = [
-                libaudioviz.Line(line.x1, line.y1, line.x2, line.y2) 
-                for line in batch.lines
-            ]
-            renderer.draw_lines(cpp_lines, r, g, b, a)
+    renderer = libaudioviz.Renderer(width, height)
+    renderer.initialize_headless()
+    
+    print(f"\nExporting {width}x{height} RGBA at {args.fps:g} fps (mode: {args.mode})...")
+    start = time.perf_counter()
+    with sink:
+        frames = export_video(
+            args.audio_file,
+            info,
+            sink,
+            mode=args.mode,
+            nperseg=args.nperseg,
+            fps=args.fps,
+            renderer=renderer,
+            bands=args.bands,
+            band_scale=args.band_scale,
+        )
+    elapsed = time.perf_counter() - start
     
-    # Present to screen
-    renderer.present()
+    speed = info.duration / elapsed if elapsed > 0 else float('inf')
+    print(f"Wrote {frames} frames in {elapsed:.2f} s ({speed:.1f}x realtime)")
+    print(f"  ffmpeg -f rawvideo -pix_fmt rgba -s {width}x{height} -r {args.fps:g} -i <frames> out.mp4")
+    if args.stats:
+        print_stats(renderer)
+    return 0
+
+
+def print_latency(renderer: libaudioviz.Renderer, budget_ms: float) -> None:
+    """Print mic-to-photon latency percentiles against the budget."""
+    latency = renderer.get_stats()['stages']['latency']
+    if latency['count'] == 0:
+        return
+    over = "over" if latency['p95_ms'] > budget_ms else "within"
+    print(f"  Mic to photon: p50 {latency['p50_ms']:.1f} ms  p95 {latency['p95_ms']:.1f} ms  "
+          f"max {latency['max_ms']:.1f} ms  ({over} the {budget_ms:g} ms budget)")
+
+
+def run_live(args: argparse.Namespace, timeline: StartupTimeline) -> int:
+    """Visualise the capture device as it records, each refresh drawing the newest audio."""
+    hop = args.hop or LIVE_HOP
+    with timeline.phase("audio"):
+        live = LiveInput(args.nperseg, hop, device=args.device)
+    print(f"Capturing: {args.device or 'default input'} at {live.sample_rate} Hz, "
+          f"period {live.capture.period} ({live.period_ms():.1f} ms), window {args.nperseg}, hop {hop}")
+    
+    to_bands = BandMapper(args.nperseg, live.sample_rate, args.band_scale)
+    full_bands = args.bands if args.bands > 0 else args.nperseg // 2 + 1
+    
+    # The render thread costs a refresh of latency, so a single window
+    # renders inline unless asked otherwise
+    specs = args.output or [OutputSpec(args.mode)]
+    threaded = args.render_thread or (len(specs) > 1 and sys.platform != 'darwin')
+    with timeline.phase("window"):
+        outputs = open_outputs(args, specs, threaded)
+    refresh_ms = min(
+        output.renderer.get_stats()['target_interval_ms'] or 1000.0 / 60.0 for output in outputs
+    )
+    expected_ms = live.period_ms() + refresh_ms * (2 if threaded else 1)
+    print(f"  Expected mic to photon: about {expected_ms:.1f} ms "
+          f"(budget {args.latency_budget_ms:g} ms)")
+    
+    if args.fixed_quality:
+        quality = None
+    else:
+        quality = QualityController(quality_ladder(full_bands), refresh_ms)
+    level = QualityLevel(full_bands)
+    
+    follower = libaudioviz.EnvelopeFollower() if args.smooth else None
+    hop_ms = 1000.0 * hop / live.sample_rate
+    
+    print("Listening... (Press Space to switch modes, Esc to quit)")
+    live.start()
+    shown_frames = 0
+    presented_last = False
+    try:
+        while True:
+            force = False
+            for output in outputs:
+                force = output.poll() or force
+            if not all(output.running for output in outputs):
+                break
+            
+            # Nothing new captured: hold briefly instead of redrawing
+            frame = live.latest()
+            if live.frames == shown_frames and not force:
+                presented_last = False
+                time.sleep(LIVE_POLL_MS / 1000.0)
+                continue
+            
+            if quality is not None and presented_last:
+                level = quality.update(max(output.renderer.last_frame_ms() for output in outputs))
+            
+            magnitudes = to_bands(frame[0], level.bands)
+            if follower is not None:
+                magnitudes = follower.process(magnitudes, (live.frames - shown_frames) * hop_ms)
+            shown_frames = live.frames
+            
+            captured = live.captured_at()
+            peaks = follower.peaks if follower is not None else None
+            for output in outputs:
+                if captured is not None:
+                    output.renderer.set_capture_time(captured)
+                output.draw(magnitudes, level, peaks)
+            presented_last = True
+            if timeline.first_frame():
+                print(f"First frame after {timeline.first_frame_ms:.0f} ms")
+    except KeyboardInterrupt:
+        print("\nStopping...")
+    finally:
+        live.stop()
+    
+    if live.dropped:
+        print(f"  Dropped {live.dropped} stale samples after stalls")
+    if args.stats:
+        print(timeline.report())
+        print_output_stats(outputs)
+        for output in outputs:
+            print_latency(output.renderer, args.latency_budget_ms)
+    return 0
 
 
 def main() -> int:
     """Main entry point."""
+    timeline = StartupTimeline()
     parser = argparse.ArgumentParser(
         description='AudioViz - Real-time Audio Visualization'
     )
     parser.add_argument(
         'audio_file',
         type=str,
-        help='Path to audio file (WAV, FLAC, etc.)',
+        nargs='?',
+        help='Path to audio file (WAV, FLAC, etc.); omit with --live',
+    )
+    parser.add_argument(
+        '--live',
+        action='store_true',
+        help='Visualise the capture device (microphone / line in) instead of a file',
+    )
+    parser.add_argument(
+        '--device',
+        type=str,
+        help='Capture device name for --live (default: system default input)',
+    )
+    parser.add_argument(
+        '--list-devices',
+        action='store_true',
+        help='List capture devices and exit',
+    )
+    parser.add_argument(
+        '--hop',
+        type=int,
+        help=f'Live analysis hop and device period in samples (default: {LIVE_HOP})',
+    )
+    parser.add_argument(
+        '--latency-budget-ms',
+        type=float,
+        default=LATENCY_BUDGET_MS,
+        help=f'Mic-to-photon target reported against with --live --stats (default: {LATENCY_BUDGET_MS:g})',
     )
     parser.add_argument(
         '--nperseg',
@@ -77,9 +331,84 @@ def main() -> int:
         '--mode',
         type=str,
         default='bars',
-        choices=['bars', 'circle'],
+        choices=MODE_ORDER,
         help='Initial visualization mode (default: bars)',
     )
+    parser.add_argument(
+        '--output',
+        type=output_spec,
+        action='append',
+        metavar='MODE[:WxH][@DISPLAY]',
+        help='Open a window for this output; repeat for several displays fed by one analysis '
+             '(default: one --mode window)',
+    )
+    parser.add_argument(
+        '--bands',
+        type=int,
+        default=128,
+        help='Aggregate FFT bins into this many display bands; 0 draws every bin (default: 128)',
+    )
+    parser.add_argument(
+        '--band-scale',
+        type=str,
+        default='log',
+        choices=BAND_SCALES,
+        help='Frequency spacing of the display bands (default: log)',
+    )
+    parser.add_argument(
+        '--fixed-quality',
+        action='store_true',
+        help='Keep full detail even when frames overrun the display refresh',
+    )
+    parser.add_argument(
+        '--render-thread',
+        action='store_true',
+        help='Render on a native thread so analysis overlaps presentation',
+    )
+    parser.add_argument(
+        '--unchanged-tolerance',
+        type=float,
+        default=1.0,
+        metavar='PX',
+        help='Frames within this many pixels of the one on screen are not redrawn (default: 1)',
+    )
+    parser.add_argument(
+        '--redraw-unchanged',
+        action='store_true',
+        help='Redraw and present every frame, even when it matches the one on screen',
+    )
+    parser.add_argument(
+        '--smooth',
+        action='store_true',
+        help='Smooth bands with attack/release and draw peak-hold markers on bars',
+    )
+    parser.add_argument(
+        '--interpolate',
+        action='store_true',
+        help='Blend between spectrogram frames on every refresh instead of holding (cache only)',
+    )
+    parser.add_argument(
+        '--export',
+        type=str,
+        metavar='PATH',
+        help="Render offscreen and write raw RGBA frames to PATH ('-' for stdout)",
+    )
+    parser.add_argument(
+        '--fps',
+        type=float,
+        default=60.0,
+        help='Frame rate of exported video (default: 60)',
+    )
+    parser.add_argument(
+        '--no-cache',
+        action='store_true',
+        help='Analyse while playing instead of using the on-disk spectrogram cache',
+    )
+    parser.add_argument(
+        '--stats',
+        action='store_true',
+        help='Print frame-time statistics on exit',
+    )
     parser.add_argument(
         '--no-auto-switch',
         action='store_true',
@@ -87,103 +416,191 @@ def main() -> int:
     )
     
     args = parser.parse_args()
+    if args.list_devices:
+        for name in libaudioviz.AudioCapture.devices():
+            print(name)
+        return 0
+    if args.live and (args.audio_file is not None or args.export is not None):
+        parser.error('--live takes no audio file and cannot be exported')
+    if not args.live and args.audio_file is None:
+        parser.error('an audio file is required unless --live is given')
+    if args.hop is not None and not 0 < args.hop <= args.nperseg:
+        parser.error('--hop must be between 1 and --nperseg')
+    playback = None
+    outputs: list[Output] = []
+    scheduler = None
+    cache_build = None
+    
+    # Claimed before anything is printed when frames are piped out
+    stdout_sink = claim_stdout() if args.export == '-' else None
     
     try:
+        if args.live:
+            return run_live(args, timeline)
+        
         # Load audio info
         print(f"Loading: {args.audio_file}")
-        info = audio_info(args.audio_file)
+        with timeline.phase("info"):
+            info = audio_info(args.audio_file)
         print(f"  Sample rate: {info.sample_rate} Hz")
         print(f"  Duration: {info.duration:.2f} seconds")
         print(f"  Channels: {info.channels}")
         print(f"  Frames: {info.frames}")
         
-        # Stream and concatenate samples for STFT
-        samples = np.concatenate([chunk.samples for chunk in stream_audio(args.audio_file)])
-        audio_samples = samples
-        
-        # Compute STFT for all channels
-        print(f"\nComputing STFT (window size: {args.nperseg})...")
+        if args.export is not None:
+            sink = stdout_sink if stdout_sink is not None else open(args.export, 'wb')
+            return run_export(args, info, sink)
         
-        if samples.ndim == 1:
-            samples = samples[:, np.newaxis]
-        
-        num_channels = samples.shape[1]
-        
-        # Compute STFT for each channel
-        stft_per_channel = []
-        for ch in range(num_channels):
-            f, t, Zxx = scipy.signal.stft(
-                samples[:, ch], 
-                fs=info.sample_rate, 
-                nperseg=args.nperseg, 
-                noverlap=args.nperseg // 2
+        # Windows open on the main thread (SDL video must live there on
+        # macOS) while workers map the track or start decoding it, open the
+        # audio device and look the spectrogram cache up. Only the audio is
+        # waited for; the lookup hashes the file and lands during playback.
+        hop = args.nperseg // 2
+        specs = args.output or [OutputSpec(args.mode)]
+        threaded = args.render_thread or (len(specs) > 1 and sys.platform != 'darwin')
+        pool = ThreadPoolExecutor(max_workers=2, thread_name_prefix='audioviz-startup')
+        try:
+            audio_future = pool.submit(load_audio, args, info, timeline)
+            cache_future = None if args.no_cache else pool.submit(
+                find_cache, args.audio_file, info, args.nperseg, hop, timeline,
             )
-            stft_per_channel.append(Zxx.T)
+            with timeline.phase("window"):
+                outputs.extend(open_outputs(args, specs, threaded))
+            playback = audio_future.result()
+        finally:
+            pool.shutdown(wait=False)
+        
+        # Frames follow exactly the samples the device has played. They are
+        # analysed live from the playback ring until the spectrogram cache is
+        # found (or built in the background), then read from the cache, so
+        # the first frame only waits for one hop.
+        spectrum: RingSpectrum | CachedSpectrum = RingSpectrum(playback.ring, args.nperseg, hop)
+        print(f"\nStreaming STFT (window size: {args.nperseg}, hop: {hop})...")
         
-        # Stack all channels: (Times, Channels, Freqs)
-        stft_channels = np.stack(stft_per_channel, axis=1)
-        time_per_frame = info.duration / len(stft_channels)
+        # Geometry and draw cost follow the band count, not the FFT size
+        to_bands = BandMapper(args.nperseg, info.sample_rate, args.band_scale)
+        full_bands = args.bands if args.bands > 0 else args.nperseg // 2 + 1
+        refresh_ms = min(
+            output.renderer.get_stats()['target_interval_ms'] or 1000.0 / 60.0 for output in outputs
+        )
         
-        # Initialize C++ Renderer
-        width, height = 1200, 800
-        renderer = libaudioviz.Renderer(width, height)
-        renderer.initialize_window()
+        # Drop detail when frames overrun the display refresh, restore it after
+        if args.fixed_quality:
+            quality = None
+        else:
+            quality = QualityController(quality_ladder(full_bands), refresh_ms)
+        level = QualityLevel(full_bands)
         
-        # Initialize state manager
-        auto_switch = None if args.no_auto_switch else 5.0
-        config = StateManagerConfig(
-            initial_mode=args.mode,
-            width=width,
-            height=height,
-            auto_switch_interval=auto_switch,
+        # The device clock decides which frame is due; a drawn frame reaches
+        # the screen one refresh later (two behind the render thread).
+        # Blending needs the next frame already, so only the cache can do it.
+        interpolate = args.interpolate and not args.no_cache
+        if args.interpolate and not interpolate:
+            print("  --interpolate needs the spectrogram cache; holding frames instead")
+        scheduler = libaudioviz.FrameScheduler(
+            info.sample_rate,
+            args.nperseg,
+            hop,
+            display_latency_ms=refresh_ms * (2 if threaded else 1),
+            interpolate=interpolate,
         )
-        state_manager = StateManager(config)
         
         print("Starting playback... (Press Space to switch modes, Esc to quit)")
         
-        # Start non-blocking audio playback
-        sd.play(audio_samples, info.sample_rate, blocksize=args.blocksize)
-        playback_start = time.time()
+        # Start callback-driven playback
+        playback.start()
+        
+        # Smoothing runs in playback time: each render advances it by the
+        # STFT frames (or fractions of one) since the previous render
+        follower = libaudioviz.EnvelopeFollower() if args.smooth else None
+        hop_ms = 1000.0 * hop / info.sample_rate
+        shown_position = -1.0
         
         # Main render loop
-        while True:
-            elapsed = time.time() - playback_start
-            frame_idx = int(elapsed / time_per_frame)
-            if frame_idx >= len(stft_channels):
-                break
-            
-            # Poll events and update state
-            events = renderer.poll_events()
-            state = state_manager.update(events)
+        presented_last = False
+        while not playback.finished:
+            # Poll every window; any event or mode change redraws them all
+            force = False
+            for output in outputs:
+                force = output.poll() or force
             
             # Check if we should quit
-            if not state.is_running or renderer.should_quit():
+            if not all(output.running for output in outputs):
                 break
             
-            # Get current magnitudes
-            magnitudes = np.abs(stft_channels[frame_idx][0]).astype(np.float32)
+            # Hold while the frame on screen is still the current one
+            tick = scheduler.tick(playback.played_frames(), force=force)
+            if not tick.render:
+                presented_last = False
+                time.sleep(min(tick.wait_ms, HOLD_POLL_MS) / 1000.0)
+                continue
+            # Switch to the cache as soon as the lookup or background build lands
+            cache = None
+            if cache_future is not None and cache_future.done():
+                cache, cache_build = start_cache(cache_future, args, info, hop)
+                cache_future = None
+            if cache_build is not None and cache_build.done:
+                cache = adopt_cache(cache_build)
+                cache_build = None
+            if cache is not None:
+                spectrum = CachedSpectrum(cache, playback.ring)
+            
+            # Until the cache exists there is no next frame to blend toward
+            if interpolate and isinstance(spectrum, CachedSpectrum):
+                frame = spectrum.interpolate(tick.frame, tick.fraction)
+            else:
+                frame = spectrum.advance(scheduler.frame_end(tick.frame))
+            
+            # Only back-to-back presents measure render cost; an interval
+            # that spans a hold is idle time. The slowest output sets the detail.
+            if quality is not None and presented_last:
+                level = quality.update(max(output.renderer.last_frame_ms() for output in outputs))
             
-            # Get visualizer and compute draw commands
-            visualizer = get_visualizer(state.mode)
-            commands = visualizer(magnitudes, state.width, state.height)
+            # Analysed once per frame (first channel); every output reads the
+            # same array
+            magnitudes = to_bands(frame[0], level.bands)
+            position = tick.frame + tick.fraction
+            if follower is not None:
+                magnitudes = follower.process(magnitudes, max(position - shown_position, 0.0) * hop_ms)
+            shown_position = position
             
-            # Render the frame
-            render_frame(renderer, commands)
+            peaks = follower.peaks if follower is not None else None
+            for output in outputs:
+                output.draw(magnitudes, level, peaks)
+            scheduler.frame_presented()
+            presented_last = True
+            if timeline.first_frame():
+                print(f"First frame after {timeline.first_frame_ms:.0f} ms")
         
-        sd.stop()
+        playback.stop()
         print("\nPlayback finished.")
+        if args.stats:
+            print(timeline.report())
+            print_output_stats(outputs)
+            print_schedule(scheduler)
+            if quality is not None:
+                print(f"  Detail changes: {quality.changes}  final: {level.bands} bands, "
+                      f"mirror {'on' if level.mirror else 'off'}")
         return 0
         
     except FileNotFoundError:
         print(f"Error: File not found: {args.audio_file}", file=sys.stderr)
         return 1
     except KeyboardInterrupt:
-        sd.stop()
+        if playback is not None:
+            playback.stop()
         print("\nStopping...")
+        if args.stats and outputs:
+            print_output_stats(outputs)
+            if scheduler is not None:
+                print_schedule(scheduler)
         return 0
     except Exception as e:
         print(f"An error occurred: {e}", file=sys.stderr)
         return 1
+    finally:
+        if cache_build is not None:
+            cache_build.cancel()
 
 
 if __name__ == '__main__':
@@ -0,0 +1,125 @@
+"""Offline rendering of a whole track to raw RGBA video frames.
+
+Frames are rendered headless and as fast as the CPU allows. Timing comes from
+the video frame index mapped onto STFT frame indices, never from the wall
+clock. The output is a stream of width * height * 4 byte frames that ffmpeg
+reads with `-f rawvideo -pix_fmt rgba -s WxH -r FPS -i -`.
+"""
+
+from collections.abc import Iterator
+from typing import BinaryIO, Optional
+
+import numpy as np
+
+import libaudioviz
+
+from .audio import AudioInfo, prefetch_audio
+from .analysis import SpectrumStream, band_rebinner
+from .outputs import render_frame
+from .primitives import BLACK
+from .visualizers import get_visualizer, get_native_visualizer
+
+
+def video_frame_count(num_samples: int, sample_rate: int, fps: float) -> int:
+    """Number of video frames covering `num_samples` at `fps` (at least one)."""
+    return max(1, int(np.ceil(num_samples * fps / sample_rate)))
+
+
+def frame_schedule(
+    num_samples: int,
+    sample_rate: int,
+    fps: float,
+    hop: int,
+    stft_frames: int,
+) -> Iterator[int]:
+    """
+    Yield the STFT frame index to show for each video frame.
+
+    STFT frame i is centred on sample i * hop, so video frame k at time k / fps
+    shows the frame whose centre is nearest. Indices never decrease and are
+    clamped to the last available frame.
+    """
+    samples_per_frame = sample_rate / fps
+    for k in range(video_frame_count(num_samples, sample_rate, fps)):
+        index = int(round(k * samples_per_frame / hop))
+        yield min(index, stft_frames - 1)
+
+
+def export_video(
+    path: str,
+    info: AudioInfo,
+    sink: BinaryIO,
+    mode: str = "bars",
+    nperseg: int = 1024,
+    fps: float = 60.0,
+    width: int = 1200,
+    height: int = 800,
+    renderer: Optional[libaudioviz.Renderer] = None,
+    bands: int = 0,
+    band_scale: str = "log",
+) -> int:
+    """
+    Render `path` offscreen and write raw RGBA frames to `sink`.
+
+    Args:
+        path: Audio file to render
+        info: Metadata for `path` (from audio_info)
+        sink: Binary file object receiving the frames (file or pipe)
+        mode: Visualization mode used for the whole track
+        nperseg: FFT window size
+        fps: Output frame rate
+        width: Frame width in pixels
+        height: Frame height in pixels
+        renderer: Headless renderer to draw with (e.g. to read its stats
+            afterwards); one of width x height is created when omitted
+        bands: Aggregate bins into this many bands before drawing (0 keeps
+            every bin)
+        band_scale: Band spacing: "log", "mel" or "bark"
+
+    Returns:
+        Number of frames written
+    """
+    hop = nperseg // 2
+    spectrum = SpectrumStream(
+        prefetch_audio(path),
+        info.frames,
+        info.channels,
+        nperseg,
+        hop,
+    )
+
+    if renderer is None:
+        renderer = libaudioviz.Renderer(width, height)
+        renderer.initialize_headless()
+    width, height = renderer.get_width(), renderer.get_height()
+
+    rebinner = band_rebinner(nperseg, info.sample_rate, bands, band_scale)
+    band_buffer = np.empty(bands, dtype=np.float32) if rebinner is not None else None
+
+    native = get_native_visualizer(mode)
+    visualizer = get_visualizer(mode)
+    pixels = np.empty((height, width, 4), dtype=np.uint8)
+
+    written = 0
+    schedule = frame_schedule(info.frames, info.sample_rate, fps, hop, spectrum.frame_count)
+    for index in schedule:
+        frame = spectrum.frame(index)
+        if frame is None:
+            break
+        magnitudes = frame[0]
+        if rebinner is not None:
+            magnitudes = rebinner.apply(magnitudes, out=band_buffer)
+
+        if native is not None:
+            renderer.clear(*BLACK.as_tuple())
+            native(renderer, magnitudes)
+            renderer.present()
+        else:
+            render_frame(renderer, visualizer(magnitudes, width, height))
+
+        renderer.read_pixels(pixels)
+        sink.write(memoryview(pixels))
+        written += 1
+
+    sink.flush()
+    return written
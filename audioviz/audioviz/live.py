@@ -0,0 +1,83 @@
+"""Live input: spectra of the capture device, analysed as the audio arrives.
+
+The device callback is native (libaudioviz.AudioCapture) and only pushes
+samples into a lock-free ring; this side drains whatever has arrived each
+refresh, so the shown frame always ends at the newest complete hop.
+"""
+
+from typing import Optional
+
+import numpy as np
+
+import libaudioviz
+
+from .analysis import RingSpectrum
+
+
+# Hop (and device period) for live input; 256 samples is 5.3 ms at 48 kHz
+LIVE_HOP = 256
+LIVE_SAMPLE_RATE = 48000
+
+# Mic-to-photon target the live mode is tuned for
+LATENCY_BUDGET_MS = 20.0
+
+
+class LiveInput:
+    """
+    Magnitude frames of a capture device, newest audio first.
+
+    The device period equals the hop, so every callback completes about one
+    STFT frame. If the consumer stalls (e.g. a window is being dragged), the
+    backlog is dropped rather than analysed late.
+    """
+
+    def __init__(
+        self,
+        nperseg: int,
+        hop: int = LIVE_HOP,
+        sample_rate: int = LIVE_SAMPLE_RATE,
+        channels: int = 1,
+        device: Optional[str] = None,
+    ):
+        """
+        Args:
+            nperseg: FFT window size
+            hop: Samples between frames, also requested as the device period
+            sample_rate: Requested capture rate; the device may grant another
+            channels: Captured channels
+            device: Capture device name (see AudioCapture.devices()), or the default
+        """
+        self.capture = libaudioviz.AudioCapture(sample_rate, channels, hop, device or "")
+        self.sample_rate = self.capture.sample_rate
+        self.hop = hop
+        self.spectrum = RingSpectrum(self.capture.ring, nperseg, hop)
+        # Unread audio beyond a window and two periods is already stale
+        self._max_backlog = nperseg + 2 * max(hop, self.capture.period)
+        self.dropped = 0
+
+    def start(self) -> None:
+        self.capture.start()
+
+    def stop(self) -> None:
+        self.capture.stop()
+
+    @property
+    def frames(self) -> int:
+        """STFT frames analysed so far; changes whenever there is new audio to show."""
+        return self.spectrum.frames
+
+    def latest(self) -> np.ndarray:
+        """Analyse everything captured so far and return the newest (channels, bins) magnitudes."""
+        self.dropped += self.spectrum.catch_up(self._max_backlog)
+        return self.spectrum.advance(self.spectrum.consumed + self.capture.ring.available)
+
+    def captured_at(self) -> Optional[float]:
+        """Steady-clock ms at which the newest sample of the latest frame was captured, or None."""
+        end = self.spectrum.newest_frame_end()
+        if end is None:
+            return None
+        return self.capture.captured_at(end - 1)
+
+    def period_ms(self) -> float:
+        """Duration of one device period in ms."""
+        return 1000.0 * self.capture.period / self.sample_rate
@@ -0,0 +1,160 @@
+"""Display outputs fed from one analysis pass.
+
+Each output is a window with its own Renderer, mode, size and state. The
+render loop analyses a frame once and hands the same magnitude array to
+every output; the native kernels read it in place, so an extra display
+costs its own drawing and nothing more.
+"""
+
+from dataclasses import dataclass
+import re
+from typing import Optional
+
+import numpy as np
+
+import libaudioviz
+
+from .primitives import FrameCommands, BLACK, WHITE
+from .quality import QualityLevel
+from .state_manager import StateManager, StateManagerConfig, VisualizationState
+from .visualizers import MODE_ORDER, get_visualizer, get_native_visualizer
+
+
+DEFAULT_WIDTH, DEFAULT_HEIGHT = 1200, 800
+
+_SPEC = re.compile(r'^(?P<mode>[\w-]+)(?::(?P<width>\d+)x(?P<height>\d+))?(?:@(?P<display>\d+))?$')
+
+
+def render_frame(renderer: libaudioviz.Renderer, commands: FrameCommands) -> None:
+    """
+    Send draw commands to the C++ renderer.
+
+    Args:
+        renderer: The C++ renderer instance
+        commands: Frame commands containing background color and draw batches
+    """
+    # Clear with background color
+    bg = commands.background
+    renderer.clear(bg.r, bg.g, bg.b, bg.a)
+
+    # Colours travel per vertex, so every batch after the clear merges into
+    # a single geometry submit however many colours the frame uses. Primitives
+    # are packed into (N, 4) arrays that the renderer reads in place.
+    for batch in commands.batches:
+        if batch.rectangles:
+            renderer.draw_colored_rectangles(batch.rect_array(), batch.rect_color_array())
+
+        if batch.lines:
+            renderer.draw_colored_lines(batch.line_array(), batch.line_color_array())
+
+    # Present to screen
+    renderer.present()
+
+
+@dataclass(frozen=True, slots=True)
+class OutputSpec:
+    """Mode, window size and display of one output."""
+    mode: str = "bars"
+    width: int = DEFAULT_WIDTH
+    height: int = DEFAULT_HEIGHT
+    display: int = 0
+
+    @staticmethod
+    def parse(text: str) -> "OutputSpec":
+        """
+        Parse MODE[:WIDTHxHEIGHT][@DISPLAY], e.g. 'circle:1920x1080@1'.
+
+        Raises:
+            ValueError: If the text is malformed or names an unknown mode
+        """
+        match = _SPEC.match(text.strip())
+        if match is None:
+            raise ValueError(f"Invalid output {text!r}; expected MODE[:WIDTHxHEIGHT][@DISPLAY]")
+        mode = match['mode']
+        if mode not in MODE_ORDER:
+            raise ValueError(f"Unknown mode {mode!r} in output {text!r}; choose from {', '.join(MODE_ORDER)}")
+        width = int(match['width']) if match['width'] else DEFAULT_WIDTH
+        height = int(match['height']) if match['height'] else DEFAULT_HEIGHT
+        if width <= 0 or height <= 0:
+            raise ValueError(f"Output size must be positive, got {width}x{height}")
+        display = int(match['display']) if match['display'] else 0
+        return OutputSpec(mode, width, height, display)
+
+
+class Output:
+    """
+    One window drawing the shared analysis in its own mode.
+
+    Events are routed to the window they happened in, so Space switches the
+    mode of the focused output only and closing a window stops the run.
+    """
+
+    def __init__(
+        self,
+        spec: OutputSpec,
+        threaded: bool = False,
+        auto_switch_interval: Optional[float] = 5.0,
+        headless: bool = False,
+        unchanged_tolerance_px: Optional[float] = None,
+    ):
+        """
+        Args:
+            spec: Mode, size and display of the window
+            threaded: Render on the renderer's own thread
+            auto_switch_interval: Seconds between automatic mode switches, or None
+            headless: Draw offscreen instead of opening a window
+            unchanged_tolerance_px: Skip redrawing frames within this many pixels
+                of the one on screen; None redraws every frame
+        """
+        self.spec = spec
+        self.renderer = libaudioviz.Renderer(spec.width, spec.height)
+        if headless:
+            self.renderer.initialize_headless()
+        else:
+            self.renderer.initialize_window(threaded=threaded, display=spec.display)
+        if unchanged_tolerance_px is not None:
+            self.renderer.set_skip_unchanged(True, unchanged_tolerance_px)
+        self.state_manager = StateManager(StateManagerConfig(
+            initial_mode=spec.mode,
+            width=spec.width,
+            height=spec.height,
+            auto_switch_interval=auto_switch_interval,
+        ))
+        self.state: VisualizationState = self.state_manager.state
+        self.shown_mode: Optional[str] = None
+
+    @property
+    def running(self) -> bool:
+        """Whether the window is still open and the user has not quit."""
+        return self.state.is_running and not self.renderer.should_quit()
+
+    def poll(self) -> bool:
+        """Handle this window's events; True when its next frame must be drawn regardless of the clock."""
+        events = self.renderer.poll_events()
+        self.state = self.state_manager.update(events)
+        return len(events) > 0 or self.state.mode != self.shown_mode
+
+    def draw(self, magnitudes: np.ndarray, level: QualityLevel, peaks: Optional[np.ndarray] = None) -> None:
+        """
+        Draw and present one frame in the output's current mode.
+
+        Args:
+            magnitudes: Display bands shared by every output; not modified
+            level: Detail level of the frame
+            peaks: Peak-hold levels drawn as markers in bars mode, if smoothing
+        """
+        state, renderer = self.state, self.renderer
+
+        # Prefer the native kernel; fall back to Python draw commands
+        native = get_native_visualizer(state.mode)
+        if native is not None:
+            renderer.clear(*BLACK.as_tuple())
+            native(renderer, magnitudes, mirror=level.mirror)
+            if peaks is not None and state.mode == "bars":
+                renderer.draw_peak_markers(peaks, *WHITE.as_tuple(), mirror=level.mirror)
+            renderer.present()
+        else:
+            visualizer = get_visualizer(state.mode)
+            commands = visualizer(magnitudes, state.width, state.height, mirror=level.mirror)
+            render_frame(renderer, commands)
+        self.shown_mode = state.mode
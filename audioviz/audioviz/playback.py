@@ -0,0 +1,172 @@
+"""Callback-driven playback that mirrors played samples into a native ring buffer."""
+
+from collections.abc import Iterator
+import threading
+
+import numpy as np
+import sounddevice as sd
+
+import libaudioviz
+
+from .audio import AudioChunk
+
+
+class RingPlayback:
+    """
+    Plays a sample buffer through a sounddevice callback stream.
+    
+    Every block handed to the device is also pushed into a SampleRing, so the
+    analysis side consumes exactly the samples being played, paced by the
+    device clock instead of wall-clock estimates.
+    
+    A mapped WavFile is never read in the callback: a feeder thread converts
+    blocks ahead of the play head into a second ring, with the pages after
+    them hinted in, so a page fault on a cold disk stalls the feeder rather
+    than the audio thread. The callback only copies from that ring. Decoded
+    formats stream through the same ring from chunks (e.g. prefetch_audio),
+    so memory stays bounded however long the track is.
+    """
+    
+    # Frames converted per feeder read
+    FEED_BLOCK = 4096
+    
+    def __init__(
+        self,
+        samples: np.ndarray | libaudioviz.WavFile | Iterator[AudioChunk],
+        sample_rate: int,
+        blocksize: int,
+        ring_seconds: float = 2.0,
+        feed_seconds: float = 0.5,
+        channels: int | None = None,
+    ):
+        """
+        Args:
+            samples: Audio of shape (N,) or (N, channels), a mapped WavFile
+                converted block by block on the feeder thread, or decoded
+                chunks pulled by the feeder thread
+            sample_rate: Playback rate in Hz
+            blocksize: Frames per device callback
+            ring_seconds: Analysis ring capacity in seconds of audio
+            feed_seconds: Audio the feeder keeps ready ahead of the callback
+            channels: Channels of the chunks; required with a chunk iterator
+        """
+        self._feed: libaudioviz.SampleRing | None = None
+        self._feeder: threading.Thread | None = None
+        self._feed_done = threading.Event()
+        self._stopping = threading.Event()
+        if isinstance(samples, libaudioviz.WavFile):
+            self._frames = samples.frames
+            self.channels = samples.channels
+            blocks = self._wav_blocks(samples, int(feed_seconds * sample_rate))
+        elif not isinstance(samples, np.ndarray):
+            if channels is None:
+                raise ValueError("channels is required when playing from chunks")
+            self._frames = None  # Ends when the chunks run out
+            self.channels = channels
+            blocks = (
+                np.ascontiguousarray(chunk.samples, dtype=np.float32).reshape(-1, channels)
+                for chunk in samples
+            )
+        else:
+            if samples.ndim == 1:
+                samples = samples[:, np.newaxis]
+            self._samples = np.ascontiguousarray(samples, dtype=np.float32)
+            self._frames = len(self._samples)
+            self.channels = self._samples.shape[1]
+            blocks = None
+        self.sample_rate = sample_rate
+        self.ring = libaudioviz.SampleRing(int(ring_seconds * sample_rate) + blocksize, self.channels)
+        self.finished = False
+        # Callbacks that found the feeder behind and played silence
+        self.underruns = 0
+        
+        # Filled before the stream starts, so the first callbacks have audio
+        if blocks is not None:
+            self._feed = libaudioviz.SampleRing(int(feed_seconds * sample_rate) + blocksize, self.channels)
+            self._feeder = threading.Thread(
+                target=self._feed_loop, args=(blocks,), name='audioviz-playback-feed', daemon=True,
+            )
+            self._feeder.start()
+        
+        self._position = 0
+        # (ring frame index, DAC time) of the most recent block, swapped atomically
+        self._clock: tuple[int, float] | None = None
+        try:
+            self._stream = sd.OutputStream(
+                samplerate=sample_rate,
+                channels=self.channels,
+                dtype='float32',
+                blocksize=blocksize,
+                callback=self._callback,
+                finished_callback=self._on_finished,
+            )
+        except Exception:
+            self._stopping.set()
+            raise
+    
+    def start(self) -> None:
+        self._stream.start()
+    
+    def stop(self) -> None:
+        self._stream.stop()
+        self._stream.close()
+        self._stopping.set()
+        if self._feeder is not None:
+            self._feeder.join()
+    
+    def played_frames(self) -> int:
+        """Frames pushed to the ring that have reached the speaker by now."""
+        clock = self._clock
+        if clock is None:
+            return 0
+        block_start, dac_time = clock
+        played = block_start + int((self._stream.time - dac_time) * self.sample_rate)
+        return max(0, min(played, self.ring.frames_written))
+    
+    def _wav_blocks(self, wav: libaudioviz.WavFile, ahead: int) -> Iterator[np.ndarray]:
+        """Convert the mapping block by block, hinting the pages `ahead` frames past each one."""
+        out = np.empty((self.FEED_BLOCK, wav.channels), dtype=np.float32)
+        for first in range(0, wav.frames, self.FEED_BLOCK):
+            count = min(self.FEED_BLOCK, wav.frames - first)
+            wav.will_need(first + count, ahead)
+            yield wav.read(first, count, out[:count])
+    
+    def _feed_loop(self, blocks: Iterator[np.ndarray]) -> None:
+        """Feeder thread: keep the feed ring full until the source runs out or playback stops."""
+        try:
+            for block in blocks:
+                offset = 0
+                while offset < len(block):
+                    offset += self._feed.push(block[offset:])
+                    if offset < len(block) and self._stopping.wait(0.005):
+                        return
+                if self._stopping.is_set():
+                    return
+        finally:
+            self._feed_done.set()
+    
+    def _callback(self, outdata: np.ndarray, frames: int, time_info, status) -> None:
+        start = self._position
+        if self._feed is not None:
+            n = self._feed.pop_into(outdata)
+            if n < frames and not self._feed_done.is_set():
+                self.underruns += 1
+        else:
+            n = min(frames, self._frames - start)
+            outdata[:n] = self._samples[start:start + n]
+        outdata[n:] = 0
+        
+        # Some host APIs report no DAC time; fall back to the stream latency
+        dac_time = time_info.outputBufferDacTime or (self._stream.time + self._stream.latency)
+        self._clock = (self.ring.frames_written, dac_time)
+        self.ring.push(outdata[:n])
+        
+        self._position += n
+        if self._feed is not None:
+            if self._feed_done.is_set() and self._feed.available == 0:
+                raise sd.CallbackStop
+        elif self._position >= self._frames:
+            raise sd.CallbackStop
+    
+    def _on_finished(self) -> None:
+        self.finished = True
@@ -1,6 +1,10 @@
 """Immutable primitive draw commands for the visualization layer."""
 
-from dataclasses import dataclass
+from collections.abc import Sequence
+from dataclasses import dataclass, field
+from typing import Optional
+
+import numpy as np
 
 
 @dataclass(frozen=True, slots=True)
@@ -49,12 +53,63 @@ class Line:
     
 
 
+class PackedLines(Sequence):
+    """
+    Read-only sequence of Line over an (N, 4) int32 array of (x1, y1, x2, y2).
+
+    Lines are only built when indexed or iterated; drawing reads the array.
+    """
+    __slots__ = ('array',)
+
+    def __init__(self, array: np.ndarray):
+        self.array = array
+
+    def __len__(self) -> int:
+        return len(self.array)
+
+    def __getitem__(self, index):
+        if isinstance(index, slice):
+            return tuple(self)[index]
+        return Line(*self.array[index].tolist())
+
+    def __iter__(self):
+        return (Line(*row) for row in self.array.tolist())
+
+    def __eq__(self, other) -> bool:
+        if isinstance(other, PackedLines):
+            return np.array_equal(self.array, other.array)
+        if isinstance(other, Sequence):
+            return tuple(self) == tuple(other)
+        return NotImplemented
+
+    def __hash__(self) -> int:
+        return hash(tuple(self))
+
+    def __repr__(self) -> str:
+        return f"PackedLines({len(self)} lines)"
+
+
+def gradient(start: Color, end: Color, count: int) -> np.ndarray:
+    """(count, 4) uint8 RGBA colours interpolated linearly from start to end."""
+    t = np.linspace(0.0, 1.0, count)[:, np.newaxis]
+    colors = (1.0 - t) * np.array(start.as_tuple()) + t * np.array(end.as_tuple())
+    return np.rint(colors).astype(np.uint8)
+
+
 @dataclass(frozen=True, slots=True)
 class DrawBatch:
-    """A batch of primitives to draw with the same color."""
+    """
+    A batch of primitives to draw with the same color, unless per-primitive
+    colours are given as (N, 4) uint8 RGBA arrays.
+    """
     rectangles: tuple[Rect, ...]
-    lines: tuple[Line, ...]
+    # A PackedLines view when the batch was built from an array
+    lines: Sequence[Line]
     color: Color
+    # (N, 4) int32 array behind `lines` when the batch was built from one
+    packed_lines: Optional[np.ndarray] = field(default=None, compare=False, repr=False)
+    rect_colors: Optional[np.ndarray] = field(default=None, compare=False, repr=False)
+    line_colors: Optional[np.ndarray] = field(default=None, compare=False, repr=False)
     
     @staticmethod
     def empty(color: Color = GREEN) -> "DrawBatch":
@@ -67,6 +122,54 @@ class DrawBatch:
     @staticmethod
     def from_lines(lines: list[Line], color: Color) -> "DrawBatch":
         return DrawBatch(rectangles=(), lines=tuple(lines), color=color)
+    
+    @staticmethod
+    def from_line_array(coords: np.ndarray, color: Color) -> "DrawBatch":
+        """Batch from an (N, 4) int32 array of (x1, y1, x2, y2); kept for line_array(), no Line objects built."""
+        coords = np.ascontiguousarray(coords, dtype=np.int32).reshape(-1, 4)
+        return DrawBatch(rectangles=(), lines=PackedLines(coords), color=color, packed_lines=coords)
+    
+    @staticmethod
+    def from_colored_rects(rects: list[Rect], colors: np.ndarray) -> "DrawBatch":
+        """Batch of rectangles with one RGBA colour each, e.g. from gradient()."""
+        colors = np.ascontiguousarray(colors, dtype=np.uint8).reshape(-1, 4)
+        if len(colors) != len(rects):
+            raise ValueError(f"Expected {len(rects)} colours, got {len(colors)}")
+        return DrawBatch(rectangles=tuple(rects), lines=(), color=WHITE, rect_colors=colors)
+    
+    @staticmethod
+    def from_colored_lines(lines: list[Line], colors: np.ndarray) -> "DrawBatch":
+        """Batch of lines with one RGBA colour each."""
+        colors = np.ascontiguousarray(colors, dtype=np.uint8).reshape(-1, 4)
+        if len(colors) != len(lines):
+            raise ValueError(f"Expected {len(lines)} colours, got {len(colors)}")
+        return DrawBatch(rectangles=(), lines=tuple(lines), color=WHITE, line_colors=colors)
+    
+    def rect_array(self) -> np.ndarray:
+        """Rectangles packed as a contiguous (N, 4) int32 array of (x, y, w, h)."""
+        return np.array(
+            [(r.x, r.y, r.width, r.height) for r in self.rectangles], dtype=np.int32
+        ).reshape(-1, 4)
+    
+    def line_array(self) -> np.ndarray:
+        """Lines packed as a contiguous (N, 4) int32 array of (x1, y1, x2, y2)."""
+        if self.packed_lines is not None:
+            return self.packed_lines
+        return np.array(
+            [(l.x1, l.y1, l.x2, l.y2) for l in self.lines], dtype=np.int32
+        ).reshape(-1, 4)
+    
+    def rect_color_array(self) -> np.ndarray:
+        """(N, 4) uint8 RGBA colour per rectangle."""
+        if self.rect_colors is not None:
+            return self.rect_colors
+        return np.tile(np.array(self.color.as_tuple(), dtype=np.uint8), (len(self.rectangles), 1))
+    
+    def line_color_array(self) -> np.ndarray:
+        """(N, 4) uint8 RGBA colour per line."""
+        if self.line_colors is not None:
+            return self.line_colors
+        return np.tile(np.array(self.color.as_tuple(), dtype=np.uint8), (len(self.lines), 1))
 
 
 @dataclass(frozen=True, slots=True)
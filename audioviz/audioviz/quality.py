@@ -0,0 +1,138 @@
+"""Adaptive level of detail driven by the renderer's measured frame times.
+
+The controller follows a moving average of the present-to-present interval.
+When frames overrun the refresh budget it steps down a ladder of cheaper
+settings (no mirroring, then fewer bands); once frames are back on budget
+for long enough it steps up again. Separate thresholds, a cooldown after
+every change and a growing recovery period after each failed step up keep
+it from oscillating between two levels.
+"""
+
+from dataclasses import dataclass
+from typing import Optional
+
+
+@dataclass(frozen=True, slots=True)
+class QualityLevel:
+    """One rung of the detail ladder."""
+    bands: int
+    mirror: bool = True
+
+
+@dataclass(frozen=True, slots=True)
+class QualityControllerConfig:
+    """Thresholds for the QualityController."""
+    downgrade_ratio: float = 1.25   # Step down when the average exceeds budget * this
+    upgrade_ratio: float = 1.05     # Frames under budget * this count towards recovery
+    smoothing: float = 0.1          # Weight of the newest frame in the moving average
+    cooldown_frames: int = 30       # Frames to wait after any change before stepping down
+    recover_frames: int = 180       # On-budget frames needed before stepping up
+    max_recover_frames: int = 1800  # Cap for the backoff after failed step ups
+
+
+def quality_ladder(bands: int, min_bands: int = 16) -> list[QualityLevel]:
+    """
+    Detail levels from full quality down, for a display with `bands` bands.
+
+    Mirroring goes first since it halves the primitive count without losing
+    frequency resolution; after that the band count halves per step.
+    """
+    levels = [QualityLevel(bands, mirror=True), QualityLevel(bands, mirror=False)]
+    count = bands // 2
+    while count >= min_bands:
+        levels.append(QualityLevel(count, mirror=False))
+        count //= 2
+    return levels
+
+
+class QualityController:
+    """
+    Picks a QualityLevel per frame from the measured frame interval.
+
+    Call update() once per frame with renderer.last_frame_ms() and draw with
+    the level it returns.
+    """
+
+    def __init__(
+        self,
+        levels: list[QualityLevel],
+        budget_ms: float,
+        config: Optional[QualityControllerConfig] = None,
+    ):
+        """
+        Args:
+            levels: Detail ladder, best first (see quality_ladder)
+            budget_ms: Frame budget, normally the display refresh interval
+            config: Thresholds; defaults when omitted
+        """
+        if not levels:
+            raise ValueError("levels must not be empty")
+        if budget_ms <= 0:
+            raise ValueError("budget_ms must be positive")
+        self._levels = levels
+        self._budget_ms = budget_ms
+        self._config = config or QualityControllerConfig()
+        self._index = 0
+        self._average_ms: Optional[float] = None
+        self._since_change = 0
+        self._on_budget = 0
+        self._recover_frames = self._config.recover_frames
+        self._upgraded = False
+        self._changes = 0
+
+    @property
+    def level(self) -> QualityLevel:
+        return self._levels[self._index]
+
+    @property
+    def level_index(self) -> int:
+        return self._index
+
+    @property
+    def average_ms(self) -> float:
+        return self._average_ms or 0.0
+
+    @property
+    def changes(self) -> int:
+        return self._changes
+
+    def update(self, frame_ms: float) -> QualityLevel:
+        """Feed one frame interval and return the level for the next frame."""
+        config = self._config
+        if frame_ms <= 0:
+            return self.level
+
+        if self._average_ms is None:
+            self._average_ms = frame_ms
+        else:
+            self._average_ms += config.smoothing * (frame_ms - self._average_ms)
+        self._since_change += 1
+
+        if self._average_ms > self._budget_ms * config.downgrade_ratio:
+            self._on_budget = 0
+            if self._since_change >= config.cooldown_frames and self._index + 1 < len(self._levels):
+                # A step up that did not hold makes the next attempt wait longer
+                if self._upgraded:
+                    self._recover_frames = min(self._recover_frames * 2, config.max_recover_frames)
+                self._change(self._index + 1, upgraded=False)
+        elif self._average_ms < self._budget_ms * config.upgrade_ratio:
+            self._on_budget += 1
+            if self._on_budget >= self._recover_frames and self._index > 0:
+                self._change(self._index - 1, upgraded=True)
+        else:
+            self._on_budget = 0
+
+        # Surviving a full recovery period means the step up held
+        if self._upgraded and self._since_change >= self._recover_frames:
+            self._upgraded = False
+            self._recover_frames = config.recover_frames
+        return self.level
+
+    def _change(self, index: int, upgraded: bool) -> None:
+        self._index = index
+        self._since_change = 0
+        self._on_budget = 0
+        self._upgraded = upgraded
+        self._changes += 1
+        # Start the new level from the budget rather than the old level's history
+        self._average_ms = self._budget_ms
@@ -0,0 +1,76 @@
+"""Startup timing: when each startup phase ran and how long until the first frame.
+
+Phases run concurrently (window creation on the main thread, audio loading
+and cache lookup on workers), so each one is recorded as a span from the
+start of startup rather than as a sequential duration.
+"""
+
+from contextlib import contextmanager
+from dataclasses import dataclass
+import threading
+import time
+from typing import Iterator, Optional
+
+
+@dataclass(frozen=True, slots=True)
+class PhaseSpan:
+    """One startup phase, in ms since startup began."""
+    name: str
+    start_ms: float
+    end_ms: float
+
+    @property
+    def duration_ms(self) -> float:
+        return self.end_ms - self.start_ms
+
+
+class StartupTimeline:
+    """Thread-safe record of startup phases and the time to first frame."""
+
+    def __init__(self, start: Optional[float] = None):
+        """
+        Args:
+            start: time.perf_counter() value startup is measured from (default: now)
+        """
+        self._start = time.perf_counter() if start is None else start
+        self._lock = threading.Lock()
+        self._phases: list[PhaseSpan] = []
+        self.first_frame_ms: Optional[float] = None
+
+    def elapsed_ms(self) -> float:
+        """Milliseconds since startup began."""
+        return (time.perf_counter() - self._start) * 1000.0
+
+    @contextmanager
+    def phase(self, name: str) -> Iterator[None]:
+        """Record the enclosed block as phase `name`; callable from any thread."""
+        start = self.elapsed_ms()
+        try:
+            yield
+        finally:
+            span = PhaseSpan(name, start, self.elapsed_ms())
+            with self._lock:
+                self._phases.append(span)
+
+    def first_frame(self) -> bool:
+        """Mark the first presented frame. Returns True only for the first call."""
+        if self.first_frame_ms is not None:
+            return False
+        self.first_frame_ms = self.elapsed_ms()
+        return True
+
+    @property
+    def phases(self) -> list[PhaseSpan]:
+        """Recorded phases, ordered by start time."""
+        with self._lock:
+            return sorted(self._phases, key=lambda span: span.start_ms)
+
+    def report(self) -> str:
+        """Multi-line summary of the phases and the time to first frame."""
+        lines = ["Startup:"]
+        for span in self.phases:
+            lines.append(f"  {span.name:<14} {span.start_ms:>8.1f} -> {span.end_ms:>8.1f} ms "
+                         f"({span.duration_ms:.1f} ms)")
+        if self.first_frame_ms is not None:
+            lines.append(f"  Time to first frame: {self.first_frame_ms:.1f} ms")
+        return "\n".join(lines)
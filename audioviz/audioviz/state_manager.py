@@ -8,7 +8,22 @@ from dataclasses import dataclass
 import time
 from typing import Optional
 
-from .visualizers import next_mode
+import numpy as np
+
+import libaudioviz
+
+from .visualizers import MODE_ORDER, next_mode
+
+
+# Event type codes, resolved once so filtering compares plain integers
+QUIT = int(libaudioviz.EventType.QUIT)
+KEYDOWN = int(libaudioviz.EventType.KEYDOWN)
+MOUSEDOWN = int(libaudioviz.EventType.MOUSEDOWN)
+RESIZE = int(libaudioviz.EventType.RESIZE)
+
+SDLK_SPACE = 32
+SDLK_ESCAPE = 27
+MODE_SWITCH_BUTTON = 1
 
 
 @dataclass(frozen=True, slots=True)
@@ -81,12 +96,12 @@ class StateManager:
         """Get the current state."""
         return self._state
     
-    def update(self, events: list[tuple[str, int, int]]) -> VisualizationState:
+    def update(self, events: np.ndarray) -> VisualizationState:
         """
         Process events and time, returning the new state.
         
         Args:
-            events: List of (event_type, data1, data2) from renderer.poll_events()
+            events: Record array of libaudioviz.EVENT_DTYPE from renderer.poll_events()
         
         Returns:
             The updated visualization state
@@ -102,27 +117,38 @@ class StateManager:
         
         return self._state
 
-    def _process_events(self, state: VisualizationState, events: list[tuple[str, int, int]]) -> VisualizationState:
-        """Pure-ish function to calculate next state based on events."""
+    def _process_events(self, state: VisualizationState, events: np.ndarray) -> VisualizationState:
+        """
+        Pure-ish function to calculate next state based on events.
+        
+        Works on whole columns, so the cost does not grow with the number
+        of events in the batch.
+        """
+        if len(events) == 0:
+            return state
+        types = events['type']
+        data1 = events['data1']
+        keydown = types == KEYDOWN
+        
         new_state = state
-        for event_type, data1, data2 in events:
-            if event_type == "quit":
-                return new_state.stopped()
-            
-            elif event_type == "resize":
-                new_state = new_state.with_size(data1, data2)
-            
-            elif event_type == "keydown":
-                # Space bar to switch modes manually
-                if data1 == 32:  # SDLK_SPACE
-                    self._switch_mode()
-                    new_state = new_state.with_mode(self._state.mode)
-                elif data1 == 27:  # SDLK_ESCAPE
-                    return new_state.stopped()
-            elif event_type == "mousedown":
-                if data1 == 1:  # SDL_BUTTON_RIGHT
-                    self._switch_mode()
-                    new_state = new_state.with_mode(self._state.mode)
+        resizes = np.flatnonzero(types == RESIZE)
+        if resizes.size:
+            last = events[resizes[-1]]
+            new_state = new_state.with_size(int(last['data1']), int(last['data2']))
+        
+        if np.any(types == QUIT) or np.any(keydown & (data1 == SDLK_ESCAPE)):
+            return new_state.stopped()
+        
+        # Space bar or mouse button switches modes; only the net cycle matters
+        switches = np.count_nonzero(
+            (keydown & (data1 == SDLK_SPACE)) | ((types == MOUSEDOWN) & (data1 == MODE_SWITCH_BUTTON))
+        )
+        if switches % len(MODE_ORDER):
+            for _ in range(switches % len(MODE_ORDER)):
+                self._switch_mode()
+            new_state = new_state.with_mode(self._state.mode)
+        elif switches:
+            self._last_switch_time = time.time()
         return new_state
     
     def _switch_mode(self) -> None:
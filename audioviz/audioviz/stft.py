@@ -0,0 +1,62 @@
+"""Whole-signal STFT computation on the native parallel engine.
+
+Magnitudes match scipy.signal.stft with its defaults (periodic Hann window,
+'spectrum' scaling, zero boundary padding, hop = nperseg - noverlap);
+channels and time segments are analysed on all cores.
+"""
+
+from typing import Optional
+
+import numpy as np
+
+import libaudioviz
+
+
+def compute_spectrogram(
+    samples: np.ndarray,
+    nperseg: int = 1024,
+    hop: Optional[int] = None,
+    threads: int = 0,
+) -> np.ndarray:
+    """
+    STFT magnitudes of a whole signal.
+    
+    Args:
+        samples: Audio of shape (N,) or (N, channels)
+        nperseg: FFT window size (power of two)
+        hop: Samples between frames (default: nperseg // 2)
+        threads: Worker threads including the caller (0: every core)
+    
+    Returns:
+        float32 magnitudes of shape (frames, channels, nperseg // 2 + 1)
+    """
+    hop = nperseg // 2 if hop is None else hop
+    samples = np.ascontiguousarray(samples, dtype=np.float32)
+    return libaudioviz.batch_stft(samples, nperseg, hop, threads=threads)
+
+
+def compute_stft(
+    samples: np.ndarray,
+    sample_rate: int,
+    nperseg: int = 1024,
+    noverlap: Optional[int] = None,
+) -> tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """
+    STFT of a mono signal, shaped like scipy.signal.stft's output.
+    
+    Args:
+        samples: Mono audio of shape (N,)
+        sample_rate: Sample rate in Hz
+        nperseg: FFT window size (power of two)
+        noverlap: Overlapping samples between frames (default: nperseg // 2)
+    
+    Returns:
+        (frequencies, times, magnitudes) with magnitudes of shape
+        (len(frequencies), len(times))
+    """
+    noverlap = nperseg // 2 if noverlap is None else noverlap
+    hop = nperseg - noverlap
+    magnitudes = compute_spectrogram(samples, nperseg, hop)[:, 0, :].T
+    frequencies = np.fft.rfftfreq(nperseg, d=1.0 / sample_rate)
+    times = np.arange(magnitudes.shape[1]) * hop / sample_rate
+    return frequencies, times, magnitudes
@@ -2,12 +2,20 @@
 
 Each visualizer takes frequency magnitudes and window dimensions, 
 returning FrameCommands that the renderer will draw.
+
+Built-in modes also have a native counterpart that hands the magnitudes
+straight to the C++ renderer, which builds the geometry itself. Modes
+registered only in C++ (libaudioviz.visualizer_modes()) are drawn through
+their native kernel.
 """
 
-from typing import Callable, Protocol
+from dataclasses import dataclass
+from typing import Callable, Optional, Protocol
 import numpy as np
 import math
 
+import libaudioviz
+
 from .primitives import (
     Rect, Line, DrawBatch, FrameCommands, Color,
     GREEN, CYAN
@@ -61,14 +69,9 @@ def bars_visualizer(
     
     # Apply logarithmic scaling to compress dynamic range
     if log_scale:
-        eps = 1e-10
-        db_values = 20.0 * np.log10(magnitudes + eps)
-        
-        # Normalize using fixed floor/ceiling so bars move with actual loudness
-        db_range = db_ceiling - db_floor
-        normalized = (db_values - db_floor) / db_range
-        normalized = np.clip(normalized, 0.0, 1.0)
-        processed_mags = normalized
+        # Fused native pass: 20*log10(mag + eps), then normalize against the
+        # fixed floor/ceiling so bars move with actual loudness, then clip
+        processed_mags = libaudioviz.normalize_db(magnitudes, db_floor, db_ceiling)
     else:
         # Linear scaling fallback - normalize to a fixed max
         fixed_max = 0.1
@@ -129,6 +132,77 @@ CIRCLE_SCALE = 3000.0
 BASE_RADIUS_RATIO = 0.2
 
 
+@dataclass(frozen=True, slots=True)
+class RadialLayout:
+    """
+    Precomputed geometry for circle_visualizer at one bin count and window size.
+    
+    Lines come in draw order (bin i, then its mirror image if it has one), so
+    each frame only scales the unit vectors by the magnitudes.
+    """
+    bins: np.ndarray        # Source bin per line
+    dir_x: np.ndarray       # Unit direction per line
+    dir_y: np.ndarray
+    base_x: np.ndarray      # Start point on the base circle per line (int32)
+    base_y: np.ndarray
+    center_x: int
+    center_y: int
+    base_radius: float
+    max_length: float
+    
+    @staticmethod
+    def build(size: int, width: int, height: int, base_radius_ratio: float, mirror: bool) -> "RadialLayout":
+        center_x = width // 2
+        center_y = height // 2
+        max_radius = min(width, height) / 2.0
+        base_radius = max_radius * base_radius_ratio
+        
+        bins = np.arange(size)
+        if mirror:
+            # Every bin except angle 0 (and pi for even sizes) gets a mirror line
+            mirrored = np.ones(size, dtype=bool)
+            mirrored[0] = False
+            if size % 2 == 0:
+                mirrored[size // 2] = False
+            repeats = np.where(mirrored, 2, 1)
+            bins = np.repeat(bins, repeats)
+            sign = np.ones(len(bins))
+            sign[np.cumsum(repeats)[mirrored] - 1] = -1.0
+        else:
+            sign = np.ones(size)
+        
+        angles = bins * (2.0 * math.pi / size)
+        dir_x = np.cos(angles)
+        dir_y = np.sin(angles) * sign
+        return RadialLayout(
+            bins=bins,
+            dir_x=dir_x,
+            dir_y=dir_y,
+            base_x=(center_x + dir_x * base_radius).astype(np.int32),
+            base_y=(center_y + dir_y * base_radius).astype(np.int32),
+            center_x=center_x,
+            center_y=center_y,
+            base_radius=base_radius,
+            max_length=max_radius - base_radius,
+        )
+
+
+# Radial layouts of circle_visualizer, one slot per window size so outputs of
+# different sizes keep theirs; rebuilt only on bin-count or style change
+_RADIAL_LAYOUTS: dict[tuple, tuple[tuple, RadialLayout]] = {}
+
+
+def radial_layout(size: int, width: int, height: int, base_radius_ratio: float, mirror: bool) -> RadialLayout:
+    """Return the cached RadialLayout for these parameters, rebuilding it if they changed."""
+    key = (size, width, height, base_radius_ratio, mirror)
+    slot = (width, height)
+    cached = _cache_slot(_RADIAL_LAYOUTS, slot)
+    if cached is None or cached[0] != key:
+        cached = (key, RadialLayout.build(*key))
+        _RADIAL_LAYOUTS[slot] = cached
+    return cached[1]
+
+
 def circle_visualizer(
     magnitudes: np.ndarray,
     width: int,
@@ -154,53 +228,145 @@ def circle_visualizer(
     if size == 0:
         return FrameCommands.single_batch(DrawBatch.empty(color))
     
-    center_x = width // 2
-    center_y = height // 2
-    max_radius = min(width, height) / 2.0
-    base_radius = max_radius * base_radius_ratio
+    layout = radial_layout(size, width, height, base_radius_ratio, mirror)
     
-    lines: list[Line] = []
-    angle_step = 2.0 * math.pi / size
+    # Trig lives in the layout; per frame this is one scale-and-add per line
+    lengths = np.minimum(np.asarray(magnitudes, dtype=np.float64)[layout.bins] * scale, layout.max_length)
+    outer = layout.base_radius + lengths
+    coords = np.empty((len(layout.bins), 4), dtype=np.int32)
+    coords[:, 0] = layout.base_x
+    coords[:, 1] = layout.base_y
+    coords[:, 2] = (layout.center_x + layout.dir_x * outer).astype(np.int32)
+    coords[:, 3] = (layout.center_y + layout.dir_y * outer).astype(np.int32)
     
-    for i, mag in enumerate(magnitudes):
-        line_len = min(mag * scale, max_radius - base_radius)
-        angle = i * angle_step
-        
-        # Start point on base circle
-        x1 = int(center_x + math.cos(angle) * base_radius)
-        y1 = int(center_y + math.sin(angle) * base_radius)
-        
-        # End point
-        x2 = int(center_x + math.cos(angle) * (base_radius + line_len))
-        y2 = int(center_y + math.sin(angle) * (base_radius + line_len))
-        
-        lines.append(Line(x1, y1, x2, y2))
-        
-        if mirror:
-            is_zero_angle = (i == 0)
-            is_pi_angle = (size % 2 == 0 and i == size // 2)
-            
-            if not(is_zero_angle or is_pi_angle):
-                # Mirror across horizontal axis
-                angle_mirror = -angle
-                x1m = int(center_x + math.cos(angle_mirror) * base_radius)
-                y1m = int(center_y + math.sin(angle_mirror) * base_radius)
-                x2m = int(center_x + math.cos(angle_mirror) * (base_radius + line_len))
-                y2m = int(center_y + math.sin(angle_mirror) * (base_radius + line_len))
-                lines.append(Line(x1m, y1m, x2m, y2m))
-    
-    batch = DrawBatch.from_lines(lines, color)
+    batch = DrawBatch.from_line_array(coords, color)
     return FrameCommands.single_batch(batch)
 
 
+class NativeVisualizer(Protocol):
+    """Protocol for visualizers that draw directly through the C++ renderer."""
+    def __call__(
+        self,
+        renderer: libaudioviz.Renderer,
+        magnitudes: np.ndarray,
+    ) -> None:
+        ...
+
+
+# Retained display lists, one per native mode and window size, so several
+# windows of different sizes do not rebuild each other's lists every frame.
+# Rebuilt only when the bin count or style changes; otherwise updated in place.
+_DISPLAY_LISTS: dict[tuple, tuple[tuple, libaudioviz.DisplayList]] = {}
+
+# Window sizes kept per cache before the oldest entry is dropped (resizing
+# a window leaves its old sizes behind)
+_MAX_RETAINED = 8
+
+
+def _cache_slot(cache: dict, slot: tuple) -> Optional[tuple]:
+    """Look up a cache slot, evicting the oldest slot when a new one would overflow."""
+    cached = cache.get(slot)
+    if cached is None and len(cache) >= _MAX_RETAINED:
+        del cache[next(iter(cache))]
+    return cached
+
+
+def _retained_list(
+    mode: str,
+    key: tuple,
+    build: Callable[[], libaudioviz.DisplayList],
+) -> libaudioviz.DisplayList:
+    """Return the cached display list for a mode, rebuilding it if the key changed."""
+    # key starts with (size, width, height)
+    slot = (mode, key[1], key[2])
+    cached = _cache_slot(_DISPLAY_LISTS, slot)
+    if cached is None or cached[0] != key:
+        cached = (key, build())
+        _DISPLAY_LISTS[slot] = cached
+    return cached[1]
+
+
+def bars_native(
+    renderer: libaudioviz.Renderer,
+    magnitudes: np.ndarray,
+    color: Color = GREEN,
+    scale: float = BAR_SCALE,
+    mirror: bool = True,
+    log_scale: bool = True,
+    db_floor: float = BAR_DB_FLOOR,
+    db_ceiling: float = BAR_DB_CEILING,
+) -> None:
+    """Native equivalent of bars_visualizer, sized to the renderer's window."""
+    size, width, height = len(magnitudes), renderer.get_width(), renderer.get_height()
+    key = (size, width, height, color, scale, mirror, log_scale, db_floor, db_ceiling)
+    display_list = _retained_list("bars", key, lambda: libaudioviz.DisplayList.bars(
+        size, width, height, *color.as_tuple(),
+        scale=scale, mirror=mirror, log_scale=log_scale,
+        db_floor=db_floor, db_ceiling=db_ceiling,
+    ))
+    display_list.update(np.asarray(magnitudes, dtype=np.float32))
+    renderer.draw_display_list(display_list)
+
+
+def circle_native(
+    renderer: libaudioviz.Renderer,
+    magnitudes: np.ndarray,
+    color: Color = CYAN,
+    scale: float = CIRCLE_SCALE,
+    base_radius_ratio: float = BASE_RADIUS_RATIO,
+    mirror: bool = True,
+) -> None:
+    """Native equivalent of circle_visualizer, sized to the renderer's window."""
+    size, width, height = len(magnitudes), renderer.get_width(), renderer.get_height()
+    key = (size, width, height, color, scale, base_radius_ratio, mirror)
+    display_list = _retained_list("circle", key, lambda: libaudioviz.DisplayList.radial(
+        size, width, height, *color.as_tuple(),
+        scale=scale, base_radius_ratio=base_radius_ratio, mirror=mirror,
+    ))
+    display_list.update(np.asarray(magnitudes, dtype=np.float32))
+    renderer.draw_display_list(display_list)
+
+
+# Native kernels for modes registered in C++, one per mode and window size
+# (kernels keep size-dependent layouts). Remade only when the options change,
+# since the options pick the kernel's specialisation.
+_KERNELS: dict[tuple, tuple[tuple, libaudioviz.Visualizer]] = {}
+
+
+def kernel_native(mode: str) -> NativeVisualizer:
+    """Native visualizer drawing through the C++ kernel registered for `mode`."""
+    def draw(
+        renderer: libaudioviz.Renderer,
+        magnitudes: np.ndarray,
+        color: Color = CYAN,
+        **options: float,
+    ) -> None:
+        key = tuple(sorted(options.items()))
+        slot = (mode, renderer.get_width(), renderer.get_height())
+        cached = _cache_slot(_KERNELS, slot)
+        if cached is None or cached[0] != key:
+            cached = (key, libaudioviz.Visualizer(mode, **options))
+            _KERNELS[slot] = cached
+        cached[1].draw(renderer, np.asarray(magnitudes, dtype=np.float32), *color.as_tuple())
+    return draw
+
+
 # Registry of available visualizers - easy to extend
 VISUALIZERS: dict[str, Visualizer] = {
     "bars": bars_visualizer,
     "circle": circle_visualizer,
 }
 
-# Ordered list for cycling through modes
-MODE_ORDER = list(VISUALIZERS.keys())
+# Native fast paths, keyed by the same mode names
+NATIVE_VISUALIZERS: dict[str, NativeVisualizer] = {
+    "bars": bars_native,
+    "circle": circle_native,
+}
+
+# Ordered list for cycling through modes, including modes only registered natively
+MODE_ORDER = list(VISUALIZERS.keys()) + [
+    mode for mode in libaudioviz.visualizer_modes() if mode not in VISUALIZERS
+]
 
 
 def get_visualizer(name: str) -> Visualizer:
@@ -208,6 +374,14 @@ def get_visualizer(name: str) -> Visualizer:
     return VISUALIZERS.get(name, bars_visualizer)
 
 
+def get_native_visualizer(name: str) -> Optional[NativeVisualizer]:
+    """Get the native fast path for a mode, or None if it only exists in Python."""
+    native = NATIVE_VISUALIZERS.get(name)
+    if native is None and name in libaudioviz.visualizer_modes():
+        native = kernel_native(name)
+    return native
+
+
 def next_mode(current: str) -> str:
     """Get the next mode in the cycle."""
     try:
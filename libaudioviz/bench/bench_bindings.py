@@ -0,0 +1,83 @@
+"""
+Binding conversion cost of Renderer.draw_rectangles / draw_lines.
+
+Times one headless frame (clear, draw, present) per input form, so the
+difference between rows is what pybind11 spends turning the argument into
+primitives: a list of Rect / Line objects is converted element by element
+into the frame arena, an (N, 4) int32 array is read in place.
+
+    python libaudioviz/bench/bench_bindings.py [--min-ms MS]
+"""
+
+import argparse
+import time
+
+import numpy as np
+
+import libaudioviz
+
+
+WIDTH, HEIGHT = 1200, 800
+COUNTS = (64, 512, 4096, 32768)
+
+
+def per_frame_ms(renderer: libaudioviz.Renderer, draw, min_ms: float) -> float:
+    """Mean milliseconds of one frame drawn by `draw(renderer)`, over at least min_ms."""
+    def frame() -> None:
+        renderer.clear(0, 0, 0, 255)
+        draw(renderer)
+        renderer.present()
+
+    frame()
+    frames = 0
+    start = time.perf_counter()
+    elapsed = 0.0
+    while elapsed * 1000.0 < min_ms or frames < 5:
+        frame()
+        frames += 1
+        elapsed = time.perf_counter() - start
+    return elapsed * 1000.0 / frames
+
+
+def main() -> None:
+    """Print per-frame times and per-primitive conversion overhead for each input form."""
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--min-ms', type=float, default=300.0, help='Minimum time per case (default: 300)')
+    args = parser.parse_args()
+
+    renderer = libaudioviz.Renderer(WIDTH, HEIGHT)
+    renderer.initialize_headless()
+    rng = np.random.default_rng(42)
+
+    print(f"{'case':<10} {'count':>6} {'input':<8} {'frame ms':>10} {'ns/prim over array':>20}")
+    for count in COUNTS:
+        rects = np.column_stack([
+            rng.integers(0, WIDTH, count), rng.integers(0, HEIGHT, count),
+            np.full(count, 2), rng.integers(0, HEIGHT // 4, count),
+        ]).astype(np.int32)
+        lines = np.column_stack([
+            np.full(count, WIDTH // 2), np.full(count, HEIGHT // 2),
+            rng.integers(0, WIDTH, count), rng.integers(0, HEIGHT, count),
+        ]).astype(np.int32)
+
+        cases = {
+            'rects': (renderer.draw_rectangles, rects, libaudioviz.Rect),
+            'lines': (renderer.draw_lines, lines, libaudioviz.Line),
+        }
+        for name, (draw, array, primitive) in cases.items():
+            # The array comes first: it is the baseline for the overhead column
+            inputs = {
+                'array': array,
+                'objects': [primitive(*row) for row in array.tolist()],
+            }
+            baseline = None
+            for kind, data in inputs.items():
+                ms = per_frame_ms(renderer, lambda r: draw(data, 0, 255, 0, 255), args.min_ms)
+                if baseline is None:
+                    baseline = ms
+                overhead_ns = (ms - baseline) * 1e6 / count
+                print(f"{name:<10} {count:>6} {kind:<8} {ms:>10.4f} {overhead_ns:>20.1f}")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,130 @@
+// Before/after microbenchmark for primitive submission.
+//
+// "per-call" is the old path (one SDL_RenderFillRect / SDL_RenderDrawLine per
+// primitive); "batched" is what Renderer does now (one SDL_RenderFillRects /
+// SDL_RenderGeometry per batch). Runs on a hidden window when a video driver is
+// available and falls back to a software renderer on an offscreen surface.
+//
+//   ./bench_draw [frames]
+
+#include <SDL2/SDL.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "geometry.h"
+
+namespace {
+
+constexpr int kWidth = 1200;
+constexpr int kHeight = 800;
+
+struct Target {
+    SDL_Window* window = nullptr;
+    SDL_Surface* surface = nullptr;
+    SDL_Renderer* renderer = nullptr;
+    const char* kind = "";
+};
+
+Target open_target() {
+    Target t;
+    if (SDL_Init(SDL_INIT_VIDEO) == 0) {
+        t.window = SDL_CreateWindow("bench_draw", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                                    kWidth, kHeight, SDL_WINDOW_HIDDEN);
+        if (t.window) {
+            t.renderer = SDL_CreateRenderer(t.window, -1, SDL_RENDERER_ACCELERATED);
+            t.kind = "accelerated";
+        }
+    }
+    if (!t.renderer) {
+        t.surface = SDL_CreateRGBSurfaceWithFormat(0, kWidth, kHeight, 32, SDL_PIXELFORMAT_RGBA32);
+        t.renderer = SDL_CreateSoftwareRenderer(t.surface);
+        t.kind = "software";
+    }
+    if (!t.renderer) {
+        std::fprintf(stderr, "Could not create a renderer: %s\n", SDL_GetError());
+        std::exit(1);
+    }
+    return t;
+}
+
+void close_target(Target& t) {
+    SDL_DestroyRenderer(t.renderer);
+    if (t.window) SDL_DestroyWindow(t.window);
+    if (t.surface) SDL_FreeSurface(t.surface);
+    SDL_Quit();
+}
+
+// Milliseconds per frame for a draw routine, including the flush to the backend
+double time_frames(SDL_Renderer* renderer, int frames, const std::function<void()>& draw) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        draw();
+        SDL_RenderPresent(renderer);
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / frames;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 200;
+    Target target = open_target();
+    SDL_Renderer* renderer = target.renderer;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> xs(0, kWidth - 1);
+    std::uniform_int_distribution<int> ys(0, kHeight - 1);
+
+    std::printf("renderer: %s, %d frames per case\n", target.kind, frames);
+    std::printf("%-6s %6s %14s %14s %8s\n", "kind", "count", "per-call ms", "batched ms", "speedup");
+
+    for (int count : {2000, 8000}) {
+        std::vector<Renderer::Rect> rects(count);
+        std::vector<Renderer::Line> lines(count);
+        for (int i = 0; i < count; ++i) {
+            rects[i] = {xs(rng), ys(rng), 2, ys(rng) / 4};
+            lines[i] = {kWidth / 2, kHeight / 2, xs(rng), ys(rng)};
+        }
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+
+        const double rects_before = time_frames(renderer, frames, [&] {
+            SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
+            for (const auto& r : rects) {
+                SDL_Rect sdl_rect = {r.x, r.y, r.w, r.h};
+                SDL_RenderFillRect(renderer, &sdl_rect);
+            }
+        });
+        const double rects_after = time_frames(renderer, frames, [&] {
+            SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
+            SDL_RenderFillRects(renderer, reinterpret_cast<const SDL_Rect*>(rects.data()), count);
+        });
+        std::printf("%-6s %6d %14.3f %14.3f %7.2fx\n", "rects", count,
+                    rects_before, rects_after, rects_before / rects_after);
+
+        const double lines_before = time_frames(renderer, frames, [&] {
+            SDL_SetRenderDrawColor(renderer, 0, 255, 255, 255);
+            for (const auto& l : lines) {
+                SDL_RenderDrawLine(renderer, l.x1, l.y1, l.x2, l.y2);
+            }
+        });
+        const double lines_after = time_frames(renderer, frames, [&] {
+            build_line_quads(lines.data(), lines.size(), SDL_Color{0, 255, 255, 255}, vertices, indices);
+            SDL_RenderGeometry(renderer, nullptr, vertices.data(), static_cast<int>(vertices.size()),
+                               indices.data(), static_cast<int>(indices.size()));
+        });
+        std::printf("%-6s %6d %14.3f %14.3f %7.2fx\n", "lines", count,
+                    lines_before, lines_after, lines_before / lines_after);
+    }
+
+    close_target(target);
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Microbenchmarks for the libaudioviz hot paths.
+//
+// Every case runs against the offscreen (headless) renderer, so no display
+// or video driver is needed and the numbers are comparable across CI hosts:
+//
+//   rects/N, lines/N   One frame of N primitives: clear, draw batch, present
+//   stft/N             Streaming STFT over one second of stereo audio
+//   batch_stft/N       Whole-signal STFT of ten seconds on the shared pool
+//   events/N           poll_events draining a flood of N queued events
+//
+// Times are per iteration; "rate" is primitives, samples or events per
+// second. The binding conversion cost (list versus array input) is measured
+// from Python by bench_bindings.py.
+//
+//   ./bench_hot_paths [--filter SUBSTRING] [--min-ms MS]
+
+#include <SDL2/SDL.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "renderer.h"
+#include "stft.h"
+#include "thread_pool.h"
+
+namespace {
+
+constexpr int kWidth = 1200;
+constexpr int kHeight = 800;
+constexpr int kSampleRate = 48000;
+constexpr double kPi = 3.14159265358979323846;
+
+struct Options {
+    std::string filter;
+    double min_ms = 300.0;
+};
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            options.min_ms = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter SUBSTRING] [--min-ms MS]\n", argv[0]);
+            std::exit(2);
+        }
+    }
+    return options;
+}
+
+void print_header() {
+    std::printf("%-18s %8s %10s %10s %10s %14s\n", "case", "iters", "mean ms", "p50 ms", "p99 ms", "rate /s");
+}
+
+void report(const std::string& name, const bench::Timing& timing, double items) {
+    std::printf("%-18s %8zu %10.4f %10.4f %10.4f %14.4g\n", name.c_str(), timing.iterations,
+                timing.mean_ms, timing.p50_ms, timing.p99_ms, items * 1000.0 / timing.mean_ms);
+}
+
+// Two tones plus a little noise, interleaved stereo
+std::vector<float> test_signal(size_t frames) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+    std::vector<float> samples(frames * 2);
+    for (size_t i = 0; i < frames; ++i) {
+        const double t = static_cast<double>(i) / kSampleRate;
+        samples[2 * i] = static_cast<float>(0.5 * std::sin(2 * kPi * 440.0 * t)) + noise(rng);
+        samples[2 * i + 1] = static_cast<float>(0.25 * std::sin(2 * kPi * 1320.0 * t)) + noise(rng);
+    }
+    return samples;
+}
+
+void bench_primitives(const Options& options, Renderer& renderer) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> xs(0, kWidth - 1);
+    std::uniform_int_distribution<int> ys(0, kHeight - 1);
+
+    for (int count : {64, 512, 4096, 32768}) {
+        std::vector<Renderer::Rect> rects(count);
+        std::vector<Renderer::Line> lines(count);
+        for (int i = 0; i < count; ++i) {
+            rects[i] = {xs(rng), ys(rng), 2, ys(rng) / 4};
+            lines[i] = {kWidth / 2, kHeight / 2, xs(rng), ys(rng)};
+        }
+
+        const std::string rect_case = "rects/" + std::to_string(count);
+        if (rect_case.find(options.filter) != std::string::npos) {
+            report(rect_case, bench::measure(options.min_ms, [&] {
+                renderer.clear(0, 0, 0, 255);
+                renderer.draw_rectangles(rects.data(), rects.size(), 0, 255, 0, 255);
+                renderer.present();
+            }), count);
+        }
+
+        const std::string line_case = "lines/" + std::to_string(count);
+        if (line_case.find(options.filter) != std::string::npos) {
+            report(line_case, bench::measure(options.min_ms, [&] {
+                renderer.clear(0, 0, 0, 255);
+                renderer.draw_lines(lines.data(), lines.size(), 0, 255, 255, 255);
+                renderer.present();
+            }), count);
+        }
+    }
+}
+
+void bench_stft(const Options& options) {
+    const std::vector<float> second = test_signal(kSampleRate);
+    const std::vector<float> track = test_signal(10 * kSampleRate);
+    ThreadPool& pool = ThreadPool::shared();
+
+    for (size_t nperseg : {256, 512, 1024, 2048, 4096}) {
+        const size_t hop = nperseg / 2;
+        const std::string stream_case = "stft/" + std::to_string(nperseg);
+        if (stream_case.find(options.filter) != std::string::npos) {
+            StreamingSTFT stft(nperseg, hop, 2);
+            std::vector<float> frame(2 * stft.bins());
+            report(stream_case, bench::measure(options.min_ms, [&] {
+                stft.reset();
+                stft.push(second.data(), kSampleRate);
+                while (stft.pop(frame.data())) {}
+            }), kSampleRate);
+        }
+
+        const std::string batch_case = "batch_stft/" + std::to_string(nperseg);
+        if (batch_case.find(options.filter) != std::string::npos) {
+            const size_t frames = StreamingSTFT::frame_count(10 * kSampleRate, nperseg, hop);
+            std::vector<float> out(frames * 2 * (nperseg / 2 + 1));
+            report(batch_case, bench::measure(options.min_ms, [&] {
+                batch_stft(track.data(), 10 * kSampleRate, 2, nperseg, hop, out.data(), pool);
+            }), 10.0 * kSampleRate);
+        }
+    }
+}
+
+void bench_events(const Options& options, Renderer& renderer) {
+    // The headless renderer never starts the video subsystem; the event
+    // queue alone is enough to flood it
+    if (SDL_InitSubSystem(SDL_INIT_EVENTS) < 0) {
+        std::fprintf(stderr, "Skipping events: %s\n", SDL_GetError());
+        return;
+    }
+
+    for (int count : {16, 256, 4096}) {
+        const std::string name = "events/" + std::to_string(count);
+        if (name.find(options.filter) == std::string::npos) continue;
+
+        SDL_Event key{};
+        key.type = SDL_KEYDOWN;
+        key.key.keysym.sym = SDLK_SPACE;
+        report(name, bench::measure(options.min_ms,
+                                    [&] { renderer.poll_events(); },
+                                    [&] {
+                                        // Rewinds the arena the event list lives in
+                                        renderer.present();
+                                        for (int i = 0; i < count; ++i) SDL_PushEvent(&key);
+                                    }),
+               count);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const Options options = parse_options(argc, argv);
+
+    Renderer renderer(kWidth, kHeight);
+    renderer.initialize_headless();
+
+    print_header();
+    bench_primitives(options, renderer);
+    bench_stft(options);
+    bench_events(options, renderer);
+    return 0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+// Shared timing and memory helpers for the native benchmarks.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+inline double elapsed_ms(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+struct Timing {
+    size_t iterations = 0;
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+};
+
+// Time `op` for at least `min_ms` (and at least 5 iterations) after one
+// untimed warm-up call. `setup` runs untimed before every call.
+template <typename Op, typename Setup>
+Timing measure(double min_ms, Op&& op, Setup&& setup) {
+    setup();
+    op();
+
+    std::vector<double> samples;
+    double total = 0.0;
+    while (total < min_ms || samples.size() < 5) {
+        setup();
+        const auto start = Clock::now();
+        op();
+        const double ms = elapsed_ms(start, Clock::now());
+        samples.push_back(ms);
+        total += ms;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    Timing timing;
+    timing.iterations = samples.size();
+    timing.mean_ms = total / samples.size();
+    timing.p50_ms = samples[samples.size() / 2];
+    timing.p99_ms = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    return timing;
+}
+
+template <typename Op>
+Timing measure(double min_ms, Op&& op) {
+    return measure(min_ms, op, [] {});
+}
+
+// Resident set size in bytes. Linux reports the current size; other Unix
+// systems only the peak, which still shows growth. 0 when unavailable.
+inline size_t resident_bytes() {
+#if defined(__linux__)
+    long pages = 0;
+    long resident = 0;
+    if (FILE* statm = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2) resident = 0;
+        std::fclose(statm);
+    }
+    return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#elif defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss);          // Bytes on macOS
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;   // Kilobytes elsewhere
+#endif
+#else
+    return 0;
+#endif
+}
+
+}  // namespace bench
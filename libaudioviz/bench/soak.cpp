@@ -0,0 +1,180 @@
+// Long-running soak test of the live frame pipeline.
+//
+// Each frame runs what the player does per refresh, offscreen: streaming
+// STFT of one hop of synthetic audio, band rebinning, smoothing, then bars
+// with peak markers, radial lines and the waterfall on the headless
+// renderer. Every report interval prints the frame-time mean and p99 of that
+// interval, their drift from the first interval, and resident memory growth
+// since the first report, so slow leaks and gradual slowdowns show up as
+// trends over hours rather than as noise in a microbenchmark.
+//
+//   ./soak [--duration-s S] [--report-s S] [--max-rss-growth-mb MB]
+//
+// With --max-rss-growth-mb the exit status is 1 when memory grew past the
+// limit, so CI can run a shortened soak as a leak check.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bench_util.h"
+#include "envelope.h"
+#include "geometry.h"
+#include "rebin.h"
+#include "renderer.h"
+#include "stft.h"
+#include "waterfall.h"
+
+namespace {
+
+constexpr int kWidth = 1200;
+constexpr int kHeight = 800;
+constexpr int kSampleRate = 48000;
+constexpr size_t kNperseg = 1024;
+constexpr size_t kHop = kNperseg / 2;
+constexpr size_t kBands = 128;
+constexpr double kPi = 3.14159265358979323846;
+
+struct Options {
+    double duration_s = 3600.0;
+    double report_s = 60.0;
+    double max_rss_growth_mb = 0.0;   // 0: report only
+};
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--duration-s") == 0 && has_value) {
+            options.duration_s = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--report-s") == 0 && has_value) {
+            options.report_s = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-rss-growth-mb") == 0 && has_value) {
+            options.max_rss_growth_mb = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--duration-s S] [--report-s S] [--max-rss-growth-mb MB]\n", argv[0]);
+            std::exit(2);
+        }
+    }
+    return options;
+}
+
+// A swept tone, so bands and peaks keep moving for the whole run
+class Signal {
+public:
+    void next(float* out, size_t frames) {
+        for (size_t i = 0; i < frames; ++i) {
+            const double t = static_cast<double>(sample_++) / kSampleRate;
+            const double freq = 200.0 + 4000.0 * (0.5 + 0.5 * std::sin(2 * kPi * 0.05 * t));
+            phase_ = std::fmod(phase_ + 2 * kPi * freq / kSampleRate, 2 * kPi);
+            out[i] = static_cast<float>(0.5 * std::sin(phase_));
+        }
+    }
+
+private:
+    uint64_t sample_ = 0;
+    double phase_ = 0.0;
+};
+
+double to_mb(size_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const Options options = parse_options(argc, argv);
+
+    Renderer renderer(kWidth, kHeight);
+    renderer.initialize_headless();
+
+    Signal signal;
+    StreamingSTFT stft(kNperseg, kHop);
+    BandRebinner rebinner(stft.bins(), static_cast<float>(kSampleRate), kBands);
+    EnvelopeFollower follower;
+    std::vector<float> block(kHop);
+    std::vector<float> frame(stft.bins());
+    std::vector<float> bands(kBands);
+    const float hop_ms = 1000.0f * kHop / kSampleRate;
+
+    const BarStyle bars;
+    const RadialStyle radial;
+    const WaterfallStyle waterfall;
+
+    std::vector<double> frame_ms;
+    frame_ms.reserve(1 << 16);
+    double first_mean = 0.0;
+    double first_p99 = 0.0;
+    size_t first_rss = 0;
+    size_t peak_growth = 0;
+    size_t total_frames = 0;
+
+    std::printf("%10s %10s %10s %10s %8s %8s %10s %10s\n", "elapsed s", "frames", "mean ms", "p99 ms",
+                "drift %", "p99 %", "rss MB", "growth MB");
+
+    const auto start = bench::Clock::now();
+    auto report_start = start;
+    bool first_report = true;
+    for (;;) {
+        const auto frame_start = bench::Clock::now();
+
+        signal.next(block.data(), block.size());
+        stft.push(block.data(), block.size());
+        while (stft.pop(frame.data())) {}
+        rebinner.apply(frame.data(), bands.data());
+        follower.process(bands.data(), bands.size(), hop_ms);
+
+        renderer.poll_events();
+        renderer.clear(0, 0, 0, 255);
+        renderer.draw_waterfall(follower.envelope(), follower.size(), waterfall);
+        renderer.draw_bars(follower.envelope(), follower.size(), bars, 0, 255, 0, 255);
+        renderer.draw_peak_markers(follower.peaks(), follower.size(), bars, 2, 255, 255, 255, 255);
+        renderer.draw_radial(follower.envelope(), follower.size(), radial, 0, 255, 255, 255);
+        renderer.present();
+
+        const auto now = bench::Clock::now();
+        frame_ms.push_back(bench::elapsed_ms(frame_start, now));
+        ++total_frames;
+
+        const double elapsed_s = bench::elapsed_ms(start, now) / 1000.0;
+        const bool done = elapsed_s >= options.duration_s;
+        if (bench::elapsed_ms(report_start, now) / 1000.0 < options.report_s && !done) continue;
+
+        double sum = 0.0;
+        for (double ms : frame_ms) sum += ms;
+        const double mean = sum / frame_ms.size();
+        std::sort(frame_ms.begin(), frame_ms.end());
+        const double p99 = frame_ms[std::min(frame_ms.size() - 1, frame_ms.size() * 99 / 100)];
+        const size_t rss = bench::resident_bytes();
+
+        if (first_report) {
+            first_mean = mean;
+            first_p99 = p99;
+            first_rss = rss;
+            first_report = false;
+        }
+        const size_t growth = rss > first_rss ? rss - first_rss : 0;
+        peak_growth = std::max(peak_growth, growth);
+        std::printf("%10.0f %10zu %10.4f %10.4f %+8.1f %+8.1f %10.1f %10.2f\n", elapsed_s, frame_ms.size(),
+                    mean, p99, 100.0 * (mean - first_mean) / first_mean, 100.0 * (p99 - first_p99) / first_p99,
+                    to_mb(rss), to_mb(growth));
+        std::fflush(stdout);
+
+        frame_ms.clear();
+        report_start = now;
+        if (done) break;
+    }
+
+    const double limit = options.max_rss_growth_mb;
+    std::printf("%zu frames, peak RSS growth %.2f MB, renderer heap allocations %zu\n", total_frames,
+                to_mb(peak_growth), renderer.heap_allocations());
+    if (limit > 0.0 && to_mb(peak_growth) > limit) {
+        std::printf("FAIL: RSS grew more than %.2f MB\n", limit);
+        return 1;
+    }
+    return 0;
+}
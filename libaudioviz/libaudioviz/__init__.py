@@ -1,4 +1,48 @@
 # This imports the C++ extension module
-from ._libaudioviz import Renderer, Rect, Line
+from ._libaudioviz import (
+    Renderer,
+    EventType,
+    EVENT_DTYPE,
+    Rect,
+    Line,
+    DisplayList,
+    Visualizer,
+    BandRebinner,
+    EnvelopeFollower,
+    StreamingSTFT,
+    SampleRing,
+    AudioCapture,
+    PrefetchDecoder,
+    WavFile,
+    SpectrogramCache,
+    SpectrogramCacheWriter,
+    batch_stft,
+    normalize_db,
+    simd_backend,
+    visualizer_modes,
+    FrameScheduler,
+)
 
-__all__ = ["Renderer", "Rect", "Line"]
\ No newline at end of file
+__all__ = [
+    "Renderer",
+    "EventType",
+    "EVENT_DTYPE",
+    "Rect",
+    "Line",
+    "DisplayList",
+    "Visualizer",
+    "BandRebinner",
+    "EnvelopeFollower",
+    "StreamingSTFT",
+    "SampleRing",
+    "AudioCapture",
+    "PrefetchDecoder",
+    "WavFile",
+    "SpectrogramCache",
+    "SpectrogramCacheWriter",
+    "batch_stft",
+    "normalize_db",
+    "simd_backend",
+    "visualizer_modes",
+    "FrameScheduler",
+]
@@ -0,0 +1,49 @@
+#include "arena.h"
+#include <algorithm>
+
+FrameArena::FrameArena(size_t block_size) {
+    add_block(block_size);
+}
+
+void FrameArena::add_block(size_t size) {
+    blocks_.push_back(Block{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+    ++heap_allocations_;
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    while (true) {
+        Block& block = blocks_[current_];
+        const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+        const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        const size_t end = static_cast<size_t>(aligned - base) + bytes;
+        if (end <= block.size) {
+            offset_ = end;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        // Move on to the next block, growing the arena if there is none
+        used_before_current_ += offset_;
+        offset_ = 0;
+        if (++current_ == blocks_.size()) {
+            add_block(std::max(bytes + alignment, blocks_.back().size * 2));
+        }
+    }
+}
+
+void FrameArena::reset() {
+    // A frame that spilled over gets one block that fits it next time
+    if (current_ > 0) {
+        const size_t total = capacity();
+        blocks_.clear();
+        add_block(total);
+    }
+    current_ = 0;
+    offset_ = 0;
+    used_before_current_ = 0;
+}
+
+size_t FrameArena::capacity() const {
+    size_t total = 0;
+    for (const auto& block : blocks_) total += block.size;
+    return total;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * Bump allocator for data that lives for one frame.
+ * Allocation is a pointer bump inside the current block; reset() rewinds
+ * everything at once. Memory is only obtained from the heap when a frame
+ * outgrows the blocks it has, and after a frame that needed several blocks,
+ * reset() replaces them with a single block large enough for all of it, so
+ * steady-state frames never touch the heap. heap_allocations() counts every
+ * block ever obtained, which is what the zero-allocation checks look at.
+ */
+class FrameArena {
+public:
+    static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+    explicit FrameArena(size_t block_size = kDefaultBlockSize);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    // Uninitialised storage for `count` trivially destructible objects
+    template <typename T>
+    T* allocate_array(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Release everything allocated since the last reset
+    void reset();
+
+    size_t bytes_used() const { return used_before_current_ + offset_; }
+    size_t capacity() const;
+    size_t heap_allocations() const { return heap_allocations_; }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    void add_block(size_t size);
+
+    std::vector<Block> blocks_;
+    size_t current_ = 0;              // Block being bumped
+    size_t offset_ = 0;               // Bytes used in the current block
+    size_t used_before_current_ = 0;  // Bytes used in earlier blocks this frame
+    size_t heap_allocations_ = 0;
+};
+
+/**
+ * std::allocator-compatible view of a FrameArena, for per-frame containers.
+ * deallocate() is a no-op; memory comes back at FrameArena::reset().
+ * Containers using it must not outlive the frame.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(FrameArena& arena) noexcept : arena_(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(size_t count) { return arena_->allocate_array<T>(count); }
+    void deallocate(T*, size_t) noexcept {}
+
+    FrameArena* arena() const noexcept { return arena_; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena_ == other.arena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena_ != other.arena(); }
+
+private:
+    FrameArena* arena_;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,127 @@
+#include "audio_capture.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+void check_params(int sample_rate, size_t channels, size_t period, double ring_seconds) {
+    if (sample_rate <= 0 || channels == 0 || period == 0 || ring_seconds <= 0.0) {
+        throw std::invalid_argument("AudioCapture needs a positive sample rate, channel count, period and ring length");
+    }
+}
+
+void quit_audio() {
+    // Reference counted like the video subsystem; SDL itself goes once
+    // nothing else is initialised
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    if (SDL_WasInit(SDL_INIT_EVERYTHING) == 0) {
+        SDL_Quit();
+    }
+}
+
+}  // namespace
+
+AudioCapture::AudioCapture(int sample_rate, size_t channels, size_t period, const std::string& device,
+                           double ring_seconds) {
+    check_params(sample_rate, channels, period, ring_seconds);
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+        throw std::runtime_error("SDL audio could not initialize! SDL_Error: " + std::string(SDL_GetError()));
+    }
+
+    SDL_AudioSpec want{};
+    want.freq = sample_rate;
+    want.format = AUDIO_F32SYS;
+    want.channels = static_cast<Uint8>(channels);
+    want.samples = static_cast<Uint16>(period);
+    want.callback = &AudioCapture::callback;
+    want.userdata = this;
+
+    // Rate and period may follow the device; SDL converts format and channels
+    SDL_AudioSpec have{};
+    device_ = SDL_OpenAudioDevice(device.empty() ? nullptr : device.c_str(), 1, &want, &have,
+                                  SDL_AUDIO_ALLOW_FREQUENCY_CHANGE | SDL_AUDIO_ALLOW_SAMPLES_CHANGE);
+    if (device_ == 0) {
+        const std::string error = SDL_GetError();
+        quit_audio();
+        throw std::runtime_error("Capture device could not be opened! SDL_Error: " + error);
+    }
+    sample_rate_ = have.freq;
+    period_ = have.samples;
+
+    // Sized for what was granted; the device stays paused until start(), so
+    // the callback cannot run before the ring exists
+    try {
+        ring_ = std::make_unique<SampleRing>(static_cast<size_t>(ring_seconds * sample_rate_) + period_, channels);
+    } catch (...) {
+        SDL_CloseAudioDevice(device_);
+        quit_audio();
+        throw;
+    }
+}
+
+AudioCapture::~AudioCapture() {
+    SDL_CloseAudioDevice(device_);
+    quit_audio();
+}
+
+void AudioCapture::start() {
+    SDL_PauseAudioDevice(device_, 0);
+    running_ = true;
+}
+
+void AudioCapture::stop() {
+    SDL_PauseAudioDevice(device_, 1);
+    running_ = false;
+}
+
+void SDLCALL AudioCapture::callback(void* user, Uint8* stream, int len) {
+    auto* self = static_cast<AudioCapture*>(user);
+    const size_t frames = static_cast<size_t>(len) / (sizeof(float) * self->channels());
+    self->ring_->push(reinterpret_cast<const float*>(stream), frames);
+
+    const int64_t now_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    const uint32_t seq = self->stamp_seq_.load(std::memory_order_relaxed);
+    self->stamp_seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    self->stamp_frames_.store(self->ring_->frames_written(), std::memory_order_relaxed);
+    self->stamp_ns_.store(now_ns, std::memory_order_relaxed);
+    self->stamp_seq_.store(seq + 2, std::memory_order_release);
+    self->callbacks_.fetch_add(1, std::memory_order_relaxed);
+}
+
+AudioCapture::Clock::time_point AudioCapture::captured_at(uint64_t frame) const {
+    uint64_t frames = 0;
+    int64_t ns = 0;
+    for (;;) {
+        const uint32_t before = stamp_seq_.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        frames = stamp_frames_.load(std::memory_order_relaxed);
+        ns = stamp_ns_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (stamp_seq_.load(std::memory_order_relaxed) == before) break;
+    }
+    if (ns == 0) return Clock::time_point{};  // Nothing captured yet
+
+    // The newest frame of a period arrived with its callback, each earlier
+    // one a sample interval before it
+    if (frame < frames) {
+        ns -= static_cast<int64_t>((frames - frame) * 1000000000ull / static_cast<uint64_t>(sample_rate_));
+    }
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+std::vector<std::string> AudioCapture::devices() {
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+        throw std::runtime_error("SDL audio could not initialize! SDL_Error: " + std::string(SDL_GetError()));
+    }
+    std::vector<std::string> names;
+    const int count = SDL_GetNumAudioDevices(1);
+    for (int i = 0; i < count; ++i) {
+        const char* name = SDL_GetAudioDeviceName(i, 1);
+        if (name) names.emplace_back(name);
+    }
+    quit_audio();
+    return names;
+}
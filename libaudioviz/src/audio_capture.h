@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+
+#include "ring_buffer.h"
+
+/**
+ * Live input from an SDL audio capture device.
+ * SDL's audio thread calls straight into native code, which pushes each
+ * period of float samples into a SampleRing (wait-free, no allocation, no
+ * Python) for the analysis side to consume. A short period keeps the time
+ * between a sample hitting the microphone and it being available small.
+ *
+ * Every callback also stamps the ring's sample clock with the steady-clock
+ * time it arrived, so the consumer can tell when any sample it analyses was
+ * captured; the Renderer turns that into mic-to-photon latency. The stamp
+ * is the callback time, so driver and hardware buffering before SDL hands
+ * the period over are not included.
+ */
+class AudioCapture {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // `device` is a name from devices(), or empty for the default input.
+    // The device may grant a different rate or period; the accessors report
+    // what was obtained. Throws std::invalid_argument for non-positive
+    // parameters and std::runtime_error if the device cannot be opened.
+    AudioCapture(int sample_rate = 48000, size_t channels = 1, size_t period = 256,
+                 const std::string& device = "", double ring_seconds = 1.0);
+    ~AudioCapture();
+
+    AudioCapture(const AudioCapture&) = delete;
+    AudioCapture& operator=(const AudioCapture&) = delete;
+
+    void start();
+    void stop();
+    bool running() const { return running_; }
+
+    int sample_rate() const { return sample_rate_; }
+    size_t channels() const { return ring_->channels(); }
+    size_t period() const { return period_; }
+
+    // Consumer side of the captured samples
+    SampleRing& ring() { return *ring_; }
+
+    // Estimated capture time of ring frame `frame`; the epoch (a default
+    // time_point) until the first period has arrived
+    Clock::time_point captured_at(uint64_t frame) const;
+
+    // Device callbacks so far
+    size_t callbacks() const { return callbacks_.load(std::memory_order_relaxed); }
+
+    // Names of the capture devices SDL can open
+    static std::vector<std::string> devices();
+
+private:
+    static void SDLCALL callback(void* user, Uint8* stream, int len);
+
+    SDL_AudioDeviceID device_ = 0;
+    int sample_rate_ = 0;
+    size_t period_ = 0;
+    bool running_ = false;
+    std::unique_ptr<SampleRing> ring_;  // Sized from the granted rate and period
+
+    // (frames written, arrival time) of the latest period, published
+    // through a sequence lock so the reader never sees a torn pair
+    std::atomic<uint32_t> stamp_seq_{0};
+    std::atomic<uint64_t> stamp_frames_{0};
+    std::atomic<int64_t> stamp_ns_{0};
+    std::atomic<size_t> callbacks_{0};
+};
@@ -1,16 +1,625 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
-#include <tuple>
+#include <pybind11/numpy.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <string>
 
 #include "renderer.h"
+#include "audio_capture.h"
+#include "frame_stats.h"
+#include "frame_scheduler.h"
+#include "geometry.h"
+#include "display_list.h"
+#include "kernels.h"
+#include "spectrum.h"
+#include "stft.h"
+#include "thread_pool.h"
+#include "ring_buffer.h"
+#include "spectrogram_cache.h"
+#include "rebin.h"
+#include "envelope.h"
+#include "decoder.h"
+#include "wav_file.h"
 
 namespace py = pybind11;
 
+// Rect and Line are read straight out of NumPy buffers, so they must stay
+// plain runs of four 32-bit ints.
+static_assert(sizeof(int) == sizeof(int32_t), "Renderer primitives assume 32-bit int");
+static_assert(sizeof(Renderer::Rect) == 4 * sizeof(int32_t), "Rect must be 4 packed ints");
+static_assert(sizeof(Renderer::Line) == 4 * sizeof(int32_t), "Line must be 4 packed ints");
+static_assert(sizeof(SDL_Color) == 4, "SDL_Color must be 4 packed bytes");
+
+using IntArray = py::array_t<int32_t, py::array::c_style | py::array::forcecast>;
+using FloatArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+using ComplexArray = py::array_t<std::complex<float>, py::array::c_style | py::array::forcecast>;
+using ColorArray = py::array_t<uint8_t, py::array::c_style | py::array::forcecast>;
+
+// View a contiguous (N, 4) int32 array as N packed primitives, without copying.
+template <typename T>
+static const T* as_primitives(const IntArray& array, size_t& count) {
+    if (array.size() == 0) {
+        count = 0;
+        return nullptr;
+    }
+    if (array.ndim() != 2 || array.shape(1) != 4) {
+        throw py::value_error("Expected an int32 array of shape (N, 4)");
+    }
+    count = static_cast<size_t>(array.shape(0));
+    return reinterpret_cast<const T*>(array.data());
+}
+
+// View a contiguous (count, 4) uint8 RGBA array as `count` SDL colours, without copying.
+static const SDL_Color* as_colors(const ColorArray& array, size_t count) {
+    if (count == 0) return nullptr;
+    if (array.ndim() != 2 || array.shape(1) != 4 || static_cast<size_t>(array.shape(0)) != count) {
+        throw py::value_error("Expected a uint8 array of shape (" + std::to_string(count) +
+                              ", 4), one RGBA colour per primitive");
+    }
+    return reinterpret_cast<const SDL_Color*>(array.data());
+}
+
+// Copy a Python list of Rect/Line objects into frame arena storage, so
+// list-based draw calls do not allocate a std::vector per batch.
+template <typename T>
+static const T* arena_primitives(FrameArena& arena, const py::list& items, size_t& count) {
+    count = py::len(items);
+    T* data = arena.allocate_array<T>(count);
+    for (size_t i = 0; i < count; ++i) {
+        data[i] = items[i].cast<const T&>();
+    }
+    return data;
+}
+
+// View a 1-D float32 magnitude array as (pointer, length), without copying.
+static const float* as_magnitudes(const FloatArray& array, size_t& size) {
+    if (array.ndim() != 1) {
+        throw py::value_error("Expected a 1-D float32 magnitude array");
+    }
+    size = static_cast<size_t>(array.shape(0));
+    return array.data();
+}
+
+// Read-only 1-D view of `size` floats kept alive by `owner`
+static py::array_t<float> readonly_view(const float* data, size_t size, const py::object& owner) {
+    py::array_t<float> view(static_cast<py::ssize_t>(size), data, owner);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
+
+// Validate an (N,) or (N, channels) sample block and return the frame count.
+static size_t sample_frames(const FloatArray& samples, size_t channels) {
+    const bool mono = samples.ndim() == 1 && channels == 1;
+    const bool interleaved = samples.ndim() == 2 && static_cast<size_t>(samples.shape(1)) == channels;
+    if (!mono && !interleaved) {
+        throw py::value_error("Expected float32 samples of shape (N, " + std::to_string(channels) + ")");
+    }
+    return static_cast<size_t>(samples.shape(0));
+}
+
+// Return `out` if it is a writable C-contiguous array of type T and the given
+// shape, or allocate a fresh one when `out` is None.
+template <typename T>
+static py::array_t<T> output_array(const py::object& out, const std::vector<py::ssize_t>& shape) {
+    if (out.is_none()) {
+        return py::array_t<T>(shape);
+    }
+    if (!py::isinstance<py::array_t<T, py::array::c_style>>(out)) {
+        throw py::type_error("out must be a C-contiguous " + std::string(py::str(py::dtype::of<T>())) + " array");
+    }
+    auto result = out.cast<py::array_t<T>>();
+    if (result.ndim() != static_cast<py::ssize_t>(shape.size()) ||
+        !std::equal(shape.begin(), shape.end(), result.shape())) {
+        throw py::value_error("out has the wrong shape");
+    }
+    return result;
+}
+
+// Output frames of a batch_stft call: `frames` (None = all) from first_frame on,
+// clamped to what the signal has
+static size_t frame_range(size_t total, size_t first_frame, const py::object& frames) {
+    const size_t left = first_frame < total ? total - first_frame : 0;
+    return frames.is_none() ? left : std::min(left, frames.cast<size_t>());
+}
+
+// Run fn on the shared pool, or on the process-wide pool of `threads`
+// threads, so chunked callers do not spawn and join a pool per call
+template <typename Fn>
+static void with_pool(size_t threads, Fn&& fn) {
+    fn(ThreadPool::sized(threads));
+}
+
+// Steady-clock milliseconds, the time base of FrameScheduler.now_ms
+static double steady_ms(FrameStats::Clock::time_point t) {
+    return std::chrono::duration<double, std::milli>(t.time_since_epoch()).count();
+}
+
+static FrameStats::Clock::time_point steady_time(double ms) {
+    return FrameStats::Clock::time_point(
+        std::chrono::duration_cast<FrameStats::Clock::duration>(std::chrono::duration<double, std::milli>(ms)));
+}
+
+// FrameStats summary as nested dicts: {"frames": ..., "stages": {"draw": {...}}}
+static py::dict stats_to_dict(const FrameStats::Summary& summary, size_t heap_allocations) {
+    py::dict stages;
+    for (size_t i = 0; i < summary.stages.size(); ++i) {
+        const auto& stage = summary.stages[i];
+        py::dict entry;
+        entry["count"] = stage.count;
+        entry["mean_ms"] = stage.mean_ms;
+        entry["p50_ms"] = stage.p50_ms;
+        entry["p95_ms"] = stage.p95_ms;
+        entry["p99_ms"] = stage.p99_ms;
+        entry["max_ms"] = stage.max_ms;
+        stages[FrameStats::stage_name(static_cast<FrameStats::Stage>(i))] = entry;
+    }
+
+    py::dict result;
+    result["frames"] = summary.frames;
+    result["late_frames"] = summary.late_frames;
+    result["dropped_frames"] = summary.dropped_frames;
+    result["unchanged_frames"] = summary.unchanged_frames;
+    result["target_interval_ms"] = summary.target_interval_ms;
+    result["last_frame_ms"] = summary.last_frame_ms;
+    result["heap_allocations"] = heap_allocations;
+    result["stages"] = stages;
+    return result;
+}
+
+// Fused |z| -> dB -> 0..1 mapping. Complex input is treated as STFT bins,
+// anything else as magnitudes. Writes into `out` when given.
+static py::array normalize_db_py(const py::array& values, float db_floor, float db_ceiling,
+                                 const py::object& out) {
+    const std::vector<py::ssize_t> shape(values.shape(), values.shape() + values.ndim());
+
+    auto result = output_array<float>(out, shape);
+
+    float* dst = result.mutable_data();
+    if (values.dtype().kind() == 'c') {
+        const auto bins = values.cast<ComplexArray>();
+        normalize_db(bins.data(), dst, static_cast<size_t>(bins.size()), db_floor, db_ceiling);
+    } else {
+        const auto mags = values.cast<FloatArray>();
+        normalize_db(mags.data(), dst, static_cast<size_t>(mags.size()), db_floor, db_ceiling);
+    }
+    return result;
+}
+
 PYBIND11_MODULE(_libaudioviz, m) {
     m.doc() = "C++ Audioviz Renderer Extension - Primitive Drawing Layer";
 
+    // Events
+    PYBIND11_NUMPY_DTYPE(Renderer::Event, type, data1, data2, timestamp);
+    m.attr("EVENT_DTYPE") = py::dtype::of<Renderer::Event>();
+
+    py::enum_<Renderer::EventType>(m, "EventType", py::arithmetic())
+        .value("QUIT", Renderer::EventType::Quit)
+        .value("KEYDOWN", Renderer::EventType::KeyDown)
+        .value("KEYUP", Renderer::EventType::KeyUp)
+        .value("MOUSEDOWN", Renderer::EventType::MouseDown)
+        .value("RESIZE", Renderer::EventType::Resize);
+
+    // Spectrum kernels
+    m.def("normalize_db", &normalize_db_py,
+          py::arg("values"), py::arg("db_floor") = BarStyle{}.db_floor,
+          py::arg("db_ceiling") = BarStyle{}.db_ceiling, py::arg("out") = py::none(),
+          "Map complex STFT bins or magnitudes to 0..1 heights: |z|, dB, affine map and clamp in one pass");
+    m.def("simd_backend", &simd_backend, "Name of the SIMD kernel selected at runtime");
+
+    // Analysis
+    py::class_<StreamingSTFT>(m, "StreamingSTFT")
+        .def(py::init<size_t, size_t, size_t>(),
+             py::arg("nperseg"), py::arg("hop"), py::arg("channels") = 1)
+        .def_property_readonly("nperseg", &StreamingSTFT::nperseg)
+        .def_property_readonly("hop", &StreamingSTFT::hop)
+        .def_property_readonly("channels", &StreamingSTFT::channels)
+        .def_property_readonly("bins", &StreamingSTFT::bins)
+        .def_property_readonly("frames_available", &StreamingSTFT::frames_available)
+        .def_property_readonly("finished", &StreamingSTFT::finished)
+        .def("push",
+             [](StreamingSTFT& self, const FloatArray& samples) {
+                 const size_t frames = sample_frames(samples, self.channels());
+                 py::gil_scoped_release release;
+                 self.push(samples.data(), frames);
+             },
+             py::arg("samples"), "Append a block of samples, shape (N,) or (N, channels)")
+        .def("finish", &StreamingSTFT::finish, "Append the trailing zero padding after the last block")
+        .def("pop",
+             [](StreamingSTFT& self, const py::object& out) -> py::object {
+                 if (self.frames_available() == 0) return py::none();
+                 auto result = output_array<float>(out, {static_cast<py::ssize_t>(self.channels()),
+                                                  static_cast<py::ssize_t>(self.bins())});
+                 float* dst = result.mutable_data();
+                 {
+                     py::gil_scoped_release release;
+                     self.pop(dst);
+                 }
+                 return std::move(result);
+             },
+             py::arg("out") = py::none(),
+             "Analyse the next frame into a (channels, bins) float32 magnitude array, or return None")
+        .def("reset", &StreamingSTFT::reset, "Drop buffered samples and start over")
+        .def_static("frame_count", &StreamingSTFT::frame_count,
+                    py::arg("num_samples"), py::arg("nperseg"), py::arg("hop"),
+                    "Number of frames scipy.signal.stft produces for this many samples");
+
+    m.def("batch_stft",
+          [](const FloatArray& samples, size_t nperseg, size_t hop, const py::object& out, size_t threads,
+             size_t first_frame, const py::object& frames) {
+              if (samples.ndim() != 1 && samples.ndim() != 2) {
+                  throw py::value_error("Expected float32 samples of shape (N,) or (N, channels)");
+              }
+              const size_t num_samples = static_cast<size_t>(samples.shape(0));
+              const size_t channels = samples.ndim() == 2 ? static_cast<size_t>(samples.shape(1)) : 1;
+              const size_t count = frame_range(StreamingSTFT::frame_count(num_samples, nperseg, hop),
+                                               first_frame, frames);
+              auto result = output_array<float>(out, {static_cast<py::ssize_t>(count),
+                                                      static_cast<py::ssize_t>(channels),
+                                                      static_cast<py::ssize_t>(nperseg / 2 + 1)});
+              float* dst = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  with_pool(threads, [&](ThreadPool& pool) {
+                      batch_stft(samples.data(), num_samples, channels, nperseg, hop, dst, pool, first_frame, count);
+                  });
+              }
+              return result;
+          },
+          py::arg("samples"), py::arg("nperseg"), py::arg("hop"), py::arg("out") = py::none(),
+          py::arg("threads") = 0, py::arg("first_frame") = 0, py::arg("frames") = py::none(),
+          "STFT magnitudes of a whole (N,) or (N, channels) float32 signal as a (frames, channels, bins) "
+          "array, computed on a thread pool (threads=0 uses every core). first_frame/frames select a "
+          "range of output frames");
+    m.def("batch_stft",
+          [](const WavFile& wav, size_t nperseg, size_t hop, const py::object& out, size_t threads,
+             size_t first_frame, const py::object& frames) {
+              const size_t count = frame_range(StreamingSTFT::frame_count(wav.frames(), nperseg, hop),
+                                               first_frame, frames);
+              auto result = output_array<float>(out, {static_cast<py::ssize_t>(count),
+                                                      static_cast<py::ssize_t>(wav.channels()),
+                                                      static_cast<py::ssize_t>(nperseg / 2 + 1)});
+              float* dst = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  with_pool(threads, [&](ThreadPool& pool) {
+                      batch_stft(wav, nperseg, hop, dst, pool, first_frame, count);
+                  });
+              }
+              return result;
+          },
+          py::arg("wav"), py::arg("nperseg"), py::arg("hop"), py::arg("out") = py::none(),
+          py::arg("threads") = 0, py::arg("first_frame") = 0, py::arg("frames") = py::none(),
+          "Same as above, reading a mapped WavFile and converting samples inside the windowing");
+
+    py::class_<WavFile>(m, "WavFile")
+        .def(py::init<const std::string&>(), py::arg("path"),
+             "Map a PCM (8/16/24/32-bit) or float32 WAV file without decoding it")
+        .def_property_readonly("sample_rate", &WavFile::sample_rate)
+        .def_property_readonly("channels", &WavFile::channels)
+        .def_property_readonly("frames", &WavFile::frames)
+        .def_property_readonly("encoding", [](const WavFile& self) { return wav_encoding_name(self.encoding()); })
+        .def_property_readonly("samples",
+                               [](const py::object& owner) {
+                                   const auto& self = owner.cast<const WavFile&>();
+                                   const auto frames = static_cast<py::ssize_t>(self.frames());
+                                   const auto channels = static_cast<py::ssize_t>(self.channels());
+                                   const void* data = self.samples();
+                                   // int24 has no NumPy type, so it is exposed as its raw bytes
+                                   py::array view;
+                                   switch (self.encoding()) {
+                                       case WavFile::Encoding::Uint8:
+                                           view = py::array_t<uint8_t>({frames, channels}, static_cast<const uint8_t*>(data), owner);
+                                           break;
+                                       case WavFile::Encoding::Int16:
+                                           view = py::array_t<int16_t>({frames, channels}, static_cast<const int16_t*>(data), owner);
+                                           break;
+                                       case WavFile::Encoding::Int24:
+                                           view = py::array_t<uint8_t>({frames, channels, py::ssize_t{3}}, static_cast<const uint8_t*>(data), owner);
+                                           break;
+                                       case WavFile::Encoding::Int32:
+                                           view = py::array_t<int32_t>({frames, channels}, static_cast<const int32_t*>(data), owner);
+                                           break;
+                                       case WavFile::Encoding::Float32:
+                                           view = py::array_t<float>({frames, channels}, static_cast<const float*>(data), owner);
+                                           break;
+                                   }
+                                   // The mapping is read-only
+                                   view.attr("setflags")(py::arg("write") = false);
+                                   return view;
+                               },
+                               "Read-only zero-copy view of the stored samples, shape (frames, channels) "
+                               "(int24: (frames, channels, 3) bytes)")
+        .def("read",
+             [](const WavFile& self, size_t first, size_t count, const py::object& out) {
+                 auto result = output_array<float>(out, {static_cast<py::ssize_t>(count),
+                                                         static_cast<py::ssize_t>(self.channels())});
+                 float* dst = result.mutable_data();
+                 {
+                     py::gil_scoped_release release;
+                     self.read(first, count, dst);
+                 }
+                 return result;
+             },
+             py::arg("first"), py::arg("count"), py::arg("out") = py::none(),
+             "Frames [first, first + count) converted to a (count, channels) float32 array")
+        .def("will_need", &WavFile::will_need, py::arg("first"), py::arg("count"),
+             "Hint that frames [first, first + count) will be read soon");
+
+    py::class_<BandRebinner>(m, "BandRebinner")
+        .def(py::init([](size_t bins, float sample_rate, size_t bands, const std::string& scale,
+                         float fmin, float fmax) {
+                 return BandRebinner(bins, sample_rate, bands, parse_band_scale(scale), fmin, fmax);
+             }),
+             py::arg("bins"), py::arg("sample_rate"), py::arg("bands"), py::arg("scale") = "log",
+             py::arg("fmin") = 20.0f, py::arg("fmax") = 0.0f,
+             "Precompute the sparse weights mapping `bins` linear STFT bins to `bands` bands on a "
+             "log, mel or bark scale (fmax=0 means Nyquist)")
+        .def_property_readonly("bins", &BandRebinner::bins)
+        .def_property_readonly("bands", &BandRebinner::bands)
+        .def_property_readonly("scale", [](const BandRebinner& self) { return band_scale_name(self.scale()); })
+        .def_property_readonly("taps", &BandRebinner::taps, "Non-zero weights in the matrix")
+        .def_property_readonly("center_frequencies",
+                               [](const BandRebinner& self) {
+                                   const auto& centers = self.center_frequencies();
+                                   py::array_t<float> result(static_cast<py::ssize_t>(centers.size()));
+                                   std::copy(centers.begin(), centers.end(), result.mutable_data());
+                                   return result;
+                               },
+                               "Band centre frequencies in Hz")
+        .def("apply",
+             [](const BandRebinner& self, const FloatArray& magnitudes, const py::object& out) {
+                 const auto ndim = magnitudes.ndim();
+                 if ((ndim != 1 && ndim != 2) ||
+                     static_cast<size_t>(magnitudes.shape(ndim - 1)) != self.bins()) {
+                     throw py::value_error("Expected float32 magnitudes of shape (" + std::to_string(self.bins()) +
+                                           ",) or (channels, " + std::to_string(self.bins()) + ")");
+                 }
+                 std::vector<py::ssize_t> shape(magnitudes.shape(), magnitudes.shape() + ndim);
+                 shape.back() = static_cast<py::ssize_t>(self.bands());
+                 auto result = output_array<float>(out, shape);
+                 const size_t channels = ndim == 2 ? static_cast<size_t>(magnitudes.shape(0)) : 1;
+                 self.apply(magnitudes.data(), result.mutable_data(), channels);
+                 return result;
+             },
+             py::arg("magnitudes"), py::arg("out") = py::none(),
+             "Aggregate (bins,) or (channels, bins) magnitudes into (bands,) or (channels, bands)");
+
+    py::class_<EnvelopeFollower>(m, "EnvelopeFollower")
+        .def(py::init([](size_t bands, float attack_ms, float release_ms, float peak_hold_ms,
+                         float peak_release_ms) {
+                 EnvelopeStyle style;
+                 style.attack_ms = attack_ms;
+                 style.release_ms = release_ms;
+                 style.peak_hold_ms = peak_hold_ms;
+                 style.peak_release_ms = peak_release_ms;
+                 return EnvelopeFollower(style, bands);
+             }),
+             py::arg("bands") = 0,
+             py::arg("attack_ms") = EnvelopeStyle{}.attack_ms, py::arg("release_ms") = EnvelopeStyle{}.release_ms,
+             py::arg("peak_hold_ms") = EnvelopeStyle{}.peak_hold_ms,
+             py::arg("peak_release_ms") = EnvelopeStyle{}.peak_release_ms,
+             "Per-band attack/release smoothing with held peaks; state resizes to the band count")
+        .def_property_readonly("size", &EnvelopeFollower::size)
+        .def_property_readonly("envelope",
+                               [](const py::object& owner) {
+                                   const auto& self = owner.cast<const EnvelopeFollower&>();
+                                   return readonly_view(self.envelope(), self.size(), owner);
+                               },
+                               "Read-only view of the smoothed magnitudes, updated in place")
+        .def_property_readonly("peaks",
+                               [](const py::object& owner) {
+                                   const auto& self = owner.cast<const EnvelopeFollower&>();
+                                   return readonly_view(self.peaks(), self.size(), owner);
+                               },
+                               "Read-only view of the held peaks, updated in place")
+        .def("process",
+             [](const py::object& owner, const FloatArray& magnitudes, float dt_ms) {
+                 auto& self = owner.cast<EnvelopeFollower&>();
+                 size_t size = 0;
+                 const float* data = as_magnitudes(magnitudes, size);
+                 self.process(data, size, dt_ms);
+                 return readonly_view(self.envelope(), self.size(), owner);
+             },
+             py::arg("magnitudes"), py::arg("dt_ms"),
+             "Advance by dt_ms toward `magnitudes` and return the envelope view. A new band count "
+             "resets the state")
+        .def("reset", &EnvelopeFollower::reset, "Return every band and peak to silence");
+
+    py::class_<PrefetchDecoder>(m, "PrefetchDecoder")
+        .def(py::init([](const std::string& path, size_t block_frames, size_t depth) {
+                 return std::make_unique<PrefetchDecoder>(open_audio_source(path), block_frames, depth);
+             }),
+             py::arg("path"), py::arg("block_frames") = 4096, py::arg("depth") = 4,
+             "Decode `path` to float32 on a background thread, keeping up to `depth` blocks ready")
+        .def_property_readonly("sample_rate", &PrefetchDecoder::sample_rate)
+        .def_property_readonly("channels", &PrefetchDecoder::channels)
+        .def_property_readonly("frames", &PrefetchDecoder::frames)
+        .def_property_readonly("block_frames", &PrefetchDecoder::block_frames)
+        .def_property_readonly("depth", &PrefetchDecoder::depth)
+        .def("read",
+             [](PrefetchDecoder& self, const py::object& out) -> py::object {
+                 const PrefetchDecoder::Block* block = nullptr;
+                 {
+                     py::gil_scoped_release release;
+                     block = self.acquire();
+                 }
+                 if (block == nullptr) return py::none();
+
+                 // Copy out so the pooled block can go straight back to the decoder
+                 const size_t count = block->frames * self.channels();
+                 py::array_t<float> result;
+                 try {
+                     if (out.is_none()) {
+                         result = py::array_t<float>({static_cast<py::ssize_t>(block->frames),
+                                                      static_cast<py::ssize_t>(self.channels())});
+                     } else {
+                         result = output_array<float>(out, {static_cast<py::ssize_t>(self.block_frames()),
+                                                            static_cast<py::ssize_t>(self.channels())});
+                     }
+                 } catch (...) {
+                     self.release(block);
+                     throw;
+                 }
+                 std::memcpy(result.mutable_data(), block->data, count * sizeof(float));
+                 const size_t frames = block->frames;
+                 self.release(block);
+
+                 if (!out.is_none() && frames < self.block_frames()) {
+                     return result[py::slice(0, static_cast<py::ssize_t>(frames), 1)];
+                 }
+                 return std::move(result);
+             },
+             py::arg("out") = py::none(),
+             "Next decoded block as a (frames, channels) float32 array, or None at the end. "
+             "`out` must have shape (block_frames, channels); a short final block is a view of it");
+
+    py::class_<SampleRing>(m, "SampleRing")
+        .def(py::init<size_t, size_t>(), py::arg("capacity_frames"), py::arg("channels") = 1)
+        .def_property_readonly("channels", &SampleRing::channels)
+        .def_property_readonly("capacity", &SampleRing::capacity)
+        .def_property_readonly("available", &SampleRing::available)
+        .def_property_readonly("frames_written", &SampleRing::frames_written)
+        .def_property_readonly("frames_dropped", &SampleRing::frames_dropped)
+        .def("push",
+             [](SampleRing& self, const FloatArray& samples) {
+                 const size_t frames = sample_frames(samples, self.channels());
+                 return self.push(samples.data(), frames);
+             },
+             py::arg("samples"),
+             "Producer: append (N, channels) samples. Returns frames accepted; the rest are dropped")
+        .def("pop",
+             [](SampleRing& self, size_t max_frames) {
+                 const size_t frames = std::min(max_frames, self.available());
+                 py::array_t<float> out({static_cast<py::ssize_t>(frames),
+                                         static_cast<py::ssize_t>(self.channels())});
+                 self.pop(out.mutable_data(), frames);
+                 return out;
+             },
+             py::arg("max_frames"), "Consumer: read up to max_frames into a new (n, channels) array")
+        .def("pop_into",
+             [](SampleRing& self, const py::object& out) {
+                 if (!py::isinstance<py::array_t<float, py::array::c_style>>(out)) {
+                     throw py::type_error("out must be a C-contiguous float32 array");
+                 }
+                 auto buffer = out.cast<py::array_t<float>>();
+                 if (buffer.ndim() != 2 || static_cast<size_t>(buffer.shape(1)) != self.channels()) {
+                     throw py::value_error("out must have shape (N, channels)");
+                 }
+                 return self.pop(buffer.mutable_data(), static_cast<size_t>(buffer.shape(0)));
+             },
+             py::arg("out"), "Consumer: fill a preallocated (N, channels) array, returns frames read")
+        .def("skip", &SampleRing::skip, py::arg("frames"), "Consumer: discard up to `frames` frames");
+
+    // Live input
+    py::class_<AudioCapture>(m, "AudioCapture")
+        .def(py::init<int, size_t, size_t, const std::string&, double>(),
+             py::arg("sample_rate") = 48000, py::arg("channels") = 1, py::arg("period") = 256,
+             py::arg("device") = "", py::arg("ring_seconds") = 1.0,
+             "Open an SDL capture device (default input when `device` is empty); paused until start()")
+        .def_property_readonly("sample_rate", &AudioCapture::sample_rate, "Rate the device granted")
+        .def_property_readonly("channels", &AudioCapture::channels)
+        .def_property_readonly("period", &AudioCapture::period, "Frames per device callback, as granted")
+        .def_property_readonly("running", &AudioCapture::running)
+        .def_property_readonly("callbacks", &AudioCapture::callbacks)
+        .def_property_readonly("ring", &AudioCapture::ring, py::return_value_policy::reference_internal,
+                               "SampleRing the device callback fills; read it from one thread")
+        .def("start", &AudioCapture::start)
+        .def("stop", &AudioCapture::stop)
+        .def("captured_at",
+             [](const AudioCapture& self, uint64_t frame) -> py::object {
+                 const auto captured = self.captured_at(frame);
+                 if (captured == AudioCapture::Clock::time_point{}) return py::none();
+                 return py::float_(steady_ms(captured));
+             },
+             py::arg("frame"),
+             "Estimated steady-clock ms at which ring frame `frame` was captured, or None before any audio")
+        .def_static("devices", &AudioCapture::devices, "Names of the available capture devices");
+
+    // Spectrogram cache
+    py::class_<SpectrogramCacheWriter>(m, "SpectrogramCacheWriter")
+        .def(py::init([](const std::string& path, uint32_t nperseg, uint32_t hop, uint32_t channels,
+                         uint32_t sample_rate, const py::bytes& key, float db_floor, float db_ceiling) {
+                 const std::string digest = key;
+                 SpectrogramCacheInfo info;
+                 if (digest.size() != info.key.size()) {
+                     throw py::value_error("key must be " + std::to_string(info.key.size()) + " bytes");
+                 }
+                 info.nperseg = nperseg;
+                 info.hop = hop;
+                 info.channels = channels;
+                 info.bins = nperseg / 2 + 1;
+                 info.sample_rate = sample_rate;
+                 info.db_floor = db_floor;
+                 info.db_ceiling = db_ceiling;
+                 std::copy(digest.begin(), digest.end(), info.key.begin());
+                 return std::make_unique<SpectrogramCacheWriter>(path, info);
+             }),
+             py::arg("path"), py::arg("nperseg"), py::arg("hop"), py::arg("channels"),
+             py::arg("sample_rate"), py::arg("key"),
+             py::arg("db_floor") = SpectrogramCacheInfo{}.db_floor,
+             py::arg("db_ceiling") = SpectrogramCacheInfo{}.db_ceiling)
+        .def_property_readonly("frames", &SpectrogramCacheWriter::frames)
+        .def("append",
+             [](SpectrogramCacheWriter& self, const FloatArray& magnitudes) {
+                 const auto& info = self.info();
+                 const py::ssize_t ndim = magnitudes.ndim();
+                 if ((ndim != 2 && ndim != 3) ||
+                     static_cast<size_t>(magnitudes.shape(ndim - 2)) != info.channels ||
+                     static_cast<size_t>(magnitudes.shape(ndim - 1)) != info.bins) {
+                     throw py::value_error("Expected (" + std::to_string(info.channels) + ", " +
+                                           std::to_string(info.bins) + ") frames, optionally batched");
+                 }
+                 const size_t frames = ndim == 3 ? static_cast<size_t>(magnitudes.shape(0)) : 1;
+                 py::gil_scoped_release release;
+                 for (size_t i = 0; i < frames; ++i) {
+                     self.append(magnitudes.data() + i * info.frame_bytes());
+                 }
+             },
+             py::arg("magnitudes"),
+             "Quantise and append one (channels, bins) frame or a (frames, channels, bins) batch")
+        .def("commit", &SpectrogramCacheWriter::commit, "Finalise the file and move it into place");
+
+    py::class_<SpectrogramCache>(m, "SpectrogramCache")
+        .def(py::init<const std::string&>(), py::arg("path"))
+        .def_property_readonly("nperseg", [](const SpectrogramCache& self) { return self.info().nperseg; })
+        .def_property_readonly("hop", [](const SpectrogramCache& self) { return self.info().hop; })
+        .def_property_readonly("channels", [](const SpectrogramCache& self) { return self.info().channels; })
+        .def_property_readonly("bins", [](const SpectrogramCache& self) { return self.info().bins; })
+        .def_property_readonly("sample_rate", [](const SpectrogramCache& self) { return self.info().sample_rate; })
+        .def_property_readonly("frames", &SpectrogramCache::frames)
+        .def_property_readonly("key", [](const SpectrogramCache& self) {
+            const auto& key = self.info().key;
+            return py::bytes(reinterpret_cast<const char*>(key.data()), key.size());
+        })
+        .def_property_readonly("codes",
+             [](const py::object& owner) {
+                 const auto& self = owner.cast<const SpectrogramCache&>();
+                 const auto& info = self.info();
+                 py::array_t<uint8_t> codes({static_cast<py::ssize_t>(info.frames),
+                                             static_cast<py::ssize_t>(info.channels),
+                                             static_cast<py::ssize_t>(info.bins)},
+                                            self.data(), owner);
+                 // The mapping is read-only
+                 codes.attr("setflags")(py::arg("write") = false);
+                 return codes;
+             },
+             "Zero-copy (frames, channels, bins) uint8 view of the quantised dB codes")
+        .def("frame",
+             [](const SpectrogramCache& self, uint64_t index, const py::object& out) {
+                 auto result = output_array<float>(out, {static_cast<py::ssize_t>(self.info().channels),
+                                                         static_cast<py::ssize_t>(self.info().bins)});
+                 self.decode(index, result.mutable_data());
+                 return result;
+             },
+             py::arg("index"), py::arg("out") = py::none(),
+             "Decode frame `index` into a (channels, bins) float32 magnitude array")
+        .def("prefetch", &SpectrogramCache::prefetch, py::arg("first"), py::arg("count"),
+             "Hint that frames [first, first + count) will be read soon");
+
     py::class_<Renderer::Rect>(m, "Rect")
         .def(py::init<int, int, int, int>(), py::arg("x"), py::arg("y"), py::arg("w"), py::arg("h"))
         .def_readwrite("x", &Renderer::Rect::x)
@@ -25,11 +634,65 @@ PYBIND11_MODULE(_libaudioviz, m) {
         .def_readwrite("x2", &Renderer::Line::x2)
         .def_readwrite("y2", &Renderer::Line::y2);
 
+    py::class_<DisplayList>(m, "DisplayList")
+        .def_static("bars",
+             [](size_t size, int width, int height, uint8_t r, uint8_t g, uint8_t b, uint8_t a,
+                float scale, bool mirror, bool log_scale, float db_floor, float db_ceiling) {
+                 BarStyle style;
+                 style.scale = scale;
+                 style.mirror = mirror;
+                 style.log_scale = log_scale;
+                 style.db_floor = db_floor;
+                 style.db_ceiling = db_ceiling;
+                 return DisplayList::bars(size, width, height, style, SDL_Color{r, g, b, a});
+             },
+             py::arg("size"), py::arg("width"), py::arg("height"),
+             py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
+             py::arg("scale") = BarStyle{}.scale, py::arg("mirror") = BarStyle{}.mirror,
+             py::arg("log_scale") = BarStyle{}.log_scale,
+             py::arg("db_floor") = BarStyle{}.db_floor, py::arg("db_ceiling") = BarStyle{}.db_ceiling,
+             "Build a retained bar display list for `size` bins at width x height")
+        .def_static("radial",
+             [](size_t size, int width, int height, uint8_t r, uint8_t g, uint8_t b, uint8_t a,
+                float scale, float base_radius_ratio, bool mirror) {
+                 RadialStyle style;
+                 style.scale = scale;
+                 style.base_radius_ratio = base_radius_ratio;
+                 style.mirror = mirror;
+                 return DisplayList::radial(size, width, height, style, SDL_Color{r, g, b, a});
+             },
+             py::arg("size"), py::arg("width"), py::arg("height"),
+             py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
+             py::arg("scale") = RadialStyle{}.scale,
+             py::arg("base_radius_ratio") = RadialStyle{}.base_radius_ratio,
+             py::arg("mirror") = RadialStyle{}.mirror,
+             "Build a retained radial display list for `size` bins at width x height")
+        .def("update",
+             [](DisplayList& self, const FloatArray& magnitudes) {
+                 size_t size = 0;
+                 const float* data = as_magnitudes(magnitudes, size);
+                 self.update(data, size);
+             },
+             py::arg("magnitudes"), "Update vertex positions in place from a float32 magnitude array")
+        .def("matches", &DisplayList::matches, py::arg("size"), py::arg("width"), py::arg("height"),
+             "Check whether this list fits the given bin count and window size")
+        .def_property_readonly("size", &DisplayList::size)
+        .def_property_readonly("width", &DisplayList::width)
+        .def_property_readonly("height", &DisplayList::height)
+        .def_property_readonly("quad_count", &DisplayList::quad_count);
+
     py::class_<Renderer>(m, "Renderer")
         .def(py::init<int, int>(), py::arg("width"), py::arg("height"))
         
         // Window management
-        .def("initialize_window", &Renderer::initialize_window, "Open the visualization window")
+        .def("initialize_window", &Renderer::initialize_window, py::arg("threaded") = false,
+             py::arg("display") = 0, py::call_guard<py::gil_scoped_release>(),
+             "Open the visualization window on monitor `display`. With threaded=True, rendering runs "
+             "on a native thread. Releases the GIL, so startup work on other threads continues meanwhile")
+        .def("is_threaded", &Renderer::is_threaded, "Check if frames are rendered on the native thread")
+        .def("initialize_headless", &Renderer::initialize_headless,
+             "Render offscreen into an RGBA software surface instead of a window (no display needed)")
+        .def("is_headless", &Renderer::is_headless, "Check if frames are rendered offscreen")
         .def("get_width", &Renderer::get_width, "Get current window width")
         .def("get_height", &Renderer::get_height, "Get current window height")
         
@@ -37,18 +700,244 @@ PYBIND11_MODULE(_libaudioviz, m) {
         .def("clear", &Renderer::clear, 
              py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
              "Clear screen with specified RGBA color")
-        .def("present", &Renderer::present, "Present the rendered frame to screen")
+        .def("present", &Renderer::present, py::call_guard<py::gil_scoped_release>(),
+             "Present the rendered frame to screen (hands it to the render thread in threaded mode)")
+        .def("read_pixels",
+             [](const Renderer& self, const py::object& out) {
+                 auto result = output_array<uint8_t>(out, {self.get_height(), self.get_width(), 4});
+                 uint8_t* dst = result.mutable_data();
+                 {
+                     py::gil_scoped_release release;
+                     self.read_pixels(dst);
+                 }
+                 return result;
+             },
+             py::arg("out") = py::none(),
+             "Copy the last presented headless frame into a (height, width, 4) uint8 RGBA array")
         
         // Primitive drawing
-        .def("draw_rectangles", &Renderer::draw_rectangles,
+        .def("draw_rectangles",
+             [](Renderer& self, const IntArray& rects, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+                 size_t count = 0;
+                 const auto* data = as_primitives<Renderer::Rect>(rects, count);
+                 self.draw_rectangles(data, count, r, g, b, a);
+             },
+             py::arg("rects"), py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
+             "Draw batch of filled rectangles from an (N, 4) int32 array of (x, y, w, h), read in place")
+        .def("draw_rectangles",
+             [](Renderer& self, const py::list& rects, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+                 size_t count = 0;
+                 const auto* data = arena_primitives<Renderer::Rect>(self.frame_arena(), rects, count);
+                 self.draw_rectangles(data, count, r, g, b, a);
+             },
              py::arg("rects"), py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
              "Draw batch of filled rectangles. Each rect is (x, y, w, h)")
-        .def("draw_lines", &Renderer::draw_lines,
+        .def("draw_lines",
+             [](Renderer& self, const IntArray& lines, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+                 size_t count = 0;
+                 const auto* data = as_primitives<Renderer::Line>(lines, count);
+                 self.draw_lines(data, count, r, g, b, a);
+             },
+             py::arg("lines"), py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
+             "Draw batch of lines from an (N, 4) int32 array of (x1, y1, x2, y2), read in place")
+        .def("draw_lines",
+             [](Renderer& self, const py::list& lines, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+                 size_t count = 0;
+                 const auto* data = arena_primitives<Renderer::Line>(self.frame_arena(), lines, count);
+                 self.draw_lines(data, count, r, g, b, a);
+             },
              py::arg("lines"), py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
              "Draw batch of lines. Each line is (x1, y1, x2, y2)")
         
+        .def("draw_colored_rectangles",
+             [](Renderer& self, const IntArray& rects, const ColorArray& colors) {
+                 size_t count = 0;
+                 const auto* data = as_primitives<Renderer::Rect>(rects, count);
+                 self.draw_colored_rectangles(data, as_colors(colors, count), count);
+             },
+             py::arg("rects"), py::arg("colors"),
+             "Draw rectangles from an (N, 4) int32 array with an (N, 4) uint8 RGBA colour each")
+        .def("draw_colored_lines",
+             [](Renderer& self, const IntArray& lines, const ColorArray& colors) {
+                 size_t count = 0;
+                 const auto* data = as_primitives<Renderer::Line>(lines, count);
+                 self.draw_colored_lines(data, as_colors(colors, count), count);
+             },
+             py::arg("lines"), py::arg("colors"),
+             "Draw lines from an (N, 4) int32 array with an (N, 4) uint8 RGBA colour each")
+        
+        // Native visualizer kernels
+        .def("draw_bars",
+             [](Renderer& self, const FloatArray& magnitudes, uint8_t r, uint8_t g, uint8_t b, uint8_t a,
+                float scale, bool mirror, bool log_scale, float db_floor, float db_ceiling) {
+                 size_t size = 0;
+                 const float* data = as_magnitudes(magnitudes, size);
+                 BarStyle style;
+                 style.scale = scale;
+                 style.mirror = mirror;
+                 style.log_scale = log_scale;
+                 style.db_floor = db_floor;
+                 style.db_ceiling = db_ceiling;
+                 self.draw_bars(data, size, style, r, g, b, a);
+             },
+             py::arg("magnitudes"), py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
+             py::arg("scale") = BarStyle{}.scale, py::arg("mirror") = BarStyle{}.mirror,
+             py::arg("log_scale") = BarStyle{}.log_scale,
+             py::arg("db_floor") = BarStyle{}.db_floor, py::arg("db_ceiling") = BarStyle{}.db_ceiling,
+             "Draw frequency bars straight from a float32 magnitude array")
+        .def("draw_peak_markers",
+             [](Renderer& self, const FloatArray& peaks, uint8_t r, uint8_t g, uint8_t b, uint8_t a,
+                int thickness, float scale, bool mirror, bool log_scale, float db_floor, float db_ceiling) {
+                 size_t size = 0;
+                 const float* data = as_magnitudes(peaks, size);
+                 BarStyle style;
+                 style.scale = scale;
+                 style.mirror = mirror;
+                 style.log_scale = log_scale;
+                 style.db_floor = db_floor;
+                 style.db_ceiling = db_ceiling;
+                 self.draw_peak_markers(data, size, style, thickness, r, g, b, a);
+             },
+             py::arg("peaks"), py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
+             py::arg("thickness") = 2,
+             py::arg("scale") = BarStyle{}.scale, py::arg("mirror") = BarStyle{}.mirror,
+             py::arg("log_scale") = BarStyle{}.log_scale,
+             py::arg("db_floor") = BarStyle{}.db_floor, py::arg("db_ceiling") = BarStyle{}.db_ceiling,
+             "Draw peak-hold markers where draw_bars would put the tops of bars for `peaks`")
+        .def("draw_radial",
+             [](Renderer& self, const FloatArray& magnitudes, uint8_t r, uint8_t g, uint8_t b, uint8_t a,
+                float scale, float base_radius_ratio, bool mirror) {
+                 size_t size = 0;
+                 const float* data = as_magnitudes(magnitudes, size);
+                 RadialStyle style;
+                 style.scale = scale;
+                 style.base_radius_ratio = base_radius_ratio;
+                 style.mirror = mirror;
+                 self.draw_radial(data, size, style, r, g, b, a);
+             },
+             py::arg("magnitudes"), py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
+             py::arg("scale") = RadialStyle{}.scale,
+             py::arg("base_radius_ratio") = RadialStyle{}.base_radius_ratio,
+             py::arg("mirror") = RadialStyle{}.mirror,
+             "Draw radial lines straight from a float32 magnitude array")
+        
+        .def("draw_waterfall",
+             [](Renderer& self, const FloatArray& magnitudes, int history, float db_floor, float db_ceiling) {
+                 size_t size = 0;
+                 const float* data = as_magnitudes(magnitudes, size);
+                 WaterfallStyle style;
+                 style.history = history;
+                 style.db_floor = db_floor;
+                 style.db_ceiling = db_ceiling;
+                 self.draw_waterfall(data, size, style);
+             },
+             py::arg("magnitudes"), py::arg("history") = WaterfallStyle{}.history,
+             py::arg("db_floor") = WaterfallStyle{}.db_floor, py::arg("db_ceiling") = WaterfallStyle{}.db_ceiling,
+             "Append a column to the scrolling spectrogram and draw the last `history` columns "
+             "across the window (uploads one column per frame)")
+        
+        .def("draw_display_list", &Renderer::draw_display_list, py::arg("display_list"),
+             "Submit a retained display list with a single geometry call")
+        
         // Event handling
-        .def("poll_events", &Renderer::poll_events,
-             "Poll SDL events. Returns list of (event_type, data1, data2) tuples")
-        .def("should_quit", &Renderer::should_quit, "Check if quit was requested");
+        .def("poll_events",
+             [](Renderer& self) {
+                 const auto& events = self.poll_events();
+                 py::array_t<Renderer::Event> result(static_cast<py::ssize_t>(events.size()));
+                 if (!events.empty()) {
+                     std::memcpy(result.mutable_data(), events.data(), events.size() * sizeof(Renderer::Event));
+                 }
+                 return result;
+             },
+             "Poll SDL events into a record array of EVENT_DTYPE (type, data1, data2, timestamp)")
+        .def_static("ticks_ms", &Renderer::ticks_ms, "SDL ticks in ms, the clock of event timestamps")
+        .def("should_quit", &Renderer::should_quit, "Check if quit was requested")
+        .def_property_readonly("window_id", &Renderer::window_id,
+                               "SDL window id events are routed by; 0 without a window")
+        
+        // Instrumentation
+        .def("get_stats", [](const Renderer& self) { return stats_to_dict(self.get_stats(), self.heap_allocations()); },
+             "Frame counters and per-stage timing percentiles (ms) over a rolling window of recent samples")
+        .def("reset_stats", &Renderer::reset_stats, "Clear all frame counters and timings")
+        .def("set_target_fps", &Renderer::set_target_fps, py::arg("fps"),
+             "Refresh rate that late/dropped frames are counted against (0 disables)")
+        .def("last_frame_ms", &Renderer::last_frame_ms, "Interval between the last two presents in ms")
+        .def("set_skip_unchanged", &Renderer::set_skip_unchanged, py::arg("enabled"), py::arg("tolerance_px") = 0.0f,
+             "Skip replaying and presenting frames that would draw the image already on screen, within "
+             "tolerance_px pixels; skipped presents still wait out the refresh interval")
+        .def_property_readonly("skip_unchanged", &Renderer::skip_unchanged)
+        .def("invalidate", &Renderer::invalidate, "Replay the next frame even if it matches the one on screen")
+        .def("set_capture_time",
+             [](Renderer& self, double captured_ms) { self.set_capture_time(steady_time(captured_ms)); },
+             py::arg("captured_ms"),
+             "Steady-clock ms (AudioCapture.captured_at) at which the newest audio in the frame being "
+             "recorded was captured; its swap records the 'latency' stage")
+        .def("heap_allocations", &Renderer::heap_allocations,
+             "Heap allocations made by frame recording so far; constant once frames are warmed up");
+
+    py::class_<VisualizerKernel>(m, "Visualizer")
+        .def(py::init([](const std::string& mode, const py::kwargs& options) {
+                 VisualizerOptions values;
+                 for (const auto& item : options) {
+                     values[item.first.cast<std::string>()] = item.second.cast<float>();
+                 }
+                 return make_visualizer(mode, values);
+             }),
+             py::arg("mode"),
+             "Make the native kernel registered for `mode`; keyword options (scale, mirror, ...) "
+             "select its compile-time specialisation")
+        .def("draw",
+             [](VisualizerKernel& self, Renderer& renderer, const FloatArray& magnitudes,
+                uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+                 size_t size = 0;
+                 const float* data = as_magnitudes(magnitudes, size);
+                 self.draw(renderer, data, size, SDL_Color{r, g, b, a});
+             },
+             py::arg("renderer"), py::arg("magnitudes"), py::arg("r"), py::arg("g"), py::arg("b"), py::arg("a"),
+             "Draw a frame from a float32 magnitude array at the renderer's window size");
+    m.def("visualizer_modes", &visualizer_modes, "Names of the natively registered visualizer modes");
+
+    // Frame scheduling
+    py::class_<FrameScheduler> scheduler(m, "FrameScheduler");
+    py::class_<FrameScheduler::Tick>(scheduler, "Tick")
+        .def_readonly("render", &FrameScheduler::Tick::render)
+        .def_readonly("frame", &FrameScheduler::Tick::frame)
+        .def_readonly("fraction", &FrameScheduler::Tick::fraction)
+        .def_readonly("skipped", &FrameScheduler::Tick::skipped)
+        .def_readonly("wait_ms", &FrameScheduler::Tick::wait_ms);
+    scheduler
+        .def(py::init<int, size_t, size_t, double, bool>(),
+             py::arg("sample_rate"), py::arg("nperseg"), py::arg("hop"),
+             py::arg("display_latency_ms") = 0.0, py::arg("interpolate") = false)
+        .def_property("display_latency_ms", &FrameScheduler::display_latency_ms,
+                      &FrameScheduler::set_display_latency_ms)
+        .def_property_readonly("interpolate", &FrameScheduler::interpolate)
+        .def("tick", &FrameScheduler::tick, py::arg("played_frames"), py::arg("force") = false,
+             "Which frame to show given the frames the device has played; hold when tick.render is False")
+        .def("frame_end", &FrameScheduler::frame_end, py::arg("index"),
+             "Samples needed before STFT frame `index` is complete")
+        .def("frame_presented",
+             [](FrameScheduler& self, const py::object& at_ms) {
+                 self.frame_presented(at_ms.is_none() ? FrameScheduler::now_ms() : at_ms.cast<double>());
+             },
+             py::arg("at_ms") = py::none(),
+             "Mark a present at `at_ms` on a monotonic clock (default: now) for pacing stats")
+        .def("summary",
+             [](const FrameScheduler& self) {
+                 const FrameScheduler::Summary summary = self.summary();
+                 py::dict result;
+                 result["ticks"] = summary.ticks;
+                 result["rendered"] = summary.rendered;
+                 result["held"] = summary.held;
+                 result["skipped"] = summary.skipped;
+                 result["presents"] = summary.presents;
+                 result["mean_interval_ms"] = summary.mean_interval_ms;
+                 result["jitter_ms"] = summary.jitter_ms;
+                 result["max_deviation_ms"] = summary.max_deviation_ms;
+                 return result;
+             },
+             "Render/hold/skip counters and present-interval jitter over a rolling window")
+        .def("reset", &FrameScheduler::reset, "Forget the shown frame and clear all counters")
+        .def_static("now_ms", &FrameScheduler::now_ms,
+                    "Steady-clock milliseconds, the clock of frame_presented and AudioCapture.captured_at");
 }
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "command_buffer.h"
+#include "geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+// Make room for `size` elements, doubling like push_back would, and count
+// the times that needed the heap
+template <typename Vector>
+void reserve_for(Vector& storage, size_t size, size_t& allocations) {
+    if (size <= storage.capacity()) return;
+    storage.reserve(std::max(size, storage.capacity() * 2));
+    ++allocations;
+}
+
+bool same_color(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+}  // namespace
+
+void FrameCommandBuffer::reset(int width, int height) {
+    width_ = width;
+    height_ = height;
+    capture_time_ = {};
+    commands_.clear();
+    rects_.clear();
+    vertices_.clear();
+    indices_.clear();
+    pixels_.clear();
+}
+
+void FrameCommandBuffer::clear(SDL_Color color) {
+    reserve_for(commands_, commands_.size() + 1, heap_allocations_);
+    commands_.push_back({CommandType::Clear, color, 0, 0, 0, 0});
+}
+
+void FrameCommandBuffer::rects(const Renderer::Rect* rects, size_t count, SDL_Color color) {
+    if (count == 0) return;
+    reserve_for(commands_, commands_.size() + 1, heap_allocations_);
+    reserve_for(rects_, rects_.size() + count, heap_allocations_);
+    commands_.push_back({CommandType::Rects, color, rects_.size(), count, 0, 0});
+    rects_.insert(rects_.end(), rects, rects + count);
+}
+
+void FrameCommandBuffer::lines(const Renderer::Line* lines, size_t count, SDL_Color color) {
+    if (count == 0) return;
+    // Independent segments become 1px quads so the batch is one geometry call
+    const size_t vertex_offset = vertices_.size();
+    const size_t index_offset = indices_.size();
+    const int base = append_geometry(count * 4, count * 6);
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto& line = lines[i];
+        write_line_quad(&vertices_[vertex_offset + i * 4],
+                        static_cast<float>(line.x1), static_cast<float>(line.y1),
+                        static_cast<float>(line.x2), static_cast<float>(line.y2), color);
+    }
+    write_quad_indices(index_offset, count, base);
+}
+
+void FrameCommandBuffer::geometry(const SDL_Vertex* vertices, size_t vertex_count,
+                                  const int* indices, size_t index_count) {
+    if (index_count == 0) return;
+    const size_t vertex_offset = vertices_.size();
+    const size_t index_offset = indices_.size();
+    const int base = append_geometry(vertex_count, index_count);
+
+    std::copy(vertices, vertices + vertex_count, vertices_.begin() + vertex_offset);
+    for (size_t i = 0; i < index_count; ++i) {
+        indices_[index_offset + i] = indices[i] + base;
+    }
+}
+
+void FrameCommandBuffer::colored_rects(const Renderer::Rect* rects, const SDL_Color* colors, size_t count) {
+    if (count == 0) return;
+    const size_t vertex_offset = vertices_.size();
+    const size_t index_offset = indices_.size();
+    const int base = append_geometry(count * 4, count * 6);
+
+    for (size_t i = 0; i < count; ++i) {
+        write_rect_quad(&vertices_[vertex_offset + i * 4], rects[i], colors[i]);
+    }
+    write_quad_indices(index_offset, count, base);
+}
+
+void FrameCommandBuffer::colored_lines(const Renderer::Line* lines, const SDL_Color* colors, size_t count) {
+    if (count == 0) return;
+    const size_t vertex_offset = vertices_.size();
+    const size_t index_offset = indices_.size();
+    const int base = append_geometry(count * 4, count * 6);
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto& line = lines[i];
+        write_line_quad(&vertices_[vertex_offset + i * 4],
+                        static_cast<float>(line.x1), static_cast<float>(line.y1),
+                        static_cast<float>(line.x2), static_cast<float>(line.y2), colors[i]);
+    }
+    write_quad_indices(index_offset, count, base);
+}
+
+uint32_t* FrameCommandBuffer::waterfall(size_t rows, int history) {
+    const size_t offset = pixels_.size();
+    reserve_for(commands_, commands_.size() + 1, heap_allocations_);
+    reserve_for(pixels_, offset + rows, heap_allocations_);
+    commands_.push_back({CommandType::Waterfall, SDL_Color{0, 0, 0, 0}, offset, rows, 0, 0, history});
+    pixels_.resize(offset + rows);
+    return pixels_.data() + offset;
+}
+
+int FrameCommandBuffer::append_geometry(size_t vertex_count, size_t index_count) {
+    reserve_for(commands_, commands_.size() + 1, heap_allocations_);
+    reserve_for(vertices_, vertices_.size() + vertex_count, heap_allocations_);
+    reserve_for(indices_, indices_.size() + index_count, heap_allocations_);
+
+    size_t base = 0;
+    if (!commands_.empty() && commands_.back().type == CommandType::Geometry) {
+        Command& last = commands_.back();
+        base = last.vertex_count;
+        last.count += index_count;
+        last.vertex_count += vertex_count;
+    } else {
+        commands_.push_back({CommandType::Geometry, SDL_Color{0, 0, 0, 0},
+                             indices_.size(), index_count, vertices_.size(), vertex_count});
+    }
+    vertices_.resize(vertices_.size() + vertex_count);
+    indices_.resize(indices_.size() + index_count);
+    return static_cast<int>(base);
+}
+
+void FrameCommandBuffer::write_quad_indices(size_t index_offset, size_t count, int base) {
+    for (size_t i = 0; i < count; ++i) {
+        const int first = base + static_cast<int>(i * 4);
+        int* idx = &indices_[index_offset + i * 6];
+        idx[0] = first;
+        idx[1] = first + 1;
+        idx[2] = first + 2;
+        idx[3] = first;
+        idx[4] = first + 2;
+        idx[5] = first + 3;
+    }
+}
+
+bool FrameCommandBuffer::same_image(const FrameCommandBuffer& shown, float tolerance_px) const {
+    if (width_ != shown.width_ || height_ != shown.height_ || commands_.size() != shown.commands_.size() ||
+        rects_.size() != shown.rects_.size() || vertices_.size() != shown.vertices_.size() ||
+        indices_ != shown.indices_) {
+        return false;
+    }
+
+    for (size_t i = 0; i < commands_.size(); ++i) {
+        const Command& a = commands_[i];
+        const Command& b = shown.commands_[i];
+        if (a.type == CommandType::Waterfall || a.type != b.type || !same_color(a.color, b.color) ||
+            a.offset != b.offset || a.count != b.count || a.vertex_offset != b.vertex_offset ||
+            a.vertex_count != b.vertex_count) {
+            return false;
+        }
+    }
+
+    // Rects are whole pixels, so the tolerance rounds down
+    const int rect_tolerance = static_cast<int>(tolerance_px);
+    for (size_t i = 0; i < rects_.size(); ++i) {
+        const Renderer::Rect& a = rects_[i];
+        const Renderer::Rect& b = shown.rects_[i];
+        if (std::abs(a.x - b.x) > rect_tolerance || std::abs(a.y - b.y) > rect_tolerance ||
+            std::abs(a.w - b.w) > rect_tolerance || std::abs(a.h - b.h) > rect_tolerance) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < vertices_.size(); ++i) {
+        const SDL_Vertex& a = vertices_[i];
+        const SDL_Vertex& b = shown.vertices_[i];
+        if (std::fabs(a.position.x - b.position.x) > tolerance_px ||
+            std::fabs(a.position.y - b.position.y) > tolerance_px || !same_color(a.color, b.color)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FrameCommandBuffer::retain(const FrameCommandBuffer& frame) {
+    width_ = frame.width_;
+    height_ = frame.height_;
+    commands_ = frame.commands_;
+    rects_ = frame.rects_;
+    vertices_ = frame.vertices_;
+    indices_ = frame.indices_;
+    // Never compared (waterfall frames always redraw), so not copied
+    pixels_.clear();
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <SDL2/SDL.h>
+
+#include "renderer.h"
+
+/**
+ * Recorded draw commands for one frame.
+ * Renderer draw calls append here; present() replays the buffer against the
+ * SDL renderer, either inline or on the render thread. Storage is kept
+ * between frames (reset() only clears sizes), so steady-state recording
+ * does not allocate. Geometry batches carry their colour per vertex, so
+ * consecutive ones are merged into one command whatever their colours.
+ */
+class FrameCommandBuffer {
+public:
+    enum class CommandType { Clear, Rects, Geometry, Waterfall };
+
+    struct Command {
+        CommandType type;
+        SDL_Color color;
+        size_t offset;         // First rect (Rects), index (Geometry) or pixel (Waterfall)
+        size_t count;          // Rect, index or pixel (row) count
+        size_t vertex_offset;  // Geometry only: first vertex, indices are relative to it
+        size_t vertex_count;
+        int history = 0;       // Waterfall only: columns kept on screen
+    };
+
+    // Start a new frame targeting a width x height logical size
+    void reset(int width, int height);
+    void set_size(int width, int height) {
+        width_ = width;
+        height_ = height;
+    }
+
+    void clear(SDL_Color color);
+    void rects(const Renderer::Rect* rects, size_t count, SDL_Color color);
+    void lines(const Renderer::Line* lines, size_t count, SDL_Color color);
+    void geometry(const SDL_Vertex* vertices, size_t vertex_count,
+                  const int* indices, size_t index_count);
+
+    // Primitives with one colour each, recorded as quads
+    void colored_rects(const Renderer::Rect* rects, const SDL_Color* colors, size_t count);
+    void colored_lines(const Renderer::Line* lines, const SDL_Color* colors, size_t count);
+
+    // Space for one waterfall column of `rows` RGBA32 pixels, to be filled
+    // by the caller; replay pushes it into the ring and draws the history
+    uint32_t* waterfall(size_t rows, int history);
+
+    // Capture time of the audio the frame shows; the epoch when unset
+    void set_capture_time(std::chrono::steady_clock::time_point captured) { capture_time_ = captured; }
+    std::chrono::steady_clock::time_point capture_time() const { return capture_time_; }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    bool empty() const { return commands_.empty(); }
+
+    // Whether replaying this frame would draw what `shown` drew, with every
+    // rect edge and vertex within `tolerance_px` pixels and all colours
+    // equal. Frames with a waterfall never match: each one scrolls it.
+    bool same_image(const FrameCommandBuffer& shown, float tolerance_px) const;
+
+    // Keep a copy of `frame` to compare later frames against; reuses storage
+    void retain(const FrameCommandBuffer& frame);
+
+    // Times any storage had to grow; stays flat once frames are warmed up
+    size_t heap_allocations() const { return heap_allocations_; }
+
+    const std::vector<Command>& commands() const { return commands_; }
+    const std::vector<Renderer::Rect>& rect_data() const { return rects_; }
+    const std::vector<SDL_Vertex>& vertex_data() const { return vertices_; }
+    const std::vector<int>& index_data() const { return indices_; }
+    const std::vector<uint32_t>& pixel_data() const { return pixels_; }
+
+private:
+    // Make room for a geometry batch at the end of the vertex and index
+    // storage. Consecutive geometry batches share one command, so a frame
+    // of lines, colored primitives and display lists replays as a single
+    // SDL_RenderGeometry call. Returns the batch's first vertex relative to
+    // its command, which its indices must be offset by.
+    int append_geometry(size_t vertex_count, size_t index_count);
+
+    // Index pattern for `count` quads starting at vertex `base` of the command
+    void write_quad_indices(size_t index_offset, size_t count, int base);
+
+    int width_ = 0;
+    int height_ = 0;
+    std::chrono::steady_clock::time_point capture_time_{};
+    std::vector<Command> commands_;
+    std::vector<Renderer::Rect> rects_;
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+    std::vector<uint32_t> pixels_;
+    size_t heap_allocations_ = 0;
+};
@@ -0,0 +1,184 @@
+#include "decoder.h"
+#include "wav_file.h"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef AUDIOVIZ_HAVE_SNDFILE
+#include <sndfile.h>
+#endif
+
+namespace {
+
+// PCM/float WAV straight from the mapping, converted per read
+class WavSource : public AudioSource {
+public:
+    explicit WavSource(const std::string& path) : wav_(path, MappedFile::Access::Sequential) {}
+
+    int sample_rate() const override { return wav_.sample_rate(); }
+    size_t channels() const override { return wav_.channels(); }
+    size_t frames() const override { return wav_.frames(); }
+
+    size_t read(float* out, size_t frames) override {
+        const size_t n = std::min(frames, wav_.frames() - position_);
+        wav_.read(position_, n, out);
+        position_ += n;
+        return n;
+    }
+
+private:
+    WavFile wav_;
+    size_t position_ = 0;
+};
+
+#ifdef AUDIOVIZ_HAVE_SNDFILE
+// Any format libsndfile understands, converted to float32 by the library
+class SndfileSource : public AudioSource {
+public:
+    explicit SndfileSource(const std::string& path) {
+        file_ = sf_open(path.c_str(), SFM_READ, &info_);
+        if (file_ == nullptr) {
+            throw std::runtime_error("Cannot open " + path + ": " + sf_strerror(nullptr));
+        }
+    }
+
+    ~SndfileSource() override { sf_close(file_); }
+
+    int sample_rate() const override { return info_.samplerate; }
+    size_t channels() const override { return static_cast<size_t>(info_.channels); }
+    size_t frames() const override { return static_cast<size_t>(info_.frames); }
+
+    size_t read(float* out, size_t frames) override {
+        const sf_count_t n = sf_readf_float(file_, out, static_cast<sf_count_t>(frames));
+        if (n < 0) {
+            throw std::runtime_error(std::string("Decode error: ") + sf_strerror(file_));
+        }
+        return static_cast<size_t>(n);
+    }
+
+private:
+    SNDFILE* file_ = nullptr;
+    SF_INFO info_{};
+};
+#endif
+
+}  // namespace
+
+std::unique_ptr<AudioSource> open_audio_source(const std::string& path) {
+    // Plain WAV needs no decoder; anything else (or exotic WAV) goes to libsndfile
+    try {
+        return std::make_unique<WavSource>(path);
+    } catch (const std::runtime_error& wav_error) {
+#ifdef AUDIOVIZ_HAVE_SNDFILE
+        (void)wav_error;
+        return std::make_unique<SndfileSource>(path);
+#else
+        throw std::runtime_error(std::string(wav_error.what()) + " (libaudioviz was built without libsndfile)");
+#endif
+    }
+}
+
+PrefetchDecoder::PrefetchDecoder(std::unique_ptr<AudioSource> source, size_t block_frames, size_t depth)
+    : source_(std::move(source)) {
+    if (!source_) {
+        throw std::invalid_argument("source must not be null");
+    }
+    if (block_frames == 0 || depth == 0) {
+        throw std::invalid_argument("block_frames and depth must be positive");
+    }
+    sample_rate_ = source_->sample_rate();
+    channels_ = source_->channels();
+    frames_ = source_->frames();
+    block_frames_ = block_frames;
+
+    pool_.resize(depth);
+    for (Slot& slot : pool_) {
+        slot.samples.resize(block_frames * channels_);
+        slot.block.data = slot.samples.data();
+        free_.push_back(&slot);
+    }
+    thread_ = std::thread([this] { decode_loop(); });
+}
+
+PrefetchDecoder::~PrefetchDecoder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+}
+
+void PrefetchDecoder::decode_loop() {
+    size_t decoded = 0;
+    while (true) {
+        Slot* slot = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [this] { return stop_ || !free_.empty(); });
+            if (stop_) return;
+            slot = free_.front();
+            free_.pop_front();
+        }
+
+        // Fill a whole block unless the file ends first; I/O runs unlocked
+        size_t filled = 0;
+        std::exception_ptr error;
+        try {
+            while (filled < block_frames_) {
+                const size_t n = source_->read(slot->samples.data() + filled * channels_,
+                                               block_frames_ - filled);
+                if (n == 0) break;
+                filled += n;
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        decoded += filled;
+        const bool last = error || filled < block_frames_ || (frames_ > 0 && decoded >= frames_);
+        slot->block.frames = filled;
+        slot->block.last = last;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (error) {
+                error_ = error;
+                free_.push_back(slot);
+            } else if (filled > 0) {
+                ready_.push_back(slot);
+            } else {
+                free_.push_back(slot);
+            }
+            finished_ = last;
+        }
+        changed_.notify_all();
+        if (last) return;
+    }
+}
+
+const PrefetchDecoder::Block* PrefetchDecoder::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return !ready_.empty() || finished_; });
+    if (!ready_.empty()) {
+        Slot* slot = ready_.front();
+        ready_.pop_front();
+        return &slot->block;
+    }
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+    return nullptr;
+}
+
+void PrefetchDecoder::release(const Block* block) {
+    if (block == nullptr) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Slot& slot : pool_) {
+            if (&slot.block == block) {
+                free_.push_back(&slot);
+                break;
+            }
+        }
+    }
+    changed_.notify_all();
+}
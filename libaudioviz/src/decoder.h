@@ -0,0 +1,89 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Sequential reader of interleaved float32 frames from an audio file.
+ */
+class AudioSource {
+public:
+    virtual ~AudioSource() = default;
+
+    virtual int sample_rate() const = 0;
+    virtual size_t channels() const = 0;
+    virtual size_t frames() const = 0;
+
+    // Read up to `frames` frames into `out` (frames * channels floats).
+    // Returns the number read; 0 means end of file.
+    virtual size_t read(float* out, size_t frames) = 0;
+};
+
+// Open `path` with the best available decoder: the mapped WavFile reader for
+// PCM/float WAV, libsndfile (when compiled in) for everything else. Throws
+// std::runtime_error if no decoder can read the file.
+std::unique_ptr<AudioSource> open_audio_source(const std::string& path);
+
+/**
+ * Decodes ahead of the consumer on a background thread.
+ * A fixed pool of `depth` blocks of `block_frames` frames is allocated up
+ * front; the thread fills free blocks in file order and queues them, and the
+ * consumer hands each block back with release() once it is done with it. So
+ * I/O overlaps analysis, and memory stays at depth blocks however long the
+ * file is. Decode errors are rethrown from acquire().
+ */
+class PrefetchDecoder {
+public:
+    struct Block {
+        const float* data = nullptr;  // frames * channels interleaved samples
+        size_t frames = 0;
+        bool last = false;            // No blocks follow this one
+    };
+
+    PrefetchDecoder(std::unique_ptr<AudioSource> source, size_t block_frames, size_t depth);
+    ~PrefetchDecoder();
+
+    PrefetchDecoder(const PrefetchDecoder&) = delete;
+    PrefetchDecoder& operator=(const PrefetchDecoder&) = delete;
+
+    int sample_rate() const { return sample_rate_; }
+    size_t channels() const { return channels_; }
+    size_t frames() const { return frames_; }
+    size_t block_frames() const { return block_frames_; }
+    size_t depth() const { return pool_.size(); }
+
+    // Wait for the next block in file order; nullptr once the file is done.
+    // At most depth() blocks can be held before they must be released.
+    const Block* acquire();
+    void release(const Block* block);
+
+private:
+    struct Slot {
+        Block block;
+        std::vector<float> samples;
+    };
+
+    void decode_loop();
+
+    std::unique_ptr<AudioSource> source_;
+    int sample_rate_;
+    size_t channels_;
+    size_t frames_;
+    size_t block_frames_;
+
+    std::vector<Slot> pool_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<Slot*> free_;
+    std::deque<Slot*> ready_;
+    bool finished_ = false;   // Decoder thread queued its last block
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::thread thread_;
+};
@@ -0,0 +1,119 @@
+#include "display_list.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Append an axis-aligned quad (TL, TR, BR, BL) spanning [x0, x1) at full height
+void push_bar_quad(std::vector<SDL_Vertex>& vertices, float x0, float x1, float bottom, SDL_Color color) {
+    vertices.push_back({{x0, bottom}, color, {0.0f, 0.0f}});
+    vertices.push_back({{x1, bottom}, color, {0.0f, 0.0f}});
+    vertices.push_back({{x1, bottom}, color, {0.0f, 0.0f}});
+    vertices.push_back({{x0, bottom}, color, {0.0f, 0.0f}});
+}
+
+}  // namespace
+
+DisplayList::DisplayList(Kind kind, size_t size, int width, int height, SDL_Color color)
+    : kind_(kind), size_(size), width_(width), height_(height), color_(color) {}
+
+DisplayList DisplayList::bars(size_t size, int width, int height,
+                              const BarStyle& style, SDL_Color color) {
+    DisplayList list(Kind::Bars, size, width, height, color);
+    list.bar_style_ = style;
+    list.heights_.resize(size);
+    if (size == 0) return list;
+
+    // Same column layout (and left-edge clipping) as build_bar_rects
+    const int count = static_cast<int>(size);
+    const float bottom = static_cast<float>(height);
+
+    if (style.mirror) {
+        const int bar_width = std::max(1, width / (count * 2));
+        const int center_x = width / 2;
+
+        for (int i = 0; i < count; ++i) {
+            const int right_x = center_x + i * bar_width;
+            push_bar_quad(list.vertices_, right_x, right_x + bar_width, bottom, color);
+            list.quad_bins_.push_back(i);
+
+            const int left_x = center_x - (i + 1) * bar_width;
+            const int left_end = left_x + bar_width;
+            if (left_end > 0) {
+                push_bar_quad(list.vertices_, std::max(left_x, 0), left_end, bottom, color);
+                list.quad_bins_.push_back(i);
+            }
+        }
+    } else {
+        const int bar_width = std::max(1, width / count);
+        for (int i = 0; i < count; ++i) {
+            push_bar_quad(list.vertices_, i * bar_width, (i + 1) * bar_width, bottom, color);
+            list.quad_bins_.push_back(i);
+        }
+    }
+
+    build_quad_indices(list.quad_count(), list.indices_);
+    return list;
+}
+
+DisplayList DisplayList::radial(size_t size, int width, int height,
+                                const RadialStyle& style, SDL_Color color) {
+    DisplayList list(Kind::Radial, size, width, height, color);
+    list.radial_style_ = style;
+    if (size == 0) return list;
+
+    // Unit vectors only depend on the bin count, so they are computed once here
+    list.radial_layout_ = RadialLayout::build(size, width, height, style);
+    const size_t quads = list.radial_layout_.line_count();
+    list.vertices_.resize(quads * 4);
+    build_quad_indices(quads, list.indices_);
+    return list;
+}
+
+void DisplayList::update(const float* magnitudes, size_t size) {
+    if (size != size_) {
+        throw std::invalid_argument("DisplayList built for " + std::to_string(size_) +
+                                    " bins, got " + std::to_string(size));
+    }
+    if (size_ == 0) return;
+
+    if (kind_ == Kind::Bars) {
+        update_bars(magnitudes);
+    } else {
+        update_radial(magnitudes);
+    }
+}
+
+void DisplayList::update_bars(const float* magnitudes) {
+    normalize_bar_heights(magnitudes, size_, bar_style_, heights_.data());
+
+    // Only the top edge of each quad moves
+    for (size_t q = 0; q < quad_bins_.size(); ++q) {
+        const int bar_height = std::min(
+            static_cast<int>(heights_[quad_bins_[q]] * bar_style_.scale * height_), height_);
+        const float top = static_cast<float>(height_ - bar_height);
+        vertices_[q * 4 + 0].position.y = top;
+        vertices_[q * 4 + 1].position.y = top;
+    }
+}
+
+void DisplayList::update_radial(const float* magnitudes) {
+    const RadialLayout& layout = radial_layout_;
+    const float center_x = static_cast<float>(width_ / 2);
+    const float center_y = static_cast<float>(height_ / 2);
+    const float base_radius = static_cast<float>(layout.base_radius);
+    const float max_length = static_cast<float>(layout.max_length);
+    const float scale = radial_style_.scale;
+
+    for (size_t q = 0; q < layout.line_count(); ++q) {
+        const float dir_x = static_cast<float>(layout.dir_x[q]);
+        const float dir_y = static_cast<float>(layout.dir_y[q]);
+        const float length = std::min(magnitudes[layout.bins[q]] * scale, max_length);
+        const float outer = base_radius + length;
+        write_line_quad(&vertices_[q * 4],
+                        center_x + dir_x * base_radius, center_y + dir_y * base_radius,
+                        center_x + dir_x * outer, center_y + dir_y * outer,
+                        color_);
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <SDL2/SDL.h>
+
+#include "geometry.h"
+
+/**
+ * Retained geometry for one visualizer mode at one window size.
+ * Topology (quad count, bar columns, line directions, index buffer) is built
+ * once; per frame, update() only rewrites the vertex positions that depend on
+ * the magnitudes, in place. The whole list is submitted with a single
+ * SDL_RenderGeometry call via Renderer::draw_display_list().
+ */
+class DisplayList {
+public:
+    enum class Kind { Bars, Radial };
+
+    static DisplayList bars(size_t size, int width, int height,
+                            const BarStyle& style, SDL_Color color);
+    static DisplayList radial(size_t size, int width, int height,
+                              const RadialStyle& style, SDL_Color color);
+
+    // Recompute magnitude-dependent vertex positions. `size` must match the
+    // bin count the list was built for.
+    void update(const float* magnitudes, size_t size);
+
+    // True if this list can be reused for the given bin count and window size
+    bool matches(size_t size, int width, int height) const {
+        return size == size_ && width == width_ && height == height_;
+    }
+
+    Kind kind() const { return kind_; }
+    size_t size() const { return size_; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+    size_t quad_count() const { return vertices_.size() / 4; }
+
+    const std::vector<SDL_Vertex>& vertices() const { return vertices_; }
+    const std::vector<int>& indices() const { return indices_; }
+
+private:
+    DisplayList(Kind kind, size_t size, int width, int height, SDL_Color color);
+
+    void update_bars(const float* magnitudes);
+    void update_radial(const float* magnitudes);
+
+    Kind kind_;
+    size_t size_;
+    int width_;
+    int height_;
+    SDL_Color color_;
+
+    BarStyle bar_style_;
+    RadialStyle radial_style_;
+
+    // Source bin for every bar quad (one or two quads per bin)
+    std::vector<int> quad_bins_;
+    // Radial layout: unit direction per quad and the base/max radius
+    RadialLayout radial_layout_;
+
+    std::vector<float> heights_;
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+};
@@ -0,0 +1,63 @@
+#include "envelope.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Share of the remaining distance a one-pole filter covers in `dt_ms`
+float smoothing(float dt_ms, float time_constant_ms) {
+    return time_constant_ms > 0.0f ? 1.0f - std::exp(-dt_ms / time_constant_ms) : 1.0f;
+}
+
+// One fused pass over the bands. The restrict parameters rule out aliasing
+// (GCC otherwise versions the loop behind a runtime overlap check), and the
+// selects rather than branches let the compiler if-convert and vectorise it
+// with -fno-trapping-math (see CMakeLists.txt).
+void follow(const float* __restrict input, float* __restrict envelope, float* __restrict peaks,
+            float* __restrict hold, size_t size, float attack, float release, float fall,
+            float hold_ms, float dt_ms) {
+    for (size_t i = 0; i < size; ++i) {
+        const float x = input[i];
+        float e = envelope[i];
+        e += (x - e) * (x > e ? attack : release);
+        envelope[i] = e;
+
+        // A new high resets the hold; settling on e covers that case too,
+        // since the decayed peak never exceeds the old one
+        const float p = peaks[i];
+        const float h = hold[i] - dt_ms;
+        const float left = h > 0.0f ? h : 0.0f;
+        const float decayed = left > 0.0f ? p : p * fall;
+        peaks[i] = decayed > e ? decayed : e;
+        hold[i] = e >= p ? hold_ms : left;
+    }
+}
+
+}  // namespace
+
+EnvelopeFollower::EnvelopeFollower(const EnvelopeStyle& style, size_t bands) : style_(style) {
+    resize(bands);
+}
+
+void EnvelopeFollower::resize(size_t bands) {
+    envelope_.assign(bands, 0.0f);
+    peaks_.assign(bands, 0.0f);
+    hold_ms_.assign(bands, 0.0f);
+}
+
+void EnvelopeFollower::reset() {
+    resize(size());
+}
+
+void EnvelopeFollower::process(const float* magnitudes, size_t size, float dt_ms) {
+    if (size != envelope_.size()) resize(size);
+    if (dt_ms <= 0.0f) return;
+
+    const float attack = smoothing(dt_ms, style_.attack_ms);
+    const float release = smoothing(dt_ms, style_.release_ms);
+    const float fall = 1.0f - smoothing(dt_ms, style_.peak_release_ms);
+    const float hold_ms = style_.peak_hold_ms;
+
+    follow(magnitudes, envelope_.data(), peaks_.data(), hold_ms_.data(), size,
+           attack, release, fall, hold_ms, dt_ms);
+}
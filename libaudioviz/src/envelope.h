@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * Temporal smoothing and peak hold for per-band magnitudes.
+ * Sits between band extraction and geometry: each update runs one fused pass
+ * over contiguous float arrays, moving every band's envelope toward its new
+ * magnitude with a one-pole exponential filter (fast attack, slow release)
+ * and tracking a held peak above it that falls back after a hold time. The
+ * filter coefficients are computed once per update from the elapsed time, so
+ * the result does not depend on how often frames are drawn. State is only
+ * (re)allocated when the band count changes.
+ */
+
+struct EnvelopeStyle {
+    float attack_ms = 10.0f;         // Time constant while the magnitude rises (0 = instant)
+    float release_ms = 150.0f;       // Time constant while it falls
+    float peak_hold_ms = 500.0f;     // How long a peak stays put before falling
+    float peak_release_ms = 400.0f;  // Time constant of the fall after the hold
+};
+
+class EnvelopeFollower {
+public:
+    explicit EnvelopeFollower(const EnvelopeStyle& style = {}, size_t bands = 0);
+
+    // Advance every band by `dt_ms` toward `magnitudes`. A different band
+    // count resets the state to silence first; dt_ms == 0 leaves it as is.
+    void process(const float* magnitudes, size_t size, float dt_ms);
+
+    // Drop all state back to silence
+    void reset();
+
+    size_t size() const { return envelope_.size(); }
+    const EnvelopeStyle& style() const { return style_; }
+    const float* envelope() const { return envelope_.data(); }
+    const float* peaks() const { return peaks_.data(); }
+
+private:
+    void resize(size_t bands);
+
+    EnvelopeStyle style_;
+    std::vector<float> envelope_;
+    std::vector<float> peaks_;
+    std::vector<float> hold_ms_;   // Hold time left per band
+};
@@ -0,0 +1,74 @@
+#include "fft.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+}
+
+RealFFT::RealFFT(size_t size) : size_(size), half_(size / 2) {
+    if (size < 2 || !is_power_of_two(size)) {
+        throw std::invalid_argument("FFT size must be a power of two >= 2, got " + std::to_string(size));
+    }
+
+    // Bit-reversal permutation for the half-size complex transform
+    bitrev_.resize(half_);
+    size_t bits = 0;
+    while ((size_t{1} << bits) < half_) ++bits;
+    for (size_t i = 0; i < half_; ++i) {
+        size_t r = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        bitrev_[i] = r;
+    }
+
+    // Twiddles are computed in double precision to keep rounding error flat
+    twiddles_.resize(half_ / 2 + 1);
+    for (size_t k = 0; k < twiddles_.size(); ++k) {
+        const double angle = -2.0 * kPi * k / half_;
+        twiddles_[k] = {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+    }
+    post_twiddles_.resize(half_ + 1);
+    for (size_t k = 0; k <= half_; ++k) {
+        const double angle = -2.0 * kPi * k / size_;
+        post_twiddles_[k] = {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+    }
+
+    work_.resize(half_);
+}
+
+void RealFFT::transform_half() {
+    // Iterative radix-2 decimation in time on work_ (already bit-reversed)
+    for (size_t len = 2; len <= half_; len <<= 1) {
+        const size_t step = half_ / len;
+        const size_t span = len / 2;
+        for (size_t start = 0; start < half_; start += len) {
+            for (size_t j = 0; j < span; ++j) {
+                const std::complex<float> w = twiddles_[j * step];
+                const std::complex<float> t = w * work_[start + j + span];
+                const std::complex<float> u = work_[start + j];
+                work_[start + j] = u + t;
+                work_[start + j + span] = u - t;
+            }
+        }
+    }
+}
+
+void RealFFT::forward(const float* input, std::complex<float>* output) {
+    // Pack even/odd samples as one complex sequence of half the length
+    for (size_t n = 0; n < half_; ++n) {
+        work_[bitrev_[n]] = {input[2 * n], input[2 * n + 1]};
+    }
+    transform_half();
+
+    // Split the packed spectrum back into the real signal's spectrum:
+    // X[k] = (Z[k] + conj(Z[M-k])) / 2 - i W^k (Z[k] - conj(Z[M-k])) / 2
+    const std::complex<float> half_i(0.0f, 0.5f);
+    for (size_t k = 0; k <= half_; ++k) {
+        const std::complex<float> z = work_[k == half_ ? 0 : k];
+        const std::complex<float> zc = std::conj(work_[k == 0 ? 0 : half_ - k]);
+        output[k] = 0.5f * (z + zc) - half_i * post_twiddles_[k] * (z - zc);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Reusable real-input FFT plan for power-of-two sizes.
+ * Bit-reversal order and twiddle factors are computed once at construction,
+ * so repeated transforms of the same size allocate nothing.
+ */
+class RealFFT {
+public:
+    explicit RealFFT(size_t size);
+
+    size_t size() const { return size_; }
+    size_t bins() const { return size_ / 2 + 1; }
+
+    // Forward transform of `size()` real samples into `bins()` complex bins
+    void forward(const float* input, std::complex<float>* output);
+
+private:
+    void transform_half();
+
+    size_t size_;
+    size_t half_;
+    std::vector<size_t> bitrev_;
+    std::vector<std::complex<float>> twiddles_;       // e^{-2 pi i k / half}
+    std::vector<std::complex<float>> post_twiddles_;  // e^{-2 pi i k / size}
+    std::vector<std::complex<float>> work_;
+};
+
+inline bool is_power_of_two(size_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
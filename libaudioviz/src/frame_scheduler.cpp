@@ -0,0 +1,110 @@
+#include "frame_scheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+FrameScheduler::FrameScheduler(int sample_rate, size_t nperseg, size_t hop, double display_latency_ms,
+                               bool interpolate)
+    : sample_rate_(sample_rate),
+      nperseg_(static_cast<int64_t>(nperseg)),
+      hop_(static_cast<int64_t>(hop)),
+      display_latency_ms_(display_latency_ms),
+      interpolate_(interpolate) {
+    if (sample_rate <= 0) throw std::invalid_argument("sample_rate must be positive");
+    if (hop == 0) throw std::invalid_argument("hop must be positive");
+    intervals_ms_.reserve(kWindow);
+}
+
+int64_t FrameScheduler::frame_end(int64_t index) const {
+    return index * hop_ + nperseg_ / 2;
+}
+
+FrameScheduler::Tick FrameScheduler::tick(int64_t played_frames, bool force) {
+    ++ticks_;
+
+    // Playback position when an image drawn now reaches the screen
+    const double position = played_frames + display_latency_ms_ * sample_rate_ / 1000.0;
+    const double exact = (position - nperseg_ / 2) / static_cast<double>(hop_);
+
+    Tick tick;
+    if (exact >= 0.0) {
+        tick.frame = static_cast<int64_t>(exact);
+        if (interpolate_) tick.fraction = static_cast<float>(exact - tick.frame);
+    }
+
+    const bool changed = !shown_ || tick.frame != shown_frame_ || tick.fraction != shown_fraction_;
+    tick.render = changed || force;
+    if (!tick.render) {
+        ++held_;
+        const double due = static_cast<double>(frame_end(tick.frame + 1)) - position;
+        tick.wait_ms = std::max(0.0, due * 1000.0 / sample_rate_);
+        return tick;
+    }
+
+    if (shown_ && tick.frame > shown_frame_ + 1) {
+        tick.skipped = static_cast<size_t>(tick.frame - shown_frame_ - 1);
+        skipped_ += tick.skipped;
+    }
+    ++rendered_;
+    shown_ = true;
+    shown_frame_ = tick.frame;
+    shown_fraction_ = tick.fraction;
+    return tick;
+}
+
+void FrameScheduler::frame_presented(double at_ms) {
+    if (presents_ > 0) {
+        const double interval = at_ms - last_present_ms_;
+        if (intervals_ms_.size() < kWindow) {
+            intervals_ms_.push_back(interval);
+        } else {
+            intervals_ms_[next_interval_] = interval;
+        }
+        next_interval_ = (next_interval_ + 1) % kWindow;
+    }
+    last_present_ms_ = at_ms;
+    ++presents_;
+}
+
+FrameScheduler::Summary FrameScheduler::summary() const {
+    Summary summary;
+    summary.ticks = ticks_;
+    summary.rendered = rendered_;
+    summary.held = held_;
+    summary.skipped = skipped_;
+    summary.presents = presents_;
+    if (intervals_ms_.empty()) return summary;
+
+    double sum = 0.0;
+    for (double interval : intervals_ms_) sum += interval;
+    const double mean = sum / intervals_ms_.size();
+
+    double squares = 0.0;
+    double deviation = 0.0;
+    for (double interval : intervals_ms_) {
+        const double d = interval - mean;
+        squares += d * d;
+        deviation = std::max(deviation, std::abs(d));
+    }
+    summary.mean_interval_ms = mean;
+    summary.jitter_ms = std::sqrt(squares / intervals_ms_.size());
+    summary.max_deviation_ms = deviation;
+    return summary;
+}
+
+void FrameScheduler::reset() {
+    shown_ = false;
+    shown_frame_ = -1;
+    shown_fraction_ = 0.0f;
+    ticks_ = rendered_ = held_ = skipped_ = 0;
+    intervals_ms_.clear();
+    next_interval_ = 0;
+    presents_ = 0;
+    last_present_ms_ = 0.0;
+}
+
+double FrameScheduler::now_ms() {
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration<double, std::milli>(Clock::now().time_since_epoch()).count();
+}
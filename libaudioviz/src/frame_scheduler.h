@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Decides, once per loop iteration, which STFT frame the display shows.
+ * The audio device's sample clock is the time base: from the frames that
+ * have reached the speaker plus the latency between drawing and the image
+ * appearing, the scheduler works out where playback will be when the next
+ * image is seen and maps that onto the STFT frame grid. If that frame is
+ * already on screen it says to hold, and for how long, instead of drawing
+ * the same frame again; if several frames came due since the last render,
+ * only the newest is drawn and the stale ones are counted as skipped. With
+ * interpolation on, every tick renders a position between the two frames
+ * around the playhead instead (the caller must be able to read one frame
+ * ahead, so this suits precomputed spectrograms).
+ *
+ * Present timestamps feed a rolling window of intervals from which the
+ * frame-pacing jitter is reported. Single-threaded: drive it from the loop
+ * that renders.
+ */
+class FrameScheduler {
+public:
+    struct Tick {
+        bool render = false;    // Draw and present this iteration; otherwise hold
+        int64_t frame = -1;     // STFT frame to show; -1 until the first is complete
+        float fraction = 0.0f;  // Blend from `frame` toward frame + 1 (interpolation only)
+        size_t skipped = 0;     // Frames that came due since the last render and were never shown
+        double wait_ms = 0.0;   // When holding: time until the next frame is due
+    };
+
+    struct Summary {
+        size_t ticks = 0;
+        size_t rendered = 0;
+        size_t held = 0;
+        size_t skipped = 0;               // Stale frames jumped over
+        size_t presents = 0;
+        double mean_interval_ms = 0.0;    // Present to present, over the rolling window
+        double jitter_ms = 0.0;           // Standard deviation of those intervals
+        double max_deviation_ms = 0.0;    // Largest distance of one interval from the mean
+    };
+
+    static constexpr size_t kWindow = 256;
+
+    // `display_latency_ms` is how long a drawn frame takes to reach the
+    // screen (e.g. one refresh, two with a render thread). Throws
+    // std::invalid_argument unless sample_rate and hop are positive.
+    FrameScheduler(int sample_rate, size_t nperseg, size_t hop, double display_latency_ms = 0.0,
+                   bool interpolate = false);
+
+    // `played_frames` have reached the speaker by now. `force` renders even
+    // when the frame is unchanged (input, mode switches, resizes).
+    Tick tick(int64_t played_frames, bool force = false);
+
+    // Mark a present at `at_ms` on a monotonic clock (see now_ms)
+    void frame_presented(double at_ms);
+
+    // Samples needed before frame `index` is complete (scipy boundary padding)
+    int64_t frame_end(int64_t index) const;
+
+    void set_display_latency_ms(double latency_ms) { display_latency_ms_ = latency_ms; }
+    double display_latency_ms() const { return display_latency_ms_; }
+    bool interpolate() const { return interpolate_; }
+
+    Summary summary() const;
+    void reset();
+
+    // Steady-clock milliseconds
+    static double now_ms();
+
+private:
+    int sample_rate_;
+    int64_t nperseg_;
+    int64_t hop_;
+    double display_latency_ms_;
+    bool interpolate_;
+
+    bool shown_ = false;       // Something has been rendered since the reset
+    int64_t shown_frame_ = -1;
+    float shown_fraction_ = 0.0f;
+
+    size_t ticks_ = 0;
+    size_t rendered_ = 0;
+    size_t held_ = 0;
+    size_t skipped_ = 0;
+
+    std::vector<double> intervals_ms_;  // Ring of the last kWindow present intervals
+    size_t next_interval_ = 0;
+    size_t presents_ = 0;
+    double last_present_ms_ = 0.0;
+};
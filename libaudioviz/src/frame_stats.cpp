@@ -0,0 +1,137 @@
+#include "frame_stats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double kLateThreshold = 1.5;  // Intervals beyond this many targets are late
+
+double to_ms(FrameStats::Clock::duration elapsed) {
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+// Nearest-rank percentile of sorted samples
+double percentile(const std::vector<float>& sorted, double p) {
+    const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+}  // namespace
+
+FrameStats::FrameStats() {
+    for (auto& window : windows_) {
+        window.samples_ms.assign(kWindow, 0.0f);
+    }
+}
+
+void FrameStats::set_target_fps(double fps) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    target_interval_ms_ = fps > 0.0 ? 1000.0 / fps : 0.0;
+}
+
+double FrameStats::target_fps() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return target_interval_ms_ > 0.0 ? 1000.0 / target_interval_ms_ : 0.0;
+}
+
+void FrameStats::record(Stage stage, Clock::duration elapsed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    record_locked(stage, to_ms(elapsed));
+}
+
+void FrameStats::record_locked(Stage stage, double ms) {
+    Window& window = windows_[static_cast<size_t>(stage)];
+    window.samples_ms[window.next] = static_cast<float>(ms);
+    window.next = (window.next + 1) % kWindow;
+    ++window.total;
+}
+
+void FrameStats::frame_presented(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (has_last_present_) {
+        const double interval = to_ms(now - last_present_);
+        record_locked(Stage::Frame, interval);
+        last_frame_ms_ = interval;
+
+        if (target_interval_ms_ > 0.0 && interval > kLateThreshold * target_interval_ms_) {
+            ++late_frames_;
+            // The previous frame stayed on screen for `refreshes` vblanks;
+            // all but the first were missed (>= 1 past the threshold)
+            const auto refreshes = static_cast<size_t>(std::lround(interval / target_interval_ms_));
+            dropped_frames_ += refreshes - 1;
+        }
+    }
+    last_present_ = now;
+    has_last_present_ = true;
+}
+
+void FrameStats::frame_unchanged() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++unchanged_frames_;
+}
+
+FrameStats::Summary FrameStats::summary() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Summary summary;
+    summary.frames = windows_[static_cast<size_t>(Stage::Present)].total;
+    summary.late_frames = late_frames_;
+    summary.dropped_frames = dropped_frames_;
+    summary.unchanged_frames = unchanged_frames_;
+    summary.target_interval_ms = target_interval_ms_;
+    summary.last_frame_ms = last_frame_ms_;
+
+    std::vector<float> sorted;
+    for (size_t i = 0; i < windows_.size(); ++i) {
+        const Window& window = windows_[i];
+        StageSummary& stage = summary.stages[i];
+        stage.count = window.total;
+        if (window.total == 0) continue;
+
+        const size_t filled = std::min(window.total, kWindow);
+        sorted.assign(window.samples_ms.begin(), window.samples_ms.begin() + filled);
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0.0;
+        for (float ms : sorted) sum += ms;
+        stage.mean_ms = sum / filled;
+        stage.p50_ms = percentile(sorted, 50.0);
+        stage.p95_ms = percentile(sorted, 95.0);
+        stage.p99_ms = percentile(sorted, 99.0);
+        stage.max_ms = sorted.back();
+    }
+    return summary;
+}
+
+double FrameStats::last_frame_ms() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_frame_ms_;
+}
+
+void FrameStats::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& window : windows_) {
+        window.next = 0;
+        window.total = 0;
+    }
+    late_frames_ = 0;
+    dropped_frames_ = 0;
+    unchanged_frames_ = 0;
+    last_frame_ms_ = 0.0;
+    has_last_present_ = false;
+}
+
+const char* FrameStats::stage_name(Stage stage) {
+    switch (stage) {
+    case Stage::Clear:   return "clear";
+    case Stage::Draw:    return "draw";
+    case Stage::Present: return "present";
+    case Stage::Vsync:   return "vsync";
+    case Stage::Events:  return "events";
+    case Stage::Input:   return "input";
+    case Stage::Latency: return "latency";
+    case Stage::Frame:   return "frame";
+    case Stage::Count:   break;
+    }
+    return "unknown";
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * Per-stage frame timing for the Renderer.
+ * Every stage keeps a rolling window of its most recent durations, from which
+ * percentiles are computed on demand. Frame intervals (present to present)
+ * are compared against the target refresh interval to count late frames and
+ * the vblanks they missed. Stages may be recorded from the render thread, so
+ * all updates are serialised; the cost is one uncontended lock per sample.
+ */
+class FrameStats {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Stage {
+        Clear,    // Renderer::clear
+        Draw,     // Each draw batch call
+        Present,  // Renderer::present, as seen by the caller
+        Vsync,    // SDL_RenderPresent (swap / vsync wait)
+        Events,   // Renderer::poll_events
+        Input,    // From an event's timestamp to the present that followed it
+        Latency,  // From the capture of the newest audio in a frame to its swap (live input)
+        Frame,    // Interval between consecutive presents
+        Count
+    };
+
+    struct StageSummary {
+        size_t count = 0;        // Samples since the last reset
+        double mean_ms = 0.0;    // Over the rolling window
+        double p50_ms = 0.0;
+        double p95_ms = 0.0;
+        double p99_ms = 0.0;
+        double max_ms = 0.0;
+    };
+
+    struct Summary {
+        size_t frames = 0;
+        size_t late_frames = 0;     // Frames whose interval exceeded 1.5x the target
+        size_t dropped_frames = 0;  // Target intervals missed by late frames
+        size_t unchanged_frames = 0;  // Presents skipped because the image on screen was the same
+        double target_interval_ms = 0.0;
+        double last_frame_ms = 0.0;
+        std::array<StageSummary, static_cast<size_t>(Stage::Count)> stages{};
+    };
+
+    static constexpr size_t kWindow = 1024;
+
+    FrameStats();
+
+    // Target refresh used for late/dropped accounting; 0 disables it
+    void set_target_fps(double fps);
+    double target_fps() const;
+
+    void record(Stage stage, Clock::duration elapsed);
+
+    // Mark the end of a frame; the interval since the previous mark is
+    // recorded as Stage::Frame
+    void frame_presented(Clock::time_point now);
+
+    // A frame matched the one on screen and was not redrawn
+    void frame_unchanged();
+
+    Summary summary() const;
+    double last_frame_ms() const;
+    void reset();
+
+    static const char* stage_name(Stage stage);
+
+private:
+    struct Window {
+        std::vector<float> samples_ms;  // Ring of the last kWindow samples
+        size_t next = 0;
+        size_t total = 0;  // Samples since reset; the window holds min(total, kWindow)
+    };
+
+    void record_locked(Stage stage, double ms);
+
+    mutable std::mutex mutex_;
+    std::array<Window, static_cast<size_t>(Stage::Count)> windows_;
+    double target_interval_ms_ = 0.0;
+    size_t late_frames_ = 0;
+    size_t dropped_frames_ = 0;
+    size_t unchanged_frames_ = 0;
+    double last_frame_ms_ = 0.0;
+    bool has_last_present_ = false;
+    Clock::time_point last_present_;
+};
+
+/**
+ * Records the lifetime of a scope as one sample of a stage.
+ */
+class ScopedStageTimer {
+public:
+    ScopedStageTimer(FrameStats& stats, FrameStats::Stage stage)
+        : stats_(stats), stage_(stage), start_(FrameStats::Clock::now()) {}
+    ~ScopedStageTimer() { stats_.record(stage_, FrameStats::Clock::now() - start_); }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    FrameStats& stats_;
+    FrameStats::Stage stage_;
+    FrameStats::Clock::time_point start_;
+};
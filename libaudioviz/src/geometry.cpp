@@ -0,0 +1,182 @@
+#include "geometry.h"
+#include "kernels.h"
+#include "spectrum.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr float kLinearMax = 0.1f;  // Fixed max for the linear fallback
+
+}  // namespace
+
+void normalize_bar_heights(const float* magnitudes, size_t size, const BarStyle& style, float* out) {
+    if (style.log_scale) {
+        normalize_db(magnitudes, out, size, style.db_floor, style.db_ceiling);
+    } else {
+        normalize_linear_heights(magnitudes, size, out);
+    }
+}
+
+void normalize_linear_heights(const float* magnitudes, size_t size, float* out) {
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = std::clamp(magnitudes[i] / kLinearMax, 0.0f, 1.0f);
+    }
+}
+
+void build_bar_rects(const float* magnitudes, size_t size, int width, int height,
+                     const BarStyle& style, std::vector<Renderer::Rect>& out) {
+    // Per-thread height buffer for the immediate-mode path
+    thread_local std::vector<float> heights;
+    if (style.mirror) {
+        style.log_scale ? BarKernel<true, true>::build(magnitudes, size, width, height, style, heights, out)
+                        : BarKernel<true, false>::build(magnitudes, size, width, height, style, heights, out);
+    } else {
+        style.log_scale ? BarKernel<false, true>::build(magnitudes, size, width, height, style, heights, out)
+                        : BarKernel<false, false>::build(magnitudes, size, width, height, style, heights, out);
+    }
+}
+
+void build_peak_markers(const float* peaks, size_t size, int width, int height, const BarStyle& style,
+                        int thickness, std::vector<Renderer::Rect>& out) {
+    build_bar_rects(peaks, size, width, height, style, out);
+    const int marker = std::max(1, std::min(thickness, height));
+    for (Renderer::Rect& rect : out) {
+        rect.y = std::min(rect.y, height - marker);
+        rect.h = marker;
+    }
+}
+
+RadialLayout RadialLayout::build(size_t size, int width, int height, const RadialStyle& style) {
+    RadialLayout layout;
+    layout.size = size;
+    layout.width = width;
+    layout.height = height;
+    layout.base_radius_ratio = style.base_radius_ratio;
+    layout.mirror = style.mirror;
+    if (size == 0) return layout;
+
+    const int count = static_cast<int>(size);
+    const int center_x = width / 2;
+    const int center_y = height / 2;
+    const double max_radius = std::min(width, height) / 2.0;
+    const double base_radius = max_radius * style.base_radius_ratio;
+    const double angle_step = 2.0 * kPi / count;
+    layout.center_x = center_x;
+    layout.center_y = center_y;
+    layout.base_radius = base_radius;
+    layout.max_length = max_radius - base_radius;
+
+    const size_t lines = style.mirror ? size * 2 : size;
+    layout.bins.reserve(lines);
+    layout.dir_x.reserve(lines);
+    layout.dir_y.reserve(lines);
+    layout.base_x.reserve(lines);
+    layout.base_y.reserve(lines);
+
+    const auto push = [&](int bin, double c, double s) {
+        layout.bins.push_back(bin);
+        layout.dir_x.push_back(c);
+        layout.dir_y.push_back(s);
+        layout.base_x.push_back(static_cast<int>(center_x + c * base_radius));
+        layout.base_y.push_back(static_cast<int>(center_y + s * base_radius));
+    };
+
+    for (int i = 0; i < count; ++i) {
+        const double angle = i * angle_step;
+        const double c = std::cos(angle);
+        const double s = std::sin(angle);
+        push(i, c, s);
+
+        // Mirror across horizontal axis: cos(-a) = cos(a), sin(-a) = -sin(a)
+        const bool is_zero_angle = (i == 0);
+        const bool is_pi_angle = (count % 2 == 0 && i == count / 2);
+        if (style.mirror && !(is_zero_angle || is_pi_angle)) {
+            push(i, c, -s);
+        }
+    }
+    return layout;
+}
+
+void build_radial_lines(const float* magnitudes, const RadialLayout& layout, float scale,
+                        std::vector<Renderer::Line>& out) {
+    const size_t lines = layout.line_count();
+    out.resize(lines);
+
+    for (size_t q = 0; q < lines; ++q) {
+        const double line_len = std::min(static_cast<double>(magnitudes[layout.bins[q]]) * scale,
+                                         layout.max_length);
+        const double outer = layout.base_radius + line_len;
+        out[q] = {
+            layout.base_x[q],
+            layout.base_y[q],
+            static_cast<int>(layout.center_x + layout.dir_x[q] * outer),
+            static_cast<int>(layout.center_y + layout.dir_y[q] * outer),
+        };
+    }
+}
+
+void write_line_quad(SDL_Vertex* quad, float x1, float y1, float x2, float y2, SDL_Color color) {
+    // Work in pixel centers so the quad covers the same pixels as the line
+    x1 += 0.5f;
+    y1 += 0.5f;
+    x2 += 0.5f;
+    y2 += 0.5f;
+
+    // Half-pixel offsets along (tx, ty) and across (nx, ny) the line
+    float tx = 0.5f, ty = 0.0f;
+    const float dx = x2 - x1;
+    const float dy = y2 - y1;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    if (length > 0.0f) {
+        tx = 0.5f * dx / length;
+        ty = 0.5f * dy / length;
+    }
+    const float nx = -ty;
+    const float ny = tx;
+
+    quad[0] = {{x1 - tx + nx, y1 - ty + ny}, color, {0.0f, 0.0f}};
+    quad[1] = {{x1 - tx - nx, y1 - ty - ny}, color, {0.0f, 0.0f}};
+    quad[2] = {{x2 + tx - nx, y2 + ty - ny}, color, {0.0f, 0.0f}};
+    quad[3] = {{x2 + tx + nx, y2 + ty + ny}, color, {0.0f, 0.0f}};
+}
+
+void write_rect_quad(SDL_Vertex* quad, const Renderer::Rect& rect, SDL_Color color) {
+    const float x0 = static_cast<float>(rect.x);
+    const float y0 = static_cast<float>(rect.y);
+    const float x1 = static_cast<float>(rect.x + rect.w);
+    const float y1 = static_cast<float>(rect.y + rect.h);
+    quad[0] = {{x0, y0}, color, {0.0f, 0.0f}};
+    quad[1] = {{x1, y0}, color, {0.0f, 0.0f}};
+    quad[2] = {{x1, y1}, color, {0.0f, 0.0f}};
+    quad[3] = {{x0, y1}, color, {0.0f, 0.0f}};
+}
+
+void build_quad_indices(size_t count, std::vector<int>& indices) {
+    indices.resize(count * 6);
+    for (size_t i = 0; i < count; ++i) {
+        const int base = static_cast<int>(i * 4);
+        int* idx = &indices[i * 6];
+        idx[0] = base;
+        idx[1] = base + 1;
+        idx[2] = base + 2;
+        idx[3] = base;
+        idx[4] = base + 2;
+        idx[5] = base + 3;
+    }
+}
+
+void build_line_quads(const Renderer::Line* lines, size_t count, SDL_Color color,
+                      std::vector<SDL_Vertex>& vertices, std::vector<int>& indices) {
+    vertices.resize(count * 4);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& line = lines[i];
+        write_line_quad(&vertices[i * 4], static_cast<float>(line.x1), static_cast<float>(line.y1),
+                        static_cast<float>(line.x2), static_cast<float>(line.y2), color);
+    }
+    // The index pattern only depends on the count, so skip rebuilding it
+    if (indices.size() != count * 6) {
+        build_quad_indices(count, indices);
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "renderer.h"
+
+/**
+ * Native geometry kernels for the built-in visualizer modes.
+ * These mirror bars_visualizer / circle_visualizer in visualizers.py, but run
+ * the normalisation, mirroring, edge clipping and primitive generation in a
+ * single pass over a float32 magnitude array.
+ */
+
+struct BarStyle {
+    float scale = 0.9f;          // Multiplier for normalized heights (0-1 range)
+    float db_floor = -60.0f;     // Quietest visible level in dB
+    float db_ceiling = -10.0f;   // Loudest expected level in dB
+    bool mirror = true;          // Mirror bars around the horizontal center
+    bool log_scale = true;       // dB scaling; linear against a fixed max otherwise
+};
+
+struct RadialStyle {
+    float scale = 3000.0f;              // Magnitude to line length multiplier
+    float base_radius_ratio = 0.2f;     // Inner circle radius as fraction of max radius
+    bool mirror = true;                 // Mirror lines across the horizontal axis
+};
+
+// Map raw magnitudes to 0-1 bar heights (dB or linear, per style) into `out`.
+void normalize_bar_heights(const float* magnitudes, size_t size, const BarStyle& style, float* out);
+
+// The linear half of normalize_bar_heights: magnitudes against a fixed max.
+void normalize_linear_heights(const float* magnitudes, size_t size, float* out);
+
+// Build bar rectangles for a width x height target. `out` is cleared first and
+// keeps its capacity, so callers can reuse it across frames.
+void build_bar_rects(const float* magnitudes, size_t size, int width, int height,
+                     const BarStyle& style, std::vector<Renderer::Rect>& out);
+
+// Thin markers at the heights `peaks` would give bars of this style, one per
+// bar rectangle and as wide as it. Markers stay inside the window at the
+// bottom. Same reuse contract as build_bar_rects.
+void build_peak_markers(const float* peaks, size_t size, int width, int height, const BarStyle& style,
+                        int thickness, std::vector<Renderer::Rect>& out);
+
+/**
+ * Precomputed directions for the radial mode. The angles only depend on the
+ * bin count and the base circle on the window size, so this is built once and
+ * reused until one of those (or the style) changes; per frame only the line
+ * lengths are computed from the magnitudes.
+ * Lines come in output order: bin i, then its mirror image if there is one.
+ */
+struct RadialLayout {
+    size_t size = 0;
+    int width = 0;
+    int height = 0;
+    float base_radius_ratio = 0.0f;
+    bool mirror = false;
+
+    double center_x = 0.0;
+    double center_y = 0.0;
+    double base_radius = 0.0;
+    double max_length = 0.0;     // Longest line that stays inside the window
+
+    std::vector<int> bins;       // Source bin per line
+    std::vector<double> dir_x;   // Unit direction per line
+    std::vector<double> dir_y;
+    std::vector<int> base_x;     // Start point on the base circle per line
+    std::vector<int> base_y;
+
+    static RadialLayout build(size_t size, int width, int height, const RadialStyle& style);
+
+    size_t line_count() const { return bins.size(); }
+    bool matches(size_t size, int width, int height, const RadialStyle& style) const {
+        return size == this->size && width == this->width && height == this->height &&
+               style.base_radius_ratio == base_radius_ratio && style.mirror == mirror;
+    }
+};
+
+// Build radial lines from a prebuilt layout. Same reuse contract as above.
+void build_radial_lines(const float* magnitudes, const RadialLayout& layout, float scale,
+                        std::vector<Renderer::Line>& out);
+
+// Write the 4 vertices of a 1px-wide quad covering the line (x1, y1)-(x2, y2).
+void write_line_quad(SDL_Vertex* quad, float x1, float y1, float x2, float y2, SDL_Color color);
+
+// Write the 4 vertices (TL, TR, BR, BL) of a quad covering the same pixels as
+// SDL_RenderFillRect(rect)
+void write_rect_quad(SDL_Vertex* quad, const Renderer::Rect& rect, SDL_Color color);
+
+// Index pattern for `count` quads laid out as consecutive groups of 4 vertices
+void build_quad_indices(size_t count, std::vector<int>& indices);
+
+// Expand lines into 1px-wide quads (4 vertices, 6 indices each) so a whole
+// batch can be submitted with a single SDL_RenderGeometry call.
+void build_line_quads(const Renderer::Line* lines, size_t count, SDL_Color color,
+                      std::vector<SDL_Vertex>& vertices, std::vector<int>& indices);
@@ -0,0 +1,200 @@
+#include "kernels.h"
+#include "spectrum.h"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+float option(const VisualizerOptions& options, const char* name, float fallback) {
+    const auto it = options.find(name);
+    return it == options.end() ? fallback : it->second;
+}
+
+template <bool Mirror, bool LogScale>
+std::unique_ptr<VisualizerKernel> make_bar_kernel(const BarStyle& style) {
+    return std::make_unique<BarKernel<Mirror, LogScale>>(style);
+}
+
+// Specialisations indexed by [mirror][log_scale]
+using BarFactory = std::unique_ptr<VisualizerKernel> (*)(const BarStyle&);
+
+constexpr BarFactory kBarKernels[2][2] = {
+    {make_bar_kernel<false, false>, make_bar_kernel<false, true>},
+    {make_bar_kernel<true, false>, make_bar_kernel<true, true>},
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::map<std::string, VisualizerFactory> factories;
+};
+
+Registry& registry() {
+    static Registry* instance = [] {
+        auto* r = new Registry;
+        r->factories["bars"] = [](const VisualizerOptions& options) {
+            const BarStyle style = bar_style(options);
+            return kBarKernels[style.mirror][style.log_scale](style);
+        };
+        r->factories["circle"] = [](const VisualizerOptions& options) -> std::unique_ptr<VisualizerKernel> {
+            return std::make_unique<RadialKernel>(radial_style(options));
+        };
+        r->factories["waterfall"] = [](const VisualizerOptions& options) -> std::unique_ptr<VisualizerKernel> {
+            return std::make_unique<WaterfallKernel>(waterfall_style(options));
+        };
+        return r;
+    }();
+    return *instance;
+}
+
+}  // namespace
+
+void register_visualizer(const std::string& mode, VisualizerFactory factory) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.factories[mode] = std::move(factory);
+}
+
+std::unique_ptr<VisualizerKernel> make_visualizer(const std::string& mode, const VisualizerOptions& options) {
+    VisualizerFactory factory;
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        const auto it = r.factories.find(mode);
+        if (it == r.factories.end()) {
+            throw std::invalid_argument("Unknown visualizer mode '" + mode + "'");
+        }
+        factory = it->second;
+    }
+    return factory(options);
+}
+
+std::vector<std::string> visualizer_modes() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::vector<std::string> modes;
+    modes.reserve(r.factories.size());
+    for (const auto& entry : r.factories) {
+        modes.push_back(entry.first);
+    }
+    return modes;
+}
+
+BarStyle bar_style(const VisualizerOptions& options) {
+    BarStyle style;
+    style.scale = option(options, "scale", style.scale);
+    style.db_floor = option(options, "db_floor", style.db_floor);
+    style.db_ceiling = option(options, "db_ceiling", style.db_ceiling);
+    style.mirror = option(options, "mirror", style.mirror) != 0.0f;
+    style.log_scale = option(options, "log_scale", style.log_scale) != 0.0f;
+    return style;
+}
+
+RadialStyle radial_style(const VisualizerOptions& options) {
+    RadialStyle style;
+    style.scale = option(options, "scale", style.scale);
+    style.base_radius_ratio = option(options, "base_radius_ratio", style.base_radius_ratio);
+    style.mirror = option(options, "mirror", style.mirror) != 0.0f;
+    return style;
+}
+
+WaterfallStyle waterfall_style(const VisualizerOptions& options) {
+    WaterfallStyle style;
+    style.history = static_cast<int>(option(options, "history", static_cast<float>(style.history)));
+    style.db_floor = option(options, "db_floor", style.db_floor);
+    style.db_ceiling = option(options, "db_ceiling", style.db_ceiling);
+    return style;
+}
+
+void WaterfallKernel::draw(Renderer& renderer, const float* magnitudes, size_t size, SDL_Color /*color*/) {
+    renderer.draw_waterfall(magnitudes, size, style_);
+}
+
+template <bool Mirror, bool LogScale>
+BarKernel<Mirror, LogScale>::BarKernel(const BarStyle& style) : style_(style) {
+    style_.mirror = Mirror;
+    style_.log_scale = LogScale;
+}
+
+template <bool Mirror, bool LogScale>
+void BarKernel<Mirror, LogScale>::draw(Renderer& renderer, const float* magnitudes, size_t size,
+                                      SDL_Color color) {
+    build(magnitudes, size, renderer.get_width(), renderer.get_height(), style_, heights_, rects_);
+    renderer.draw_rectangles(rects_.data(), rects_.size(), color.r, color.g, color.b, color.a);
+}
+
+template <bool Mirror, bool LogScale>
+void BarKernel<Mirror, LogScale>::build(const float* magnitudes, size_t size, int width, int height,
+                                        const BarStyle& style, std::vector<float>& heights,
+                                        std::vector<Renderer::Rect>& out) {
+    out.clear();
+    if (size == 0) return;
+
+    const int count = static_cast<int>(size);
+    heights.resize(size);
+    if constexpr (LogScale) {
+        normalize_db(magnitudes, heights.data(), size, style.db_floor, style.db_ceiling);
+    } else {
+        normalize_linear_heights(magnitudes, size, heights.data());
+    }
+
+    const float gain = style.scale * height;
+    const auto bar_height = [&](int i) { return std::min(static_cast<int>(heights[i] * gain), height); };
+
+    if constexpr (Mirror) {
+        const int bar_width = std::max(1, width / (count * 2));
+        const int center_x = width / 2;
+
+        // Left bars [0, full) are whole; bar `full` is trimmed at the left
+        // edge if any of it is on screen; the rest are off-screen. Splitting
+        // the loop there keeps the clipping test out of the per-bin body.
+        const int full = std::min(count, center_x / bar_width);
+        const int trimmed = full < count ? center_x - full * bar_width : 0;
+        out.resize(size + full + (trimmed > 0));
+        Renderer::Rect* rect = out.data();
+
+        for (int i = 0; i < full; ++i) {
+            const int h = bar_height(i);
+            const int y = height - h;
+            *rect++ = {center_x + i * bar_width, y, bar_width, h};
+            *rect++ = {center_x - (i + 1) * bar_width, y, bar_width, h};
+        }
+        if (full < count) {
+            const int h = bar_height(full);
+            *rect++ = {center_x + full * bar_width, height - h, bar_width, h};
+            if (trimmed > 0) {
+                *rect++ = {0, height - h, trimmed, h};
+            }
+        }
+        for (int i = full + 1; i < count; ++i) {
+            const int h = bar_height(i);
+            *rect++ = {center_x + i * bar_width, height - h, bar_width, h};
+        }
+    } else {
+        const int bar_width = std::max(1, width / count);
+        out.resize(size);
+        Renderer::Rect* rect = out.data();
+
+        for (int i = 0; i < count; ++i) {
+            const int h = bar_height(i);
+            rect[i] = {i * bar_width, height - h, bar_width, h};
+        }
+    }
+}
+
+RadialKernel::RadialKernel(const RadialStyle& style) : style_(style) {}
+
+void RadialKernel::draw(Renderer& renderer, const float* magnitudes, size_t size, SDL_Color color) {
+    const int width = renderer.get_width();
+    const int height = renderer.get_height();
+    if (!layout_.matches(size, width, height, style_)) {
+        layout_ = RadialLayout::build(size, width, height, style_);
+    }
+    build_radial_lines(magnitudes, layout_, style_.scale, lines_);
+    renderer.draw_lines(lines_.data(), lines_.size(), color.r, color.g, color.b, color.a);
+}
+
+template class BarKernel<false, false>;
+template class BarKernel<false, true>;
+template class BarKernel<true, false>;
+template class BarKernel<true, true>;
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+
+#include "geometry.h"
+#include "waterfall.h"
+
+/**
+ * Named native visualizer modes.
+ * Bars are a kernel templated on their style switches
+ * (BarKernel<Mirror, LogScale>), so mirroring, dB or linear scaling and
+ * left-edge clipping are resolved at compile time and the per-bin loops carry
+ * no branches; the factory picks the specialisation from the option values
+ * once, when the kernel is made. RadialKernel is a plain class: mirroring only
+ * decides which lines go into the cached RadialLayout, and the per-frame loop
+ * over that layout has no branch to remove. C++ code can add modes with
+ * register_visualizer() without going through Python.
+ * "waterfall" draws the Renderer's scrolling spectrogram.
+ */
+
+// Named numeric options (bools as 0/1). Missing names take the style
+// defaults; names a mode does not use are ignored.
+using VisualizerOptions = std::map<std::string, float>;
+
+class VisualizerKernel {
+public:
+    virtual ~VisualizerKernel() = default;
+
+    // Record geometry for `size` magnitudes at the renderer's window size.
+    // Kernels may keep size-dependent state (layouts, scratch) between calls.
+    virtual void draw(Renderer& renderer, const float* magnitudes, size_t size, SDL_Color color) = 0;
+};
+
+using VisualizerFactory = std::function<std::unique_ptr<VisualizerKernel>(const VisualizerOptions&)>;
+
+// Add or replace a mode. The built-in "bars" and "circle" modes are always present.
+void register_visualizer(const std::string& mode, VisualizerFactory factory);
+
+// Throws std::invalid_argument for an unknown mode
+std::unique_ptr<VisualizerKernel> make_visualizer(const std::string& mode,
+                                                  const VisualizerOptions& options = {});
+
+// Registered mode names, sorted
+std::vector<std::string> visualizer_modes();
+
+// Styles from options, for factories of modes built on the built-in kernels
+BarStyle bar_style(const VisualizerOptions& options);
+RadialStyle radial_style(const VisualizerOptions& options);
+WaterfallStyle waterfall_style(const VisualizerOptions& options);
+
+template <bool Mirror, bool LogScale>
+class BarKernel final : public VisualizerKernel {
+public:
+    explicit BarKernel(const BarStyle& style);
+
+    void draw(Renderer& renderer, const float* magnitudes, size_t size, SDL_Color color) override;
+
+    // Same rectangles as build_bar_rects for a style with these switches.
+    // `heights` is scratch for the normalised magnitudes.
+    static void build(const float* magnitudes, size_t size, int width, int height, const BarStyle& style,
+                      std::vector<float>& heights, std::vector<Renderer::Rect>& out);
+
+private:
+    BarStyle style_;
+    std::vector<float> heights_;
+    std::vector<Renderer::Rect> rects_;
+};
+
+class RadialKernel final : public VisualizerKernel {
+public:
+    explicit RadialKernel(const RadialStyle& style);
+
+    void draw(Renderer& renderer, const float* magnitudes, size_t size, SDL_Color color) override;
+
+private:
+    RadialStyle style_;
+    RadialLayout layout_;   // Rebuilt when the bin count or window size changes
+    std::vector<Renderer::Line> lines_;
+};
+
+// Ignores the colour; the waterfall palette maps levels to colours
+class WaterfallKernel final : public VisualizerKernel {
+public:
+    explicit WaterfallKernel(const WaterfallStyle& style) : style_(style) {}
+
+    void draw(Renderer& renderer, const float* magnitudes, size_t size, SDL_Color color) override;
+
+private:
+    WaterfallStyle style_;
+};
+
+extern template class BarKernel<false, false>;
+extern template class BarKernel<false, true>;
+extern template class BarKernel<true, false>;
+extern template class BarKernel<true, true>;
@@ -0,0 +1,103 @@
+#include "mapped_file.h"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::runtime_error map_error(const std::string& path, const std::string& what) {
+    return std::runtime_error("Cannot map " + path + ": " + what);
+}
+
+}  // namespace
+
+MappedFile::MappedFile(const std::string& path, Access access) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw map_error(path, "could not be opened");
+    }
+    file_handle_ = file;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        release();
+        throw map_error(path, "could not be read");
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_ == 0) return;
+
+    map_handle_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    mapping_ = map_handle_ ? MapViewOfFile(map_handle_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!mapping_) {
+        release();
+        throw map_error(path, "mmap failed");
+    }
+    (void)access;
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        throw map_error(path, "could not be opened");
+    }
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        release();
+        throw map_error(path, "could not be read");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) return;
+
+    mapping_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        release();
+        throw map_error(path, "mmap failed");
+    }
+    ::madvise(mapping_, size_, access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+void MappedFile::release() {
+#ifdef _WIN32
+    if (mapping_) UnmapViewOfFile(mapping_);
+    if (map_handle_) CloseHandle(map_handle_);
+    if (file_handle_) CloseHandle(file_handle_);
+    map_handle_ = nullptr;
+    file_handle_ = nullptr;
+#else
+    if (mapping_) ::munmap(mapping_, size_);
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+#endif
+    mapping_ = nullptr;
+}
+
+void MappedFile::will_need(size_t offset, size_t length) const {
+#ifndef _WIN32
+    if (!mapping_ || offset >= size_ || length == 0) return;
+    length = std::min(length, size_ - offset);
+
+    // madvise needs a page-aligned start
+    const auto page = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+    const auto begin = reinterpret_cast<uintptr_t>(data() + offset);
+    const auto end = begin + length;
+    const uintptr_t aligned = begin & ~(page - 1);
+    ::madvise(reinterpret_cast<void*>(aligned), end - aligned, MADV_WILLNEED);
+#else
+    (void)offset;
+    (void)length;
+#endif
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Read-only memory mapping of a whole file.
+ * Pages are loaded by the kernel on first touch and are shared with the page
+ * cache, so mapping a large file costs neither a copy nor resident memory up
+ * front. An empty file maps to data() == nullptr and size() == 0.
+ */
+class MappedFile {
+public:
+    // Expected access pattern, passed to the kernel as a readahead hint
+    enum class Access { Random, Sequential };
+
+    // Throws std::runtime_error if the file cannot be opened or mapped
+    explicit MappedFile(const std::string& path, Access access = Access::Random);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const { return static_cast<const uint8_t*>(mapping_); }
+    size_t size() const { return size_; }
+
+    // Hint that bytes [offset, offset + length) will be read soon
+    void will_need(size_t offset, size_t length) const;
+
+private:
+    void release();
+
+    void* mapping_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* map_handle_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
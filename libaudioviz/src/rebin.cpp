@@ -0,0 +1,159 @@
+#include "rebin.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Hz -> position on the band scale
+double to_scale(BandRebinner::Scale scale, double hz) {
+    switch (scale) {
+        case BandRebinner::Scale::Log: return std::log(hz);
+        case BandRebinner::Scale::Mel: return 2595.0 * std::log10(1.0 + hz / 700.0);
+        case BandRebinner::Scale::Bark: return 26.81 * hz / (1960.0 + hz) - 0.53;  // Traunmüller
+    }
+    return hz;
+}
+
+// Position on the band scale -> Hz
+double from_scale(BandRebinner::Scale scale, double value) {
+    switch (scale) {
+        case BandRebinner::Scale::Log: return std::exp(value);
+        case BandRebinner::Scale::Mel: return 700.0 * (std::pow(10.0, value / 2595.0) - 1.0);
+        case BandRebinner::Scale::Bark: return 1960.0 * (value + 0.53) / (26.28 - value);
+    }
+    return value;
+}
+
+}  // namespace
+
+BandRebinner::BandRebinner(size_t bins, float sample_rate, size_t bands,
+                           Scale scale, float fmin, float fmax)
+    : bins_(bins), scale_(scale) {
+    if (bins < 2) {
+        throw std::invalid_argument("bins must be at least 2");
+    }
+    if (bands == 0) {
+        throw std::invalid_argument("bands must be positive");
+    }
+    if (!(sample_rate > 0.0f)) {
+        throw std::invalid_argument("sample_rate must be positive");
+    }
+    const double nyquist = sample_rate / 2.0;
+    const double hi = fmax > 0.0f ? std::min<double>(fmax, nyquist) : nyquist;
+    const double lo = fmin;
+    if (scale == Scale::Log && !(lo > 0.0)) {
+        throw std::invalid_argument("fmin must be positive on a log scale");
+    }
+    if (!(lo >= 0.0 && lo < hi)) {
+        throw std::invalid_argument("fmin must be in [0, fmax)");
+    }
+
+    // Band centres evenly spaced on the scale; the outermost filters lean on
+    // one extra virtual centre at each end
+    const double s_lo = to_scale(scale, lo);
+    const double s_hi = to_scale(scale, hi);
+    const double step = bands > 1 ? (s_hi - s_lo) / static_cast<double>(bands - 1) : s_hi - s_lo;
+    std::vector<double> positions(bands + 2);
+    for (size_t k = 0; k < bands + 2; ++k) {
+        positions[k] = s_lo + (static_cast<double>(k) - 1.0) * step;
+    }
+    if (bands == 1) {
+        positions[1] = (s_lo + s_hi) / 2.0;
+        positions[0] = s_lo;
+        positions[2] = s_hi;
+    }
+
+    const double bin_hz = nyquist / static_cast<double>(bins - 1);
+    ranges_.reserve(bands);
+    centers_.reserve(bands);
+    std::vector<float> taps;
+
+    for (size_t k = 0; k < bands; ++k) {
+        const double left = positions[k];
+        const double center = positions[k + 1];
+        const double right = positions[k + 2];
+        const double center_hz = from_scale(scale, center);
+        centers_.push_back(static_cast<float>(center_hz));
+
+        // Candidate bins span (left, right) on the scale. The bark inverse
+        // turns negative past its pole, which also means "beyond Nyquist".
+        const double left_hz = std::max(0.0, from_scale(scale, left));
+        double right_hz = from_scale(scale, right);
+        if (!(right_hz > 0.0) || right_hz > nyquist) right_hz = nyquist;
+        const size_t first = static_cast<size_t>(std::floor(left_hz / bin_hz));
+        const size_t last = std::min(bins - 1, static_cast<size_t>(std::ceil(right_hz / bin_hz)));
+
+        taps.clear();
+        size_t tap_first = 0;
+        double sum = 0.0;
+        for (size_t i = first; i <= last; ++i) {
+            const double hz = static_cast<double>(i) * bin_hz;
+            if (hz <= 0.0 && scale == Scale::Log) continue;
+            const double u = to_scale(scale, hz);
+            double w = 0.0;
+            if (u > left && u <= center) {
+                w = (u - left) / (center - left);
+            } else if (u > center && u < right) {
+                w = (right - u) / (right - center);
+            }
+            if (w <= 0.0) {
+                if (!taps.empty()) taps.push_back(0.0f);
+                continue;
+            }
+            if (taps.empty()) tap_first = i;
+            taps.push_back(static_cast<float>(w));
+            sum += w;
+        }
+        while (!taps.empty() && taps.back() == 0.0f) taps.pop_back();
+
+        if (sum <= 0.0) {
+            // Narrower than a bin: linear interpolation at the centre frequency
+            const double x = std::min(center_hz / bin_hz, static_cast<double>(bins - 1));
+            tap_first = std::min(static_cast<size_t>(x), bins - 2);
+            const double frac = x - static_cast<double>(tap_first);
+            taps.assign({static_cast<float>(1.0 - frac), static_cast<float>(frac)});
+            sum = 1.0;
+        }
+
+        ranges_.push_back(Range{static_cast<uint32_t>(tap_first), static_cast<uint32_t>(taps.size()),
+                                static_cast<uint32_t>(weights_.size())});
+        for (float w : taps) {
+            weights_.push_back(static_cast<float>(w / sum));
+        }
+    }
+}
+
+void BandRebinner::apply(const float* magnitudes, float* out, size_t channels) const {
+    const size_t band_count = bands();
+    for (size_t ch = 0; ch < channels; ++ch) {
+        const float* src = magnitudes + ch * bins_;
+        float* dst = out + ch * band_count;
+        for (size_t k = 0; k < band_count; ++k) {
+            const Range& range = ranges_[k];
+            const float* w = &weights_[range.offset];
+            const float* m = src + range.first_bin;
+            float acc = 0.0f;
+            for (uint32_t j = 0; j < range.count; ++j) {
+                acc += w[j] * m[j];
+            }
+            dst[k] = acc;
+        }
+    }
+}
+
+BandRebinner::Scale parse_band_scale(const std::string& name) {
+    if (name == "log") return BandRebinner::Scale::Log;
+    if (name == "mel") return BandRebinner::Scale::Mel;
+    if (name == "bark") return BandRebinner::Scale::Bark;
+    throw std::invalid_argument("Unknown band scale '" + name + "' (expected log, mel or bark)");
+}
+
+const char* band_scale_name(BandRebinner::Scale scale) {
+    switch (scale) {
+        case BandRebinner::Scale::Log: return "log";
+        case BandRebinner::Scale::Mel: return "mel";
+        case BandRebinner::Scale::Bark: return "bark";
+    }
+    return "log";
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Aggregates linear STFT bins into N display bands spaced on a log, mel or
+ * bark frequency scale.
+ * The weights are a sparse matrix built once: each band is a triangular
+ * filter on the chosen scale, peaking at its centre and reaching zero at its
+ * neighbours' centres, normalised to unit sum so a flat spectrum stays flat.
+ * Low bands narrower than one bin interpolate between the two nearest bins
+ * instead of coming out empty. Every band covers a contiguous bin range, so
+ * the matrix is stored as (first bin, tap count) per band plus one weight run,
+ * and apply() costs one multiply-add per stored tap: at most two per bin plus
+ * two per band, independent of how the bands are laid out.
+ */
+class BandRebinner {
+public:
+    enum class Scale { Log, Mel, Bark };
+
+    // `bins` is nperseg / 2 + 1. fmax <= 0 means Nyquist.
+    BandRebinner(size_t bins, float sample_rate, size_t bands,
+                 Scale scale = Scale::Log, float fmin = 20.0f, float fmax = 0.0f);
+
+    size_t bins() const { return bins_; }
+    size_t bands() const { return ranges_.size(); }
+    Scale scale() const { return scale_; }
+    size_t taps() const { return weights_.size(); }
+
+    // Centre frequency of each band in Hz
+    const std::vector<float>& center_frequencies() const { return centers_; }
+
+    // `channels` rows of bins() magnitudes -> `channels` rows of bands() values
+    void apply(const float* magnitudes, float* out, size_t channels = 1) const;
+
+private:
+    struct Range {
+        uint32_t first_bin;
+        uint32_t count;
+        uint32_t offset;   // Into weights_
+    };
+
+    size_t bins_;
+    Scale scale_;
+    std::vector<Range> ranges_;
+    std::vector<float> weights_;
+    std::vector<float> centers_;
+};
+
+// "log", "mel" or "bark"; throws std::invalid_argument otherwise
+BandRebinner::Scale parse_band_scale(const std::string& name);
+const char* band_scale_name(BandRebinner::Scale scale);
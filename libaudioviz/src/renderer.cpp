@@ -1,128 +1,583 @@
 #include "renderer.h"
+#include "geometry.h"
+#include "display_list.h"
+#include "command_buffer.h"
+#include "waterfall.h"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+static_assert(sizeof(Renderer::Rect) == sizeof(SDL_Rect) &&
+              offsetof(Renderer::Rect, x) == offsetof(SDL_Rect, x) &&
+              offsetof(Renderer::Rect, y) == offsetof(SDL_Rect, y) &&
+              offsetof(Renderer::Rect, w) == offsetof(SDL_Rect, w) &&
+              offsetof(Renderer::Rect, h) == offsetof(SDL_Rect, h),
+              "Renderer::Rect must match the SDL_Rect layout");
+static_assert(std::is_standard_layout<Renderer::Rect>::value, "Renderer::Rect must be standard layout");
+
+namespace {
+
+// Every live Renderer, so one poll can route SDL's single event queue to the
+// window each event belongs to. Also guards every Renderer's inbox.
+std::mutex g_registry_mutex;
+std::vector<Renderer*> g_renderers;
+
+// Events kept for a Renderer between its polls; one that never polls (say,
+// a headless exporter next to live windows) must not grow without bound
+constexpr size_t kMaxInbox = 1024;
+
+// Window an event is addressed to; 0 for application-wide events
+Uint32 event_window(const SDL_Event& e) {
+    switch (e.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        return e.key.windowID;
+    case SDL_TEXTEDITING:
+        return e.edit.windowID;
+    case SDL_TEXTINPUT:
+        return e.text.windowID;
+    case SDL_MOUSEMOTION:
+        return e.motion.windowID;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        return e.button.windowID;
+    case SDL_MOUSEWHEEL:
+        return e.wheel.windowID;
+    case SDL_WINDOWEVENT:
+        return e.window.windowID;
+    default:
+        return 0;
+    }
+}
+
+}  // namespace
 
 Renderer::Renderer(int width, int height) : width_(width), height_(height) {
+    for (auto& buffer : buffers_) {
+        buffer = std::make_unique<FrameCommandBuffer>();
+    }
+    recording().reset(width_, height_);
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        g_renderers.push_back(this);
+    }
     std::cout << "Renderer created (" << width << "x" << height << ")" << std::endl;
 }
 
 Renderer::~Renderer() {
+    if (render_thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(frame_mutex_);
+            stop_ = true;
+        }
+        frame_cv_.notify_all();
+        render_thread_.join();
+    }
+    waterfall_.reset();
     if (renderer_) {
         SDL_DestroyRenderer(renderer_);
     }
+    if (surface_) {
+        SDL_FreeSurface(surface_);
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        g_renderers.erase(std::find(g_renderers.begin(), g_renderers.end(), this));
+    }
     if (window_) {
         SDL_DestroyWindow(window_);
+        quit_video();
     }
-    SDL_Quit();
     std::cout << "Renderer destroyed" << std::endl;
 }
 
-void Renderer::initialize_window() {
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+void Renderer::quit_video() {
+    // The video subsystem is reference counted across windows; SDL itself
+    // goes once nothing else is initialised
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    if (SDL_WasInit(SDL_INIT_EVERYTHING) == 0) {
+        SDL_Quit();
+    }
+}
+
+void Renderer::initialize_window(bool threaded, int display) {
+    if (window_ || surface_) {
+        throw std::runtime_error("Renderer is already initialized");
+    }
+    if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
         throw std::runtime_error("SDL could not initialize! SDL_Error: " + std::string(SDL_GetError()));
     }
 
     window_ = SDL_CreateWindow(
         "AudioViz Renderer",
-        SDL_WINDOWPOS_UNDEFINED,
-        SDL_WINDOWPOS_UNDEFINED,
+        SDL_WINDOWPOS_UNDEFINED_DISPLAY(display),
+        SDL_WINDOWPOS_UNDEFINED_DISPLAY(display),
         width_,
         height_,
         SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE
     );
 
     if (!window_) {
-        SDL_Quit();
-        throw std::runtime_error("Window could not be created! SDL_Error: " + std::string(SDL_GetError()));
+        const std::string error = SDL_GetError();
+        quit_video();
+        throw std::runtime_error("Window could not be created! SDL_Error: " + error);
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        window_id_ = SDL_GetWindowID(window_);
+    }
+
+    // Late frames are counted against the display refresh
+    SDL_DisplayMode mode;
+    const bool has_mode = SDL_GetWindowDisplayMode(window_, &mode) == 0 && mode.refresh_rate > 0;
+    stats_.set_target_fps(has_mode ? mode.refresh_rate : 60.0);
+
+    if (!threaded) {
+        renderer_ = create_sdl_renderer();
+        std::cout << "Window initialized" << std::endl;
+        return;
+    }
+
+    // The SDL renderer must be created on the thread that draws with it;
+    // wait for it so creation errors still surface here
+    std::promise<void> ready;
+    std::future<void> started = ready.get_future();
+    threaded_ = true;
+    render_thread_ = std::thread([this, &ready] {
+        try {
+            renderer_ = create_sdl_renderer();
+        } catch (...) {
+            ready.set_exception(std::current_exception());
+            return;
+        }
+        ready.set_value();
+        render_loop();
+    });
+
+    try {
+        started.get();
+    } catch (...) {
+        render_thread_.join();
+        threaded_ = false;
+        throw;
     }
+    std::cout << "Window initialized (render thread)" << std::endl;
+}
 
-    renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+void Renderer::initialize_headless() {
+    if (window_ || surface_) {
+        throw std::runtime_error("Renderer is already initialized");
+    }
+    // The software renderer draws straight into the surface, so no video
+    // subsystem (and no display) is required
+    surface_ = SDL_CreateRGBSurfaceWithFormat(0, width_, height_, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface_) {
+        throw std::runtime_error("Surface could not be created! SDL_Error: " + std::string(SDL_GetError()));
+    }
 
+    renderer_ = SDL_CreateSoftwareRenderer(surface_);
     if (!renderer_) {
+        SDL_FreeSurface(surface_);
+        surface_ = nullptr;
+        throw std::runtime_error("Renderer could not be created! SDL_Error: " + std::string(SDL_GetError()));
+    }
+    read_texture_limits(renderer_);
+
+    logical_width_ = width_;
+    logical_height_ = height_;
+    std::cout << "Headless renderer initialized" << std::endl;
+}
+
+void Renderer::read_pixels(uint8_t* out) const {
+    if (!surface_) {
+        throw std::runtime_error("read_pixels requires a headless renderer");
+    }
+
+    // Surface rows may be padded; the output is tightly packed
+    const size_t row_bytes = static_cast<size_t>(surface_->w) * 4;
+    const auto* src = static_cast<const uint8_t*>(surface_->pixels);
+    for (int y = 0; y < surface_->h; ++y) {
+        std::memcpy(out + y * row_bytes, src + static_cast<size_t>(y) * surface_->pitch, row_bytes);
+    }
+}
+
+SDL_Renderer* Renderer::create_sdl_renderer() {
+    SDL_Renderer* renderer = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+
+    if (!renderer) {
+        const std::string error = SDL_GetError();
+        {
+            std::lock_guard<std::mutex> lock(g_registry_mutex);
+            window_id_ = 0;
+        }
         SDL_DestroyWindow(window_);
-        SDL_Quit();
         window_ = nullptr;
-        throw std::runtime_error("Renderer could not be created! SDL_Error: " + std::string(SDL_GetError()));
+        quit_video();
+        throw std::runtime_error("Renderer could not be created! SDL_Error: " + error);
     }
     
     // Ensure logical size matches window size initially
-    SDL_RenderSetLogicalSize(renderer_, width_, height_);
+    SDL_RenderSetLogicalSize(renderer, width_, height_);
+    logical_width_ = width_;
+    logical_height_ = height_;
+    read_texture_limits(renderer);
+    return renderer;
+}
 
-    std::cout << "Window initialized" << std::endl;
+void Renderer::read_texture_limits(SDL_Renderer* renderer) {
+    // 0 means no limit (e.g. the software renderer)
+    SDL_RendererInfo info{};
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        max_texture_width_ = info.max_texture_width;
+        max_texture_height_ = info.max_texture_height;
+    }
 }
 
-void Renderer::clear(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+void Renderer::render_loop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(frame_mutex_);
+            frame_cv_.wait(lock, [this] { return has_pending_ || stop_; });
+            if (!has_pending_) break;  // Stopping with nothing left to draw
+            std::swap(front_, pending_);
+            has_pending_ = false;
+        }
+        // The pending slot is free again; unblock a waiting present()
+        frame_cv_.notify_all();
+        try {
+            execute(*buffers_[front_]);
+        } catch (...) {
+            keep_render_error(std::current_exception());
+        }
+    }
+
+    waterfall_.reset();
+    SDL_DestroyRenderer(renderer_);
+    renderer_ = nullptr;
+}
+
+void Renderer::set_skip_unchanged(bool enabled, float tolerance_px) {
+    if (tolerance_px < 0.0f) {
+        throw std::invalid_argument("tolerance_px must not be negative");
+    }
+    skip_tolerance_px_.store(tolerance_px, std::memory_order_relaxed);
+    skip_unchanged_.store(enabled, std::memory_order_relaxed);
+    invalidate();
+}
+
+void Renderer::execute(const FrameCommandBuffer& frame) {
     if (!renderer_) return;
-    SDL_SetRenderDrawColor(renderer_, r, g, b, a);
-    SDL_RenderClear(renderer_);
+
+    // The previous image is still on screen; present nothing and sleep
+    // through the refresh a swap would have blocked for
+    const bool skipping = skip_unchanged_.load(std::memory_order_relaxed);
+    if (skipping && retained_valid_.load(std::memory_order_relaxed) &&
+        frame.same_image(*retained_, skip_tolerance_px_.load(std::memory_order_relaxed))) {
+        stats_.frame_unchanged();
+        const double fps = stats_.target_fps();
+        if (fps > 0.0) {
+            const auto interval =
+                std::chrono::duration_cast<FrameStats::Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+            const auto next = last_swap_ + interval;
+            std::this_thread::sleep_until(next);
+            // Keep the refresh phase unless the last swap is long gone
+            const auto now = FrameStats::Clock::now();
+            last_swap_ = now - next < interval ? next : now;
+        }
+        return;
+    }
+
+    if (frame.width() != logical_width_ || frame.height() != logical_height_) {
+        SDL_RenderSetLogicalSize(renderer_, frame.width(), frame.height());
+        logical_width_ = frame.width();
+        logical_height_ = frame.height();
+    }
+
+    const auto& rects = frame.rect_data();
+    const auto& vertices = frame.vertex_data();
+    const auto& indices = frame.index_data();
+
+    for (const auto& cmd : frame.commands()) {
+        switch (cmd.type) {
+        case FrameCommandBuffer::CommandType::Clear:
+            SDL_SetRenderDrawColor(renderer_, cmd.color.r, cmd.color.g, cmd.color.b, cmd.color.a);
+            SDL_RenderClear(renderer_);
+            break;
+        case FrameCommandBuffer::CommandType::Rects:
+            // One command for the whole batch; Rect is layout-compatible with SDL_Rect
+            SDL_SetRenderDrawColor(renderer_, cmd.color.r, cmd.color.g, cmd.color.b, cmd.color.a);
+            SDL_RenderFillRects(renderer_, reinterpret_cast<const SDL_Rect*>(rects.data() + cmd.offset),
+                                static_cast<int>(cmd.count));
+            break;
+        case FrameCommandBuffer::CommandType::Geometry:
+            SDL_RenderGeometry(renderer_, nullptr,
+                               vertices.data() + cmd.vertex_offset, static_cast<int>(cmd.vertex_count),
+                               indices.data() + cmd.offset, static_cast<int>(cmd.count));
+            break;
+        case FrameCommandBuffer::CommandType::Waterfall:
+            if (!waterfall_) {
+                waterfall_ = std::make_unique<WaterfallTexture>();
+            }
+            waterfall_->push(renderer_, frame.pixel_data().data() + cmd.offset,
+                             static_cast<int>(cmd.count), cmd.history);
+            waterfall_->draw(renderer_, SDL_Rect{0, 0, frame.width(), frame.height()});
+            break;
+        }
+    }
+
+    {
+        ScopedStageTimer timer(stats_, FrameStats::Stage::Vsync);
+        SDL_RenderPresent(renderer_);
+    }
+    last_swap_ = FrameStats::Clock::now();
+
+    if (skipping) {
+        if (!retained_) {
+            retained_ = std::make_unique<FrameCommandBuffer>();
+        }
+        retained_->retain(frame);
+        retained_valid_.store(true, std::memory_order_relaxed);
+    }
+
+    // Mic to photon, as far as the swap returning can tell
+    if (frame.capture_time() != FrameStats::Clock::time_point{}) {
+        stats_.record(FrameStats::Stage::Latency, FrameStats::Clock::now() - frame.capture_time());
+    }
+}
+
+void Renderer::clear(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Clear);
+    recording().clear(SDL_Color{r, g, b, a});
+}
+
+void Renderer::set_capture_time(FrameStats::Clock::time_point captured) {
+    recording().set_capture_time(captured);
 }
 
 void Renderer::present() {
-    if (!renderer_) return;
-    SDL_RenderPresent(renderer_);
+    {
+        ScopedStageTimer timer(stats_, FrameStats::Stage::Present);
+        submit();
+    }
+    stats_.frame_presented(FrameStats::Clock::now());
+    end_frame();
+
+    // A replay failure surfaces on the caller's thread, once the frame has
+    // been torn down so the next one starts clean
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(frame_mutex_);
+        std::swap(error, render_error_);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void Renderer::keep_render_error(std::exception_ptr error) {
+    // The waterfall texture may be what failed; rebuild it on the next frame
+    waterfall_.reset();
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+    if (!render_error_) {
+        render_error_ = error;
+    }
+}
+
+void Renderer::submit() {
+    recording().set_size(width_, height_);
+
+    if (!threaded_) {
+        try {
+            execute(recording());
+        } catch (...) {
+            keep_render_error(std::current_exception());
+        }
+    } else {
+        // Hand the recorded frame over; only waits if the previous one has
+        // not been picked up yet (i.e. the render thread is a frame behind)
+        {
+            std::unique_lock<std::mutex> lock(frame_mutex_);
+            frame_cv_.wait(lock, [this] { return !has_pending_; });
+            std::swap(back_, pending_);
+            has_pending_ = true;
+        }
+        frame_cv_.notify_all();
+    }
+    recording().reset(width_, height_);
+}
+
+void Renderer::end_frame() {
+    // Input latency: from each event polled this frame until it was presented
+    const uint32_t now = SDL_GetTicks();
+    for (const auto& event : events_) {
+        stats_.record(FrameStats::Stage::Input, std::chrono::milliseconds(now - event.timestamp));
+    }
+
+    // Everything transient from this frame goes at once
+    ArenaVector<Event>(ArenaAllocator<Event>(arena_)).swap(events_);
+    arena_.reset();
+}
+
+size_t Renderer::heap_allocations() const {
+    size_t total = arena_.heap_allocations() + scratch_allocations_;
+    for (const auto& buffer : buffers_) {
+        total += buffer->heap_allocations();
+    }
+    return total;
 }
 
 void Renderer::draw_rectangles(const std::vector<Renderer::Rect>& rects,
                                 uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-    if (!renderer_) return;
-    SDL_SetRenderDrawColor(renderer_, r, g, b, a);
-    
-    for (const auto& rect : rects) {
-        SDL_Rect sdl_rect = {
-            rect.x,
-            rect.y,
-            rect.w,
-            rect.h
-        };
-        SDL_RenderFillRect(renderer_, &sdl_rect);
-    }
+    draw_rectangles(rects.data(), rects.size(), r, g, b, a);
+}
+
+void Renderer::draw_rectangles(const Renderer::Rect* rects, size_t count,
+                                uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Draw);
+    recording().rects(rects, count, SDL_Color{r, g, b, a});
 }
 
 void Renderer::draw_lines(const std::vector<Renderer::Line>& lines,
                           uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-    if (!renderer_) return;
-    SDL_SetRenderDrawColor(renderer_, r, g, b, a);
-    
-    for (const auto& line : lines) {
-        SDL_RenderDrawLine(
-            renderer_,
-            line.x1,
-            line.y1,
-            line.x2,
-            line.y2
-        );
+    draw_lines(lines.data(), lines.size(), r, g, b, a);
+}
+
+void Renderer::draw_lines(const Renderer::Line* lines, size_t count,
+                          uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    // SDL_RenderDrawLines only draws connected polylines, so the buffer
+    // expands independent segments to thin quads for one geometry batch
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Draw);
+    recording().lines(lines, count, SDL_Color{r, g, b, a});
+}
+
+void Renderer::draw_colored_rectangles(const Renderer::Rect* rects, const SDL_Color* colors, size_t count) {
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Draw);
+    recording().colored_rects(rects, colors, count);
+}
+
+void Renderer::draw_colored_lines(const Renderer::Line* lines, const SDL_Color* colors, size_t count) {
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Draw);
+    recording().colored_lines(lines, colors, count);
+}
+
+void Renderer::draw_bars(const float* magnitudes, size_t size, const BarStyle& style,
+                         uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Draw);
+    const size_t capacity = rect_scratch_.capacity();
+    build_bar_rects(magnitudes, size, width_, height_, style, rect_scratch_);
+    scratch_allocations_ += rect_scratch_.capacity() != capacity;
+    recording().rects(rect_scratch_.data(), rect_scratch_.size(), SDL_Color{r, g, b, a});
+}
+
+void Renderer::draw_peak_markers(const float* peaks, size_t size, const BarStyle& style, int thickness,
+                                 uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Draw);
+    const size_t capacity = rect_scratch_.capacity();
+    build_peak_markers(peaks, size, width_, height_, style, thickness, rect_scratch_);
+    scratch_allocations_ += rect_scratch_.capacity() != capacity;
+    recording().rects(rect_scratch_.data(), rect_scratch_.size(), SDL_Color{r, g, b, a});
+}
+
+void Renderer::draw_radial(const float* magnitudes, size_t size, const RadialStyle& style,
+                           uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Draw);
+    if (!radial_layout_ || !radial_layout_->matches(size, width_, height_, style)) {
+        radial_layout_ = std::make_unique<RadialLayout>(RadialLayout::build(size, width_, height_, style));
     }
+    const size_t capacity = line_scratch_.capacity();
+    build_radial_lines(magnitudes, *radial_layout_, style.scale, line_scratch_);
+    scratch_allocations_ += line_scratch_.capacity() != capacity;
+    recording().lines(line_scratch_.data(), line_scratch_.size(), SDL_Color{r, g, b, a});
 }
 
-std::vector<std::tuple<std::string, int, int>> Renderer::poll_events() {
-    std::vector<std::tuple<std::string, int, int>> events;
+void Renderer::draw_waterfall(const float* magnitudes, size_t size, const WaterfallStyle& style) {
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Draw);
+    validate_waterfall_style(style);
+    // The texture is created where the SDL renderer lives (the render thread
+    // when threaded), so its limits are checked here, on the caller's thread
+    if (max_texture_width_ > 0 && style.history > max_texture_width_) {
+        throw std::invalid_argument("Waterfall history " + std::to_string(style.history) +
+                                    " exceeds the maximum texture width " + std::to_string(max_texture_width_));
+    }
+    if (max_texture_height_ > 0 && size > static_cast<size_t>(max_texture_height_)) {
+        throw std::invalid_argument("Waterfall of " + std::to_string(size) +
+                                    " bins exceeds the maximum texture height " + std::to_string(max_texture_height_));
+    }
+    if (size == 0) return;
+    const size_t capacity = waterfall_heights_.capacity();
+    waterfall_heights_.resize(size);
+    scratch_allocations_ += waterfall_heights_.capacity() != capacity;
+    waterfall_column(magnitudes, size, style, waterfall_heights_.data(), recording().waterfall(size, style.history));
+}
+
+void Renderer::draw_display_list(const DisplayList& list) {
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Draw);
+    recording().geometry(list.vertices().data(), list.vertices().size(),
+                         list.indices().data(), list.indices().size());
+}
+
+static Renderer::Event make_event(Renderer::EventType type, int32_t data1, int32_t data2, uint32_t timestamp) {
+    return Renderer::Event{static_cast<int32_t>(type), data1, data2, timestamp};
+}
+
+void Renderer::route_events() {
     SDL_Event e;
-    
     while (SDL_PollEvent(&e) != 0) {
-        if (e.type == SDL_QUIT) {
+        const Uint32 window = event_window(e);
+        for (Renderer* renderer : g_renderers) {
+            if ((window == 0 || renderer->window_id_ == window) && renderer->inbox_.size() < kMaxInbox) {
+                renderer->inbox_.push_back(e);
+            }
+        }
+    }
+}
+
+const ArenaVector<Renderer::Event>& Renderer::poll_events() {
+    ScopedStageTimer timer(stats_, FrameStats::Stage::Events);
+    events_.clear();
+
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    route_events();
+
+    for (const SDL_Event& e : inbox_) {
+        const bool close = e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_CLOSE;
+        if (e.type == SDL_QUIT || close) {
+            // Closing a window quits its Renderer; SDL_QUIT follows the last one
+            if (!should_quit_) {
+                events_.push_back(make_event(EventType::Quit, 0, 0, e.common.timestamp));
+            }
             should_quit_ = true;
-            events.push_back({"quit", 0, 0});
         }
         else if (e.type == SDL_KEYDOWN) {
-            events.push_back({"keydown", e.key.keysym.sym, 0});
+            events_.push_back(make_event(EventType::KeyDown, e.key.keysym.sym, 0, e.common.timestamp));
         }
         else if (e.type == SDL_MOUSEBUTTONDOWN) {
-            events.push_back({"mousedown", e.button.button, 0});
+            events_.push_back(make_event(EventType::MouseDown, e.button.button, 0, e.common.timestamp));
         }
         else if (e.type == SDL_KEYUP) {
-            events.push_back({"keyup", e.key.keysym.sym, 0});
+            events_.push_back(make_event(EventType::KeyUp, e.key.keysym.sym, 0, e.common.timestamp));
         }
         else if (e.type == SDL_WINDOWEVENT) {
+            // Whatever was on screen may be gone; the next frame must be replayed
+            if (e.window.event == SDL_WINDOWEVENT_EXPOSED || e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED ||
+                e.window.event == SDL_WINDOWEVENT_RESTORED) {
+                invalidate();
+            }
             if (e.window.event == SDL_WINDOWEVENT_RESIZED) {
+                // The new logical size is applied when the next frame is replayed
                 width_ = e.window.data1;
                 height_ = e.window.data2;
-                if (renderer_) {
-                     SDL_RenderSetLogicalSize(renderer_, width_, height_);
-                }
-                events.push_back({"resize", width_, height_});
+                events_.push_back(make_event(EventType::Resize, width_, height_, e.common.timestamp));
             }
         }
     }
-    
-    return events;
+    inbox_.clear();
+
+    return events_;
 }
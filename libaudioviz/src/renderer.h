@@ -1,16 +1,44 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
-#include <tuple>
-#include <string>
 #include <SDL2/SDL.h>
 
+#include "arena.h"
+#include "frame_stats.h"
+
+struct BarStyle;
+struct RadialStyle;
+struct RadialLayout;
+struct WaterfallStyle;
+class WaterfallTexture;
+class DisplayList;
+class FrameCommandBuffer;
+
 /**
  * Low-level renderer that provides primitive drawing operations.
  * This class knows nothing about visualization modes - it only draws
  * what it's told to draw by the Python layer.
+ *
+ * Draw calls record into a frame command buffer; present() replays it.
+ * In threaded mode the replay (and the vsync wait) happens on a dedicated
+ * render thread fed through three rotating buffers, so present() only
+ * blocks when the render thread is a full frame behind.
+ *
+ * Several Renderers can be live at once, each with its own window. SDL has
+ * one event queue per process, so poll_events() on any of them drains it
+ * and routes each event to the window it belongs to; application-wide
+ * events (and events for no window) go to every Renderer. SDL stays
+ * initialised until the last window is gone.
  */
 class Renderer {
 public:
+    // Layout-compatible with SDL_Rect so batches are submitted without conversion
     struct Rect {
         int x, y, w, h;
     };
@@ -19,17 +47,43 @@ public:
         int x1, y1, x2, y2;
     };
 
+    enum class EventType : int32_t {
+        Quit = 0,
+        KeyDown = 1,    // data1: SDL keycode
+        KeyUp = 2,      // data1: SDL keycode
+        MouseDown = 3,  // data1: SDL mouse button
+        Resize = 4,     // data1, data2: new width and height
+    };
+
+    // Plain record so event lists can be handed to NumPy as one block
+    struct Event {
+        int32_t type;        // EventType
+        int32_t data1;
+        int32_t data2;
+        uint32_t timestamp;  // SDL ticks (ms) when the event was queued
+    };
+
     Renderer(int width, int height);
     ~Renderer();
 
-    // Window management
-    void initialize_window();
+    // Window management. With `threaded`, SDL rendering runs on its own thread.
+    // `display` picks the monitor the window opens on.
+    void initialize_window(bool threaded = false, int display = 0);
+    bool is_threaded() const { return threaded_; }
+
+    // Offscreen rendering into a software surface; needs no display
+    void initialize_headless();
+    bool is_headless() const { return surface_ != nullptr; }
+
+    // Copy the last presented headless frame as tightly packed RGBA rows
+    // (width * height * 4 bytes)
+    void read_pixels(uint8_t* out) const;
     int get_width() const { return width_; }
     int get_height() const { return height_; }
 
     // Frame operations
     void clear(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
-    void present();
+    void present();  // Rethrows an error raised while replaying a frame
 
     // Primitive drawing - batched for efficiency
     void draw_rectangles(const std::vector<Rect>& rects,
@@ -38,15 +92,143 @@ public:
     void draw_lines(const std::vector<Line>& lines,
                     uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 
-    // Event handling
-    std::vector<std::tuple<std::string, int, int>> poll_events();
+    // Pointer-based variants used by the NumPy buffer bindings (no copy)
+    void draw_rectangles(const Rect* rects, size_t count,
+                         uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+    void draw_lines(const Line* lines, size_t count,
+                    uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+    // Per-primitive colours (`colors` has `count` entries). Consecutive
+    // coloured and line batches are submitted as one SDL_RenderGeometry call,
+    // so a frame with many colours costs no more calls than one colour.
+    void draw_colored_rectangles(const Rect* rects, const SDL_Color* colors, size_t count);
+
+    void draw_colored_lines(const Line* lines, const SDL_Color* colors, size_t count);
+
+    // Native visualizer kernels - geometry is built from magnitudes in one pass
+    void draw_bars(const float* magnitudes, size_t size, const BarStyle& style,
+                   uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+    void draw_radial(const float* magnitudes, size_t size, const RadialStyle& style,
+                     uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+    // Peak-hold markers on top of draw_bars bars of the same style
+    void draw_peak_markers(const float* peaks, size_t size, const BarStyle& style, int thickness,
+                           uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+    // Scrolling spectrogram: appends one column per call to a texture ring
+    // and draws the history across the window. Throws std::invalid_argument
+    // for an invalid style or one larger than the renderer's textures allow.
+    void draw_waterfall(const float* magnitudes, size_t size, const WaterfallStyle& style);
+
+    // Retained geometry - submitted with a single SDL_RenderGeometry call
+    void draw_display_list(const DisplayList& list);
+
+    // Event handling. The list lives in the frame arena and is valid until
+    // the next poll_events() or present(). Events polled before a present()
+    // feed the input-to-present latency stage.
+    const ArenaVector<Event>& poll_events();
+    static uint32_t ticks_ms() { return SDL_GetTicks(); }
     bool should_quit() const { return should_quit_; }
+    uint32_t window_id() const { return window_id_; }   // 0 when there is no window
+
+    // Frame-time instrumentation. The target defaults to the display refresh.
+    FrameStats::Summary get_stats() const { return stats_.summary(); }
+    void reset_stats() { stats_.reset(); }
+    void set_target_fps(double fps) { stats_.set_target_fps(fps); }
+    double last_frame_ms() const { return stats_.last_frame_ms(); }
+
+    // Skip replaying and presenting frames that would draw the image already
+    // on screen, with every rect edge and vertex within `tolerance_px` pixels.
+    // A skipped present waits out the refresh interval instead, so callers
+    // stay paced as if it had swapped. Off by default.
+    void set_skip_unchanged(bool enabled, float tolerance_px = 0.0f);
+    bool skip_unchanged() const { return skip_unchanged_.load(std::memory_order_relaxed); }
+
+    // Replay the next frame even if it matches (e.g. after an expose)
+    void invalidate() { retained_valid_.store(false, std::memory_order_relaxed); }
+
+    // When the newest audio the frame being recorded shows was captured
+    // (e.g. AudioCapture::captured_at); its swap records the latency stage
+    void set_capture_time(FrameStats::Clock::time_point captured);
+
+    // Scratch memory for the current frame, rewound by present()
+    FrameArena& frame_arena() { return arena_; }
+
+    // Heap allocations made by frame recording so far (arena blocks and
+    // command/scratch storage growth); flat in steady state
+    size_t heap_allocations() const;
 
 private:
+    SDL_Renderer* create_sdl_renderer();
+    void read_texture_limits(SDL_Renderer* renderer);
+    void render_loop();
+    void submit();
+    void end_frame();
+    void execute(const FrameCommandBuffer& frame);
+    void keep_render_error(std::exception_ptr error);
+    FrameCommandBuffer& recording() { return *buffers_[back_]; }
+    void quit_video();
+
+    // Drain SDL's queue into the inbox of every registered Renderer the
+    // events are addressed to. Caller holds the registry lock.
+    static void route_events();
+
     int width_;
     int height_;
     bool should_quit_ = false;
+    uint32_t window_id_ = 0;
+    std::vector<SDL_Event> inbox_;   // Routed but not yet polled; guarded by the registry lock
 
     SDL_Window* window_ = nullptr;
     SDL_Renderer* renderer_ = nullptr;
+    SDL_Surface* surface_ = nullptr;
+    int logical_width_ = 0;
+    int logical_height_ = 0;
+    // Texture limits of the SDL renderer, read when it is created; 0 is unlimited
+    int max_texture_width_ = 0;
+    int max_texture_height_ = 0;
+
+    // Scratch geometry reused across frames by the native kernels
+    std::vector<Rect> rect_scratch_;
+    std::vector<Line> line_scratch_;
+    std::unique_ptr<RadialLayout> radial_layout_;  // Rebuilt on resize or bin-count change
+    std::vector<float> waterfall_heights_;
+
+    // Waterfall ring; only touched where the SDL renderer lives (execute())
+    std::unique_ptr<WaterfallTexture> waterfall_;
+
+    // Last replayed frame, for skipping unchanged ones. Only touched where
+    // frames are replayed (execute()); the flags may be set from the caller.
+    std::unique_ptr<FrameCommandBuffer> retained_;
+    std::atomic<bool> retained_valid_{false};
+    std::atomic<bool> skip_unchanged_{false};
+    std::atomic<float> skip_tolerance_px_{0.0f};
+    FrameStats::Clock::time_point last_swap_{};
+
+    // Frame command buffers: back is recorded by the caller, pending waits
+    // for the render thread, front is being replayed. Immediate mode only
+    // uses back.
+    std::array<std::unique_ptr<FrameCommandBuffer>, 3> buffers_;
+    size_t back_ = 0;
+    size_t pending_ = 1;
+    size_t front_ = 2;
+
+    FrameStats stats_;
+
+    // Per-frame transient data (events, converted primitive lists)
+    FrameArena arena_;
+    ArenaVector<Event> events_{ArenaAllocator<Event>(arena_)};
+    size_t scratch_allocations_ = 0;
+
+    // Render thread hand-off
+    bool threaded_ = false;
+    bool has_pending_ = false;
+    bool stop_ = false;
+    std::thread render_thread_;
+    std::mutex frame_mutex_;
+    std::condition_variable frame_cv_;
+    // First error thrown while replaying a frame, rethrown by present()
+    std::exception_ptr render_error_;
 };
\ No newline at end of file
@@ -0,0 +1,148 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Lock-free single-producer / single-consumer ring buffer.
+ * One thread may call write(), one other thread may call read(); both are
+ * wait-free (bounded work, no locks, no allocation), so the producer can be a
+ * real-time audio callback. Capacity is rounded up to a power of two.
+ */
+template <typename T>
+class SpscRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRingBuffer needs trivially copyable elements");
+
+public:
+    explicit SpscRingBuffer(size_t capacity) {
+        size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        buffer_.resize(rounded);
+        mask_ = rounded - 1;
+    }
+
+    size_t capacity() const { return buffer_.size(); }
+
+    // Elements the consumer can read right now
+    size_t read_available() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed);
+    }
+
+    // Free slots the producer can write right now
+    size_t write_available() const {
+        return capacity() - (head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_acquire));
+    }
+
+    // Producer: copy up to `count` elements in, returns how many fit
+    size_t write(const T* data, size_t count) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t n = std::min(count, capacity() - (head - tail));
+        copy_in(head, data, n);
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer: copy up to `count` elements out, returns how many were read
+    size_t read(T* data, size_t count) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t n = std::min(count, head - tail);
+        copy_out(tail, data, n);
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer: discard up to `count` elements, returns how many were dropped
+    size_t skip(size_t count) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t n = std::min(count, head - tail);
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+private:
+    // Indices grow monotonically and are masked on access; unsigned wrap is fine
+    void copy_in(size_t index, const T* data, size_t n) {
+        const size_t start = index & mask_;
+        const size_t first = std::min(n, capacity() - start);
+        std::memcpy(&buffer_[start], data, first * sizeof(T));
+        std::memcpy(&buffer_[0], data + first, (n - first) * sizeof(T));
+    }
+
+    void copy_out(size_t index, T* data, size_t n) const {
+        const size_t start = index & mask_;
+        const size_t first = std::min(n, capacity() - start);
+        std::memcpy(data, &buffer_[start], first * sizeof(T));
+        std::memcpy(data + first, &buffer_[0], (n - first) * sizeof(T));
+    }
+
+    std::vector<T> buffer_;
+    size_t mask_ = 0;
+
+    // Producer and consumer indices live on separate cache lines
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+/**
+ * Multichannel float sample FIFO on top of SpscRingBuffer.
+ * Counts are in sample frames (one sample per channel, interleaved). Writes
+ * that do not fit are dropped and counted rather than blocking the producer.
+ * Throws std::invalid_argument unless capacity_frames and channels are positive.
+ */
+class SampleRing {
+public:
+    SampleRing(size_t capacity_frames, size_t channels)
+        : channels_(checked_channels(capacity_frames, channels)), ring_(capacity_frames * channels) {}
+
+    size_t channels() const { return channels_; }
+    size_t capacity() const { return ring_.capacity() / channels_; }
+    size_t available() const { return ring_.read_available() / channels_; }
+
+    // Producer side
+    size_t push(const float* samples, size_t frames) {
+        const size_t free_frames = ring_.write_available() / channels_;
+        const size_t n = std::min(frames, free_frames);
+        ring_.write(samples, n * channels_);
+        written_.fetch_add(n, std::memory_order_release);
+        if (n < frames) {
+            dropped_.fetch_add(frames - n, std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    // Consumer side
+    size_t pop(float* out, size_t max_frames) {
+        const size_t n = std::min(max_frames, available());
+        ring_.read(out, n * channels_);
+        return n;
+    }
+
+    size_t skip(size_t frames) {
+        return ring_.skip(std::min(frames, available()) * channels_) / channels_;
+    }
+
+    // Frames accepted since construction (the producer's sample clock)
+    size_t frames_written() const { return written_.load(std::memory_order_acquire); }
+    // Frames lost because the consumer fell behind
+    size_t frames_dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static size_t checked_channels(size_t capacity_frames, size_t channels) {
+        if (capacity_frames == 0 || channels == 0) {
+            throw std::invalid_argument("SampleRing needs a positive capacity and channel count");
+        }
+        return channels;
+    }
+
+    size_t channels_;
+    SpscRingBuffer<float> ring_;
+    std::atomic<size_t> written_{0};
+    std::atomic<size_t> dropped_{0};
+};
@@ -0,0 +1,192 @@
+#include "spectrogram_cache.h"
+#include "spectrum.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'V', 'Z', 'S', 'P', 'E', 'C', '\0'};
+constexpr uint32_t kEncodingUint8Db = 0;
+
+// On-disk header, written as-is (the format is little-endian)
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t data_offset;
+    uint32_t encoding;
+    uint32_t nperseg;
+    uint32_t hop;
+    uint32_t channels;
+    uint32_t bins;
+    uint32_t sample_rate;
+    uint64_t frames;
+    float db_floor;
+    float db_ceiling;
+    uint8_t key[SpectrogramCacheInfo::kKeySize];
+};
+static_assert(sizeof(FileHeader) == 88, "Spectrogram cache header layout changed");
+static_assert(sizeof(FileHeader) <= SpectrogramCache::kDataOffset, "Header must fit before the frame data");
+
+std::runtime_error cache_error(const std::string& path, const std::string& what) {
+    return std::runtime_error("Spectrogram cache " + path + ": " + what);
+}
+
+}  // namespace
+
+SpectrogramCacheWriter::SpectrogramCacheWriter(const std::string& path, const SpectrogramCacheInfo& info)
+    : path_(path), temp_path_(path + ".tmp"), info_(info) {
+    if (info_.channels == 0 || info_.bins == 0 || info_.hop == 0) {
+        throw std::invalid_argument("Spectrogram cache needs at least one channel, bin and hop");
+    }
+    if (!(info_.db_ceiling > info_.db_floor)) {
+        throw std::invalid_argument("db_ceiling must be greater than db_floor");
+    }
+    info_.frames = 0;
+
+    file_ = std::fopen(temp_path_.c_str(), "wb");
+    if (!file_) {
+        throw cache_error(temp_path_, "could not be created");
+    }
+    heights_.resize(info_.frame_bytes());
+    codes_.resize(info_.frame_bytes());
+    write_header();
+}
+
+SpectrogramCacheWriter::~SpectrogramCacheWriter() {
+    if (file_) {
+        std::fclose(file_);
+        std::remove(temp_path_.c_str());
+    }
+}
+
+void SpectrogramCacheWriter::write_header() {
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = SpectrogramCache::kVersion;
+    header.data_offset = static_cast<uint32_t>(SpectrogramCache::kDataOffset);
+    header.encoding = kEncodingUint8Db;
+    header.nperseg = info_.nperseg;
+    header.hop = info_.hop;
+    header.channels = info_.channels;
+    header.bins = info_.bins;
+    header.sample_rate = info_.sample_rate;
+    header.frames = info_.frames;
+    header.db_floor = info_.db_floor;
+    header.db_ceiling = info_.db_ceiling;
+    std::memcpy(header.key, info_.key.data(), info_.key.size());
+
+    // Header plus zero padding up to the page-aligned frame data
+    std::vector<uint8_t> block(SpectrogramCache::kDataOffset, 0);
+    std::memcpy(block.data(), &header, sizeof(header));
+    if (std::fseek(file_, 0, SEEK_SET) != 0 ||
+        std::fwrite(block.data(), 1, block.size(), file_) != block.size()) {
+        throw cache_error(temp_path_, "header write failed");
+    }
+}
+
+void SpectrogramCacheWriter::append(const float* magnitudes) {
+    if (!file_) {
+        throw std::runtime_error("Spectrogram cache writer is already committed");
+    }
+
+    // Same dB mapping as the bar visualizer, then 8-bit quantisation
+    const size_t n = heights_.size();
+    normalize_db(magnitudes, heights_.data(), n, info_.db_floor, info_.db_ceiling);
+    for (size_t i = 0; i < n; ++i) {
+        codes_[i] = static_cast<uint8_t>(heights_[i] * 255.0f + 0.5f);
+    }
+
+    if (std::fwrite(codes_.data(), 1, n, file_) != n) {
+        throw cache_error(temp_path_, "frame write failed");
+    }
+    ++info_.frames;
+}
+
+void SpectrogramCacheWriter::commit() {
+    if (!file_) {
+        throw std::runtime_error("Spectrogram cache writer is already committed");
+    }
+
+    write_header();
+    const bool flushed = std::fflush(file_) == 0;
+    std::fclose(file_);
+    file_ = nullptr;
+
+    if (!flushed) {
+        std::remove(temp_path_.c_str());
+        throw cache_error(temp_path_, "flush failed");
+    }
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows
+    std::remove(path_.c_str());
+#endif
+    if (std::rename(temp_path_.c_str(), path_.c_str()) != 0) {
+        std::remove(temp_path_.c_str());
+        throw cache_error(path_, "could not be moved into place");
+    }
+}
+
+SpectrogramCache::SpectrogramCache(const std::string& path)
+    // Playback reads forward, but seeking jumps; let the kernel fetch on demand
+    : file_(path, MappedFile::Access::Random) {
+    if (file_.size() < kDataOffset) {
+        throw cache_error(path, "truncated header");
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw cache_error(path, "not a spectrogram cache");
+    }
+    if (header.version != kVersion) {
+        throw cache_error(path, "unsupported version " + std::to_string(header.version));
+    }
+    if (header.encoding != kEncodingUint8Db || header.data_offset != kDataOffset) {
+        throw cache_error(path, "unsupported layout");
+    }
+
+    info_.nperseg = header.nperseg;
+    info_.hop = header.hop;
+    info_.channels = header.channels;
+    info_.bins = header.bins;
+    info_.sample_rate = header.sample_rate;
+    info_.frames = header.frames;
+    info_.db_floor = header.db_floor;
+    info_.db_ceiling = header.db_ceiling;
+    std::memcpy(info_.key.data(), header.key, info_.key.size());
+
+    if (file_.size() != kDataOffset + info_.frames * info_.frame_bytes()) {
+        throw cache_error(path, "size does not match its header");
+    }
+    data_ = file_.data() + kDataOffset;
+
+    const float range = info_.db_ceiling - info_.db_floor;
+    for (size_t code = 0; code < levels_.size(); ++code) {
+        const float db = info_.db_floor + range * static_cast<float>(code) / 255.0f;
+        levels_[code] = std::pow(10.0f, db / 20.0f);
+    }
+}
+
+const uint8_t* SpectrogramCache::codes(uint64_t index) const {
+    if (index >= info_.frames) {
+        throw std::out_of_range("Spectrogram cache frame " + std::to_string(index) + " out of range");
+    }
+    return data_ + index * info_.frame_bytes();
+}
+
+void SpectrogramCache::decode(uint64_t index, float* out) const {
+    const uint8_t* src = codes(index);
+    const size_t n = info_.frame_bytes();
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = levels_[src[i]];
+    }
+}
+
+void SpectrogramCache::prefetch(uint64_t first, uint64_t count) const {
+    if (first >= info_.frames || count == 0) return;
+    count = std::min<uint64_t>(count, info_.frames - first);
+    file_.will_need(kDataOffset + first * info_.frame_bytes(), count * info_.frame_bytes());
+}
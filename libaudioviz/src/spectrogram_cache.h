@@ -0,0 +1,98 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "mapped_file.h"
+
+/**
+ * On-disk spectrogram cache.
+ *
+ * A versioned little-endian file: a fixed header padded to kDataOffset (one
+ * page, so frames stay page aligned), then frame-major magnitudes, each frame
+ * `channels x bins` bytes. Magnitudes are stored as dB quantised to uint8
+ * between db_floor and db_ceiling. The key identifies the source audio (a
+ * content hash chosen by the caller); nperseg and hop identify the analysis.
+ *
+ * SpectrogramCache maps the file read-only, so opening is O(1) and only the
+ * pages around the frames actually read become resident.
+ */
+struct SpectrogramCacheInfo {
+    static constexpr size_t kKeySize = 32;
+
+    uint32_t nperseg = 0;
+    uint32_t hop = 0;
+    uint32_t channels = 0;
+    uint32_t bins = 0;          // nperseg / 2 + 1
+    uint32_t sample_rate = 0;
+    uint64_t frames = 0;
+    float db_floor = -120.0f;
+    float db_ceiling = 0.0f;
+    std::array<uint8_t, kKeySize> key{};
+
+    size_t frame_bytes() const { return static_cast<size_t>(channels) * bins; }
+};
+
+// Writes a cache to `path + ".tmp"` and renames it into place on commit(), so
+// readers never observe a partial file. Uncommitted files are removed.
+class SpectrogramCacheWriter {
+public:
+    SpectrogramCacheWriter(const std::string& path, const SpectrogramCacheInfo& info);
+    ~SpectrogramCacheWriter();
+
+    SpectrogramCacheWriter(const SpectrogramCacheWriter&) = delete;
+    SpectrogramCacheWriter& operator=(const SpectrogramCacheWriter&) = delete;
+
+    // Quantise and append one frame of `channels x bins` magnitudes
+    void append(const float* magnitudes);
+    uint64_t frames() const { return info_.frames; }
+    const SpectrogramCacheInfo& info() const { return info_; }
+
+    // Finalise the header and move the file into place
+    void commit();
+
+private:
+    void write_header();
+
+    std::string path_;
+    std::string temp_path_;
+    SpectrogramCacheInfo info_;
+    std::FILE* file_ = nullptr;
+    std::vector<float> heights_;
+    std::vector<uint8_t> codes_;
+};
+
+class SpectrogramCache {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kDataOffset = 4096;
+
+    // Map an existing cache; throws std::runtime_error if it is missing,
+    // truncated or of another version
+    explicit SpectrogramCache(const std::string& path);
+
+    SpectrogramCache(const SpectrogramCache&) = delete;
+    SpectrogramCache& operator=(const SpectrogramCache&) = delete;
+
+    const SpectrogramCacheInfo& info() const { return info_; }
+    uint64_t frames() const { return info_.frames; }
+
+    // Quantised codes of one frame (channels x bins), straight from the mapping
+    const uint8_t* codes(uint64_t index) const;
+    const uint8_t* data() const { return data_; }
+
+    // Decode one frame into `out` (channels x bins magnitudes)
+    void decode(uint64_t index, float* out) const;
+
+    // Hint that frames [first, first + count) will be read soon
+    void prefetch(uint64_t first, uint64_t count) const;
+
+private:
+    MappedFile file_;
+    SpectrogramCacheInfo info_;
+    std::array<float, 256> levels_{};  // Code -> magnitude
+    const uint8_t* data_ = nullptr;    // First frame
+};
@@ -0,0 +1,253 @@
+#include "spectrum.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AUDIOVIZ_HAVE_AVX2 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define AUDIOVIZ_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr float kEps = 1e-10f;
+constexpr float kDbPerNeper = 8.68588963806503655302f;  // 20 / ln(10)
+
+// The affine part of the mapping, expressed on the natural log:
+// height = ln(|z| + eps) * scale + offset
+struct Affine {
+    float scale;
+    float offset;
+
+    Affine(float db_floor, float db_ceiling) {
+        const float inv_range = 1.0f / (db_ceiling - db_floor);
+        scale = kDbPerNeper * inv_range;
+        offset = -db_floor * inv_range;
+    }
+};
+
+using ComplexKernel = void (*)(const std::complex<float>*, float*, size_t, const Affine&);
+using RealKernel = void (*)(const float*, float*, size_t, const Affine&);
+
+// --- Scalar fallback ---
+
+inline float map_scalar(float magnitude, const Affine& affine) {
+    const float h = std::log(magnitude + kEps) * affine.scale + affine.offset;
+    return std::min(std::max(h, 0.0f), 1.0f);
+}
+
+void complex_scalar(const std::complex<float>* bins, float* out, size_t size, const Affine& affine) {
+    for (size_t i = 0; i < size; ++i) {
+        const float re = bins[i].real();
+        const float im = bins[i].imag();
+        out[i] = map_scalar(std::sqrt(re * re + im * im), affine);
+    }
+}
+
+void real_scalar(const float* magnitudes, float* out, size_t size, const Affine& affine) {
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = map_scalar(magnitudes[i], affine);
+    }
+}
+
+// Cephes-style single precision log polynomial, shared by the SIMD paths
+constexpr float kSqrtHalf = 0.707106781186547524f;
+constexpr float kLogP0 = 7.0376836292e-2f;
+constexpr float kLogP1 = -1.1514610310e-1f;
+constexpr float kLogP2 = 1.1676998740e-1f;
+constexpr float kLogP3 = -1.2420140846e-1f;
+constexpr float kLogP4 = 1.4249322787e-1f;
+constexpr float kLogP5 = -1.6668057665e-1f;
+constexpr float kLogP6 = 2.0000714765e-1f;
+constexpr float kLogP7 = -2.4999993993e-1f;
+constexpr float kLogP8 = 3.3333331174e-1f;
+constexpr float kLogQ1 = -2.12194440e-4f;
+constexpr float kLogQ2 = 0.693359375f;
+
+#if defined(AUDIOVIZ_HAVE_AVX2)
+
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+
+// Natural log of 8 positive, normal floats
+AVX2_TARGET inline __m256 log_avx2(__m256 x) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    __m256i bits = _mm256_castps_si256(x);
+    __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+
+    // Mantissa in [0.5, 1)
+    bits = _mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff));
+    bits = _mm256_or_si256(bits, _mm256_set1_epi32(0x3f000000));
+    x = _mm256_castsi256_ps(bits);
+
+    // Shift to [sqrt(0.5), sqrt(2)) for the polynomial
+    const __m256 mask = _mm256_cmp_ps(x, _mm256_set1_ps(kSqrtHalf), _CMP_LT_OQ);
+    const __m256 tmp = _mm256_and_ps(x, mask);
+    x = _mm256_sub_ps(x, one);
+    e = _mm256_sub_ps(e, _mm256_and_ps(one, mask));
+    x = _mm256_add_ps(x, tmp);
+
+    const __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(kLogP0);
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(kLogP1));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(kLogP2));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(kLogP3));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(kLogP4));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(kLogP5));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(kLogP6));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(kLogP7));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(kLogP8));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, x), z);
+
+    y = _mm256_fmadd_ps(e, _mm256_set1_ps(kLogQ1), y);
+    y = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), y);
+    x = _mm256_add_ps(x, y);
+    return _mm256_fmadd_ps(e, _mm256_set1_ps(kLogQ2), x);
+}
+
+AVX2_TARGET inline __m256 map_avx2(__m256 magnitude, __m256 scale, __m256 offset) {
+    const __m256 h = _mm256_fmadd_ps(log_avx2(_mm256_add_ps(magnitude, _mm256_set1_ps(kEps))), scale, offset);
+    return _mm256_min_ps(_mm256_max_ps(h, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+}
+
+AVX2_TARGET void complex_avx2(const std::complex<float>* bins, float* out, size_t size, const Affine& affine) {
+    const __m256 scale = _mm256_set1_ps(affine.scale);
+    const __m256 offset = _mm256_set1_ps(affine.offset);
+    const float* in = reinterpret_cast<const float*>(bins);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const __m256 a = _mm256_loadu_ps(in + 2 * i);
+        const __m256 b = _mm256_loadu_ps(in + 2 * i + 8);
+        // hadd yields |z|^2 in lane order 0,1,4,5,2,3,6,7; permute restores 0..7
+        __m256 power = _mm256_hadd_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b));
+        power = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(power), _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm256_storeu_ps(out + i, map_avx2(_mm256_sqrt_ps(power), scale, offset));
+    }
+    complex_scalar(bins + i, out + i, size - i, affine);
+}
+
+AVX2_TARGET void real_avx2(const float* magnitudes, float* out, size_t size, const Affine& affine) {
+    const __m256 scale = _mm256_set1_ps(affine.scale);
+    const __m256 offset = _mm256_set1_ps(affine.offset);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        _mm256_storeu_ps(out + i, map_avx2(_mm256_loadu_ps(magnitudes + i), scale, offset));
+    }
+    real_scalar(magnitudes + i, out + i, size - i, affine);
+}
+
+#endif  // AUDIOVIZ_HAVE_AVX2
+
+#if defined(AUDIOVIZ_HAVE_NEON)
+
+// Natural log of 4 positive, normal floats
+inline float32x4_t log_neon(float32x4_t x) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+
+    int32x4_t bits = vreinterpretq_s32_f32(x);
+    float32x4_t e = vcvtq_f32_s32(vsubq_s32(vshrq_n_s32(bits, 23), vdupq_n_s32(126)));
+
+    bits = vandq_s32(bits, vdupq_n_s32(0x007fffff));
+    bits = vorrq_s32(bits, vdupq_n_s32(0x3f000000));
+    x = vreinterpretq_f32_s32(bits);
+
+    const uint32x4_t mask = vcltq_f32(x, vdupq_n_f32(kSqrtHalf));
+    const float32x4_t tmp = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(x), mask));
+    x = vsubq_f32(x, one);
+    e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(one), mask)));
+    x = vaddq_f32(x, tmp);
+
+    const float32x4_t z = vmulq_f32(x, x);
+    float32x4_t y = vdupq_n_f32(kLogP0);
+    y = vmlaq_f32(vdupq_n_f32(kLogP1), y, x);
+    y = vmlaq_f32(vdupq_n_f32(kLogP2), y, x);
+    y = vmlaq_f32(vdupq_n_f32(kLogP3), y, x);
+    y = vmlaq_f32(vdupq_n_f32(kLogP4), y, x);
+    y = vmlaq_f32(vdupq_n_f32(kLogP5), y, x);
+    y = vmlaq_f32(vdupq_n_f32(kLogP6), y, x);
+    y = vmlaq_f32(vdupq_n_f32(kLogP7), y, x);
+    y = vmlaq_f32(vdupq_n_f32(kLogP8), y, x);
+    y = vmulq_f32(vmulq_f32(y, x), z);
+
+    y = vmlaq_f32(y, e, vdupq_n_f32(kLogQ1));
+    y = vmlsq_f32(y, z, vdupq_n_f32(0.5f));
+    x = vaddq_f32(x, y);
+    return vmlaq_f32(x, e, vdupq_n_f32(kLogQ2));
+}
+
+inline float32x4_t map_neon(float32x4_t magnitude, float32x4_t scale, float32x4_t offset) {
+    const float32x4_t h = vmlaq_f32(offset, log_neon(vaddq_f32(magnitude, vdupq_n_f32(kEps))), scale);
+    return vminq_f32(vmaxq_f32(h, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+}
+
+void complex_neon(const std::complex<float>* bins, float* out, size_t size, const Affine& affine) {
+    const float32x4_t scale = vdupq_n_f32(affine.scale);
+    const float32x4_t offset = vdupq_n_f32(affine.offset);
+    const float* in = reinterpret_cast<const float*>(bins);
+
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        const float32x4x2_t z = vld2q_f32(in + 2 * i);  // de-interleaves re / im
+        const float32x4_t power = vmlaq_f32(vmulq_f32(z.val[0], z.val[0]), z.val[1], z.val[1]);
+        vst1q_f32(out + i, map_neon(vsqrtq_f32(power), scale, offset));
+    }
+    complex_scalar(bins + i, out + i, size - i, affine);
+}
+
+void real_neon(const float* magnitudes, float* out, size_t size, const Affine& affine) {
+    const float32x4_t scale = vdupq_n_f32(affine.scale);
+    const float32x4_t offset = vdupq_n_f32(affine.offset);
+
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        vst1q_f32(out + i, map_neon(vld1q_f32(magnitudes + i), scale, offset));
+    }
+    real_scalar(magnitudes + i, out + i, size - i, affine);
+}
+
+#endif  // AUDIOVIZ_HAVE_NEON
+
+// --- Runtime dispatch ---
+
+struct Kernels {
+    ComplexKernel complex_fn;
+    RealKernel real_fn;
+    const char* name;
+};
+
+Kernels select_kernels() {
+#if defined(AUDIOVIZ_HAVE_AVX2)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return {complex_avx2, real_avx2, "avx2"};
+    }
+#elif defined(AUDIOVIZ_HAVE_NEON)
+    return {complex_neon, real_neon, "neon"};
+#endif
+    return {complex_scalar, real_scalar, "scalar"};
+}
+
+const Kernels& kernels() {
+    static const Kernels selected = select_kernels();
+    return selected;
+}
+
+}  // namespace
+
+void normalize_db(const std::complex<float>* bins, float* out, size_t size,
+                  float db_floor, float db_ceiling) {
+    kernels().complex_fn(bins, out, size, Affine(db_floor, db_ceiling));
+}
+
+void normalize_db(const float* magnitudes, float* out, size_t size,
+                  float db_floor, float db_ceiling) {
+    kernels().real_fn(magnitudes, out, size, Affine(db_floor, db_ceiling));
+}
+
+const char* simd_backend() {
+    return kernels().name;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+
+/**
+ * Fused spectrum normalisation kernels.
+ * Each call maps magnitudes to 0..1 heights in a single pass:
+ *   height = clamp((20 * log10(|z| + eps) - db_floor) / (db_ceiling - db_floor), 0, 1)
+ * The implementation is picked once at runtime (AVX2+FMA, NEON, or scalar).
+ */
+
+// Complex STFT bins -> normalized heights (computes |z| on the fly)
+void normalize_db(const std::complex<float>* bins, float* out, size_t size,
+                  float db_floor, float db_ceiling);
+
+// Precomputed magnitudes -> normalized heights
+void normalize_db(const float* magnitudes, float* out, size_t size,
+                  float db_floor, float db_ceiling);
+
+// Name of the kernel selected at runtime: "avx2", "neon" or "scalar"
+const char* simd_backend();
@@ -0,0 +1,260 @@
+#include "stft.h"
+#include "thread_pool.h"
+#include "wav_file.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+size_t next_power_of_two(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+constexpr size_t kMinSegmentFrames = 16;    // Below this, task overhead dominates
+constexpr size_t kTasksPerWorker = 4;       // Slack for dynamic load balancing
+
+void check_params(size_t nperseg, size_t hop, size_t channels) {
+    if (hop == 0 || hop > nperseg) {
+        throw std::invalid_argument("hop must be in [1, nperseg], got " + std::to_string(hop));
+    }
+    if (channels == 0) {
+        throw std::invalid_argument("channels must be positive");
+    }
+}
+
+}  // namespace
+
+std::vector<float> stft_window(size_t nperseg) {
+    std::vector<float> window(nperseg);
+    double sum = 0.0;
+    for (size_t n = 0; n < nperseg; ++n) {
+        const double w = 0.5 - 0.5 * std::cos(2.0 * kPi * n / nperseg);
+        window[n] = static_cast<float>(w);
+        sum += w;
+    }
+    for (float& w : window) {
+        w = static_cast<float>(w / sum);
+    }
+    return window;
+}
+
+StreamingSTFT::StreamingSTFT(size_t nperseg, size_t hop, size_t channels)
+    : nperseg_(nperseg), hop_(hop), channels_(channels), fft_(nperseg), window_(stft_window(nperseg)) {
+    check_params(nperseg, hop, channels);
+
+    frame_.resize(nperseg_);
+    spectrum_.resize(bins());
+    ensure_capacity(nperseg_ + hop_);
+    reset();
+}
+
+void StreamingSTFT::reset() {
+    read_ = 0;
+    filled_ = 0;
+    total_ = 0;
+    finished_ = false;
+    // Boundary padding: the first frame is centred on sample 0
+    append_zeros(nperseg_ / 2);
+}
+
+void StreamingSTFT::ensure_capacity(size_t extra) {
+    const size_t needed = filled_ + extra;
+    if (needed <= capacity_) return;
+
+    // Grow and unroll the ring so the buffered samples start at index 0
+    const size_t new_capacity = next_power_of_two(needed);
+    std::vector<float> grown(new_capacity * channels_, 0.0f);
+    for (size_t ch = 0; ch < channels_; ++ch) {
+        for (size_t i = 0; i < filled_; ++i) {
+            grown[ch * new_capacity + i] = ring_[ch * capacity_ + ((read_ + i) & (capacity_ - 1))];
+        }
+    }
+    ring_.swap(grown);
+    capacity_ = new_capacity;
+    read_ = 0;
+}
+
+void StreamingSTFT::append_zeros(size_t frames) {
+    ensure_capacity(frames);
+    const size_t mask = capacity_ - 1;
+    for (size_t ch = 0; ch < channels_; ++ch) {
+        float* row = &ring_[ch * capacity_];
+        for (size_t i = 0; i < frames; ++i) {
+            row[(read_ + filled_ + i) & mask] = 0.0f;
+        }
+    }
+    filled_ += frames;
+    total_ += frames;
+}
+
+void StreamingSTFT::push(const float* samples, size_t frames) {
+    if (finished_) {
+        throw std::logic_error("push() called after finish()");
+    }
+    ensure_capacity(frames);
+
+    // De-interleave into the per-channel rings
+    const size_t mask = capacity_ - 1;
+    const size_t write = read_ + filled_;
+    for (size_t ch = 0; ch < channels_; ++ch) {
+        float* row = &ring_[ch * capacity_];
+        for (size_t i = 0; i < frames; ++i) {
+            row[(write + i) & mask] = samples[i * channels_ + ch];
+        }
+    }
+    filled_ += frames;
+    total_ += frames;
+}
+
+void StreamingSTFT::finish() {
+    if (finished_) return;
+
+    // Boundary padding at the end, then pad to a whole number of hops
+    append_zeros(nperseg_ / 2);
+    size_t extra = 0;
+    if (total_ < nperseg_) {
+        extra = nperseg_ - total_;
+    } else {
+        extra = (hop_ - (total_ - nperseg_) % hop_) % hop_;
+    }
+    append_zeros(extra);
+    finished_ = true;
+}
+
+size_t StreamingSTFT::frames_available() const {
+    if (filled_ < nperseg_) return 0;
+    return (filled_ - nperseg_) / hop_ + 1;
+}
+
+bool StreamingSTFT::pop(float* out) {
+    if (filled_ < nperseg_) return false;
+
+    const size_t mask = capacity_ - 1;
+    const size_t bin_count = bins();
+    for (size_t ch = 0; ch < channels_; ++ch) {
+        const float* row = &ring_[ch * capacity_];
+        for (size_t n = 0; n < nperseg_; ++n) {
+            frame_[n] = row[(read_ + n) & mask] * window_[n];
+        }
+        fft_.forward(frame_.data(), spectrum_.data());
+
+        float* dst = out + ch * bin_count;
+        for (size_t k = 0; k < bin_count; ++k) {
+            dst[k] = std::abs(spectrum_[k]);
+        }
+    }
+
+    // Keep the overlap, drop one hop
+    read_ = (read_ + hop_) & mask;
+    filled_ -= hop_;
+    return true;
+}
+
+size_t StreamingSTFT::frame_count(size_t num_samples, size_t nperseg, size_t hop) {
+    if (hop == 0) return 0;
+    size_t length = num_samples + 2 * (nperseg / 2);
+    if (length < nperseg) {
+        length = nperseg;
+    } else {
+        length += (hop - (length - nperseg) % hop) % hop;
+    }
+    return (length - nperseg) / hop + 1;
+}
+
+namespace {
+
+// Shared by both batch_stft overloads; `load(sample_index)` returns the
+// sample at interleaved position sample_index as float32
+template <typename Load>
+void batch_stft_impl(const Load& load, size_t num_samples, size_t channels,
+                     size_t nperseg, size_t hop, float* out, ThreadPool& pool,
+                     size_t first_frame, size_t frame_limit) {
+    check_params(nperseg, hop, channels);
+    RealFFT plan(nperseg);  // Validates nperseg before any work is queued
+
+    const size_t total = StreamingSTFT::frame_count(num_samples, nperseg, hop);
+    if (first_frame >= total) return;
+    const size_t frames = std::min(frame_limit, total - first_frame);
+    const size_t bins = nperseg / 2 + 1;
+    const std::vector<float> window = stft_window(nperseg);
+
+    // Enough tasks to keep every worker busy, but no tiny segments
+    const size_t wanted = (pool.size() * kTasksPerWorker + channels - 1) / channels;
+    const size_t max_segments = (frames + kMinSegmentFrames - 1) / kMinSegmentFrames;
+    const size_t segments = std::max<size_t>(1, std::min(wanted, max_segments));
+    const size_t segment_frames = (frames + segments - 1) / segments;
+
+    // FFT plans keep scratch, so each worker gets its own
+    struct Worker {
+        RealFFT fft;
+        std::vector<float> frame;
+        std::vector<std::complex<float>> spectrum;
+    };
+    std::vector<Worker> workers;
+    workers.reserve(pool.size());
+    for (size_t i = 0; i < pool.size(); ++i) {
+        workers.push_back(Worker{i == 0 ? std::move(plan) : RealFFT(nperseg),
+                                 std::vector<float>(nperseg),
+                                 std::vector<std::complex<float>>(bins)});
+    }
+
+    const auto pad = static_cast<std::ptrdiff_t>(nperseg / 2);
+    const auto length = static_cast<std::ptrdiff_t>(num_samples);
+
+    pool.parallel_for(channels * segments, [&](size_t task, size_t worker_index) {
+        Worker& worker = workers[worker_index];
+        const size_t ch = task % channels;
+        const size_t first = (task / channels) * segment_frames;
+        const size_t last = std::min(frames, first + segment_frames);
+
+        for (size_t i = first; i < last; ++i) {
+            // Frame f covers input samples [f * hop - pad, f * hop - pad + nperseg);
+            // anything outside the signal is boundary or end padding
+            const size_t frame_index = first_frame + i;
+            const std::ptrdiff_t start = static_cast<std::ptrdiff_t>(frame_index * hop) - pad;
+            if (start >= 0 && start + static_cast<std::ptrdiff_t>(nperseg) <= length) {
+                const size_t base = static_cast<size_t>(start) * channels + ch;
+                for (size_t n = 0; n < nperseg; ++n) {
+                    worker.frame[n] = load(base + n * channels) * window[n];
+                }
+            } else {
+                for (size_t n = 0; n < nperseg; ++n) {
+                    const std::ptrdiff_t index = start + static_cast<std::ptrdiff_t>(n);
+                    const float sample = index >= 0 && index < length
+                        ? load(static_cast<size_t>(index) * channels + ch) : 0.0f;
+                    worker.frame[n] = sample * window[n];
+                }
+            }
+            worker.fft.forward(worker.frame.data(), worker.spectrum.data());
+
+            float* dst = out + (i * channels + ch) * bins;
+            for (size_t k = 0; k < bins; ++k) {
+                dst[k] = std::abs(worker.spectrum[k]);
+            }
+        }
+    });
+}
+
+}  // namespace
+
+void batch_stft(const float* samples, size_t num_samples, size_t channels,
+                size_t nperseg, size_t hop, float* out, ThreadPool& pool,
+                size_t first_frame, size_t frames) {
+    batch_stft_impl([samples](size_t index) { return samples[index]; },
+                    num_samples, channels, nperseg, hop, out, pool, first_frame, frames);
+}
+
+void batch_stft(const WavFile& wav, size_t nperseg, size_t hop, float* out, ThreadPool& pool,
+                size_t first_frame, size_t frames) {
+    wav.visit([&](const uint8_t* samples, auto format) {
+        using Format = decltype(format);
+        batch_stft_impl([samples](size_t index) { return Format::load(samples + index * Format::kBytes); },
+                        wav.frames(), wav.channels(), nperseg, hop, out, pool, first_frame, frames);
+    });
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "fft.h"
+
+class ThreadPool;
+class WavFile;
+
+// Periodic Hann window (scipy's get_window('hann', nperseg)) with the
+// 1 / sum(window) 'spectrum' scaling folded in
+std::vector<float> stft_window(size_t nperseg);
+
+/**
+ * Incremental STFT over a stream of interleaved sample blocks.
+ *
+ * Produces the same magnitudes as scipy.signal.stft with its defaults
+ * (periodic Hann window, 'spectrum' scaling, zero boundary padding of
+ * nperseg / 2 on both ends, end padding to a whole frame), one frame at a time.
+ * Samples are kept in a per-channel ring buffer that only holds the window
+ * overlap plus whatever has been pushed but not analysed yet, so memory does
+ * not depend on track length. The FFT plan and window are built once.
+ */
+class StreamingSTFT {
+public:
+    StreamingSTFT(size_t nperseg, size_t hop, size_t channels = 1);
+
+    size_t nperseg() const { return nperseg_; }
+    size_t hop() const { return hop_; }
+    size_t channels() const { return channels_; }
+    size_t bins() const { return nperseg_ / 2 + 1; }
+
+    // Append `frames` interleaved sample frames (frames x channels)
+    void push(const float* samples, size_t frames);
+
+    // Append the trailing zero padding. Call once after the last push.
+    void finish();
+    bool finished() const { return finished_; }
+
+    // Frames that can be popped with the samples pushed so far
+    size_t frames_available() const;
+
+    // Analyse the next frame into `out` (channels x bins magnitudes).
+    // Returns false if not enough samples have been pushed yet.
+    bool pop(float* out);
+
+    // Drop all buffered samples and start over, as if newly constructed
+    void reset();
+
+    // Frames scipy.signal.stft produces for `num_samples` input samples
+    static size_t frame_count(size_t num_samples, size_t nperseg, size_t hop);
+
+private:
+    void ensure_capacity(size_t extra);
+    void append_zeros(size_t frames);
+
+    size_t nperseg_;
+    size_t hop_;
+    size_t channels_;
+    bool finished_ = false;
+
+    RealFFT fft_;
+    std::vector<float> window_;   // Hann window with the 1 / sum(window) scaling folded in
+
+    // Planar ring buffer: channels_ rows of capacity_ samples
+    std::vector<float> ring_;
+    size_t capacity_ = 0;          // Power of two
+    size_t read_ = 0;              // Start of the next frame
+    size_t filled_ = 0;            // Samples buffered from read_ onwards
+    size_t total_ = 0;             // Samples pushed including boundary padding
+
+    std::vector<float> frame_;
+    std::vector<std::complex<float>> spectrum_;
+};
+
+/**
+ * Whole-signal STFT magnitudes, computed in parallel.
+ *
+ * Same frames as StreamingSTFT over `num_samples` interleaved sample frames,
+ * written to `out` as (frame_count, channels, bins). Work is split into
+ * (channel, segment of frames) tasks on `pool`; every frame reads its window
+ * straight from the input, so segment boundaries need no special overlap
+ * handling and results do not depend on the split.
+ *
+ * `first_frame` and `frames` select a sub-range of the output frames (the
+ * rest of the signal still provides their windows), so long inputs can be
+ * analysed in bounded pieces. `frames` is clamped to what is left.
+ */
+constexpr size_t kAllFrames = static_cast<size_t>(-1);
+
+void batch_stft(const float* samples, size_t num_samples, size_t channels,
+                size_t nperseg, size_t hop, float* out, ThreadPool& pool,
+                size_t first_frame = 0, size_t frames = kAllFrames);
+
+// Same, reading a WAV file in its stored encoding; samples are converted to
+// float32 inside the windowing loop, so no decoded copy is made
+void batch_stft(const WavFile& wav, size_t nperseg, size_t hop, float* out, ThreadPool& pool,
+                size_t first_frame = 0, size_t frames = kAllFrames);
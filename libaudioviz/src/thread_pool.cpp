@@ -0,0 +1,111 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads - 1);
+    for (size_t worker = 1; worker < threads; ++worker) {
+        workers_.emplace_back([this, worker] { worker_loop(worker); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+ThreadPool& ThreadPool::sized(size_t threads) {
+    if (threads == 0) return shared();
+    static std::mutex mutex;
+    static std::map<size_t, std::unique_ptr<ThreadPool>> pools;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& pool = pools[threads];
+    if (!pool) pool = std::make_unique<ThreadPool>(threads);
+    return *pool;
+}
+
+void ThreadPool::parallel_for(size_t tasks, const std::function<void(size_t, size_t)>& fn) {
+    if (tasks == 0) return;
+
+    // Nothing to share: skip the hand-off entirely
+    if (workers_.empty() || tasks == 1) {
+        for (size_t task = 0; task < tasks; ++task) {
+            fn(task, 0);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> run(run_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        tasks_ = tasks;
+        next_.store(0, std::memory_order_relaxed);
+        active_ = workers_.size();
+        error_ = nullptr;
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    run_tasks(0);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return active_ == 0; });
+        job_ = nullptr;
+        error = error_;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::worker_loop(size_t worker) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+
+        run_tasks(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_ > 0) continue;
+        }
+        done_.notify_one();
+    }
+}
+
+void ThreadPool::run_tasks(size_t worker) {
+    const auto& fn = *job_;
+    size_t task;
+    while ((task = next_.fetch_add(1, std::memory_order_relaxed)) < tasks_) {
+        try {
+            fn(task, worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+            next_.store(tasks_, std::memory_order_relaxed);  // Skip what is left
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of worker threads for data-parallel loops.
+ * parallel_for() hands out task indices dynamically, so uneven tasks still
+ * balance. The calling thread works too (as worker 0), and the call returns
+ * once every task has finished. The first exception thrown by a task is
+ * rethrown to the caller and the remaining tasks are skipped.
+ *
+ * Calls are serialised, and tasks must not call parallel_for() on the same
+ * pool.
+ */
+class ThreadPool {
+public:
+    // `threads` counts the caller; 0 uses std::thread::hardware_concurrency()
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size() + 1; }
+
+    // Run fn(task, worker) for every task in [0, tasks); worker < size()
+    void parallel_for(size_t tasks, const std::function<void(size_t, size_t)>& fn);
+
+    // Process-wide pool sized to the machine
+    static ThreadPool& shared();
+
+    // Process-wide pool of `threads` threads, created on first use and kept
+    // for later calls with the same count; 0 is shared()
+    static ThreadPool& sized(size_t threads);
+
+private:
+    void worker_loop(size_t worker);
+    void run_tasks(size_t worker);
+
+    std::vector<std::thread> workers_;
+    std::mutex run_mutex_;  // One parallel_for at a time
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(size_t, size_t)>* job_ = nullptr;
+    size_t tasks_ = 0;
+    std::atomic<size_t> next_{0};
+    size_t active_ = 0;         // Workers still inside the current job
+    uint64_t generation_ = 0;   // Bumped for every job
+    bool stop_ = false;
+    std::exception_ptr error_;
+};
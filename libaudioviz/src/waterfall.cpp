@@ -0,0 +1,124 @@
+#include "waterfall.h"
+#include "spectrum.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+uint32_t pack_rgba(uint8_t r, uint8_t g, uint8_t b) {
+    // SDL_PIXELFORMAT_RGBA32 is R, G, B, A in memory order
+    const uint8_t bytes[4] = {r, g, b, 255};
+    uint32_t pixel;
+    std::memcpy(&pixel, bytes, sizeof(pixel));
+    return pixel;
+}
+
+WaterfallPalette build_palette() {
+    // Black -> violet -> red -> orange -> pale yellow, evenly spaced
+    constexpr float stops[][3] = {
+        {0, 0, 0}, {60, 10, 120}, {200, 30, 60}, {255, 150, 0}, {255, 250, 200},
+    };
+    constexpr int segments = 4;
+
+    WaterfallPalette palette;
+    for (int i = 0; i < 256; ++i) {
+        const float t = i / 255.0f * segments;
+        const int s = std::min(static_cast<int>(t), segments - 1);
+        const float f = t - s;
+        uint8_t c[3];
+        for (int k = 0; k < 3; ++k) {
+            c[k] = static_cast<uint8_t>(stops[s][k] + (stops[s + 1][k] - stops[s][k]) * f + 0.5f);
+        }
+        palette[i] = pack_rgba(c[0], c[1], c[2]);
+    }
+    return palette;
+}
+
+}  // namespace
+
+const WaterfallPalette& waterfall_palette() {
+    static const WaterfallPalette palette = build_palette();
+    return palette;
+}
+
+void validate_waterfall_style(const WaterfallStyle& style) {
+    if (style.history <= 0) {
+        throw std::invalid_argument("Waterfall history must be positive, got " + std::to_string(style.history));
+    }
+    if (!(style.db_floor < style.db_ceiling)) {
+        throw std::invalid_argument("Waterfall db_floor must be below db_ceiling");
+    }
+}
+
+void waterfall_column(const float* magnitudes, size_t size, const WaterfallStyle& style,
+                      float* heights, uint32_t* column) {
+    normalize_db(magnitudes, heights, size, style.db_floor, style.db_ceiling);
+    const WaterfallPalette& palette = waterfall_palette();
+    for (size_t i = 0; i < size; ++i) {
+        // NaN magnitudes pass through normalize_db; map them (and anything
+        // outside 0..1) into the palette instead of indexing past it
+        const float h = heights[i] >= 0.0f ? std::min(heights[i], 1.0f) : 0.0f;
+        column[size - 1 - i] = palette[static_cast<int>(h * 255.0f + 0.5f)];
+    }
+}
+
+WaterfallTexture::~WaterfallTexture() {
+    release();
+}
+
+void WaterfallTexture::release() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+    rows_ = 0;
+    history_ = 0;
+    head_ = 0;
+}
+
+void WaterfallTexture::push(SDL_Renderer* renderer, const uint32_t* column, int rows, int history) {
+    if (rows <= 0 || history <= 0) return;
+
+    if (!texture_ || rows != rows_ || history != history_) {
+        release();
+        texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, history, rows);
+        if (!texture_) {
+            throw std::runtime_error("Waterfall texture could not be created! SDL_Error: " +
+                                     std::string(SDL_GetError()));
+        }
+        SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_NONE);
+        rows_ = rows;
+        history_ = history;
+
+        // Start from silence; this full upload only happens on (re)creation
+        const std::vector<uint32_t> silence(static_cast<size_t>(rows) * history, waterfall_palette()[0]);
+        SDL_UpdateTexture(texture_, nullptr, silence.data(), history * static_cast<int>(sizeof(uint32_t)));
+    }
+
+    // A 1-pixel-wide region: each row is a single pixel
+    const SDL_Rect slot{head_, 0, 1, rows_};
+    SDL_UpdateTexture(texture_, &slot, column, static_cast<int>(sizeof(uint32_t)));
+    head_ = (head_ + 1) % history_;
+}
+
+void WaterfallTexture::draw(SDL_Renderer* renderer, const SDL_Rect& dst) const {
+    if (!texture_) return;
+
+    // Oldest columns are [head, history), then the newest [0, head). Split
+    // the destination at the same proportion so the seam lands on a column.
+    const int older = history_ - head_;
+    const int split = static_cast<int>(static_cast<int64_t>(dst.w) * older / history_);
+
+    const SDL_Rect old_src{head_, 0, older, rows_};
+    const SDL_Rect old_dst{dst.x, dst.y, split, dst.h};
+    SDL_RenderCopy(renderer, texture_, &old_src, &old_dst);
+
+    if (head_ > 0) {
+        const SDL_Rect new_src{0, 0, head_, rows_};
+        const SDL_Rect new_dst{dst.x + split, dst.y, dst.w - split, dst.h};
+        SDL_RenderCopy(renderer, texture_, &new_src, &new_dst);
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <SDL2/SDL.h>
+
+/**
+ * Scrolling spectrogram ("waterfall") backed by a texture used as a ring.
+ * The texture holds `history` columns of `rows` pixels, one column per
+ * frame, low frequencies at the bottom. Each frame uploads only the newest
+ * column into the write slot (a 1-pixel-wide SDL_UpdateTexture) and draws
+ * the ring oldest to newest with two wrapped blits, so the per-frame cost is
+ * O(rows) however long the history is.
+ *
+ * Only the thread that owns the SDL renderer may call push()/draw(); the
+ * Renderer records columns like any other command and replays them there.
+ */
+
+struct WaterfallStyle {
+    int history = 512;           // Columns kept on screen
+    float db_floor = -60.0f;     // Level mapped to the darkest colour
+    float db_ceiling = -10.0f;   // Level mapped to the brightest colour
+};
+
+// 0..1 intensity -> packed SDL_PIXELFORMAT_RGBA32 pixel (a dark-to-hot ramp)
+using WaterfallPalette = std::array<uint32_t, 256>;
+const WaterfallPalette& waterfall_palette();
+
+// Throw std::invalid_argument unless history > 0 and db_floor < db_ceiling
+void validate_waterfall_style(const WaterfallStyle& style);
+
+// dB-map `size` magnitudes into one column of RGBA32 pixels, top row first
+// (highest bin at the top). `heights` is size floats of scratch.
+void waterfall_column(const float* magnitudes, size_t size, const WaterfallStyle& style,
+                      float* heights, uint32_t* column);
+
+class WaterfallTexture {
+public:
+    WaterfallTexture() = default;
+    ~WaterfallTexture();
+
+    WaterfallTexture(const WaterfallTexture&) = delete;
+    WaterfallTexture& operator=(const WaterfallTexture&) = delete;
+
+    // Upload one column of `rows` pixels as the newest. A different rows or
+    // history count (re)creates the texture and clears the history.
+    void push(SDL_Renderer* renderer, const uint32_t* column, int rows, int history);
+
+    // Draw the history across `dst`, oldest column at the left
+    void draw(SDL_Renderer* renderer, const SDL_Rect& dst) const;
+
+    // Free the texture; must run before the SDL renderer is destroyed
+    void release();
+
+    int rows() const { return rows_; }
+    int history() const { return history_; }
+    int head() const { return head_; }   // Slot the next column is written to
+
+private:
+    SDL_Texture* texture_ = nullptr;
+    int rows_ = 0;
+    int history_ = 0;
+    int head_ = 0;
+};
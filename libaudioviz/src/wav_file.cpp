@@ -0,0 +1,122 @@
+#include "wav_file.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint16_t kFormatPcm = 1;
+constexpr uint16_t kFormatFloat = 3;
+constexpr uint16_t kFormatExtensible = 0xFFFE;
+
+uint16_t read_u16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t read_u32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+           static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+std::runtime_error wav_error(const std::string& path, const std::string& what) {
+    return std::runtime_error("WAV file " + path + ": " + what);
+}
+
+}  // namespace
+
+WavFile::WavFile(const std::string& path, MappedFile::Access access) : file_(path, access) {
+    const uint8_t* data = file_.data();
+    const size_t size = file_.size();
+    if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+        throw wav_error(path, "not a RIFF/WAVE file");
+    }
+
+    // Walk the chunk list for "fmt " and "data"; chunks are padded to even sizes
+    bool have_format = false;
+    uint16_t format = 0;
+    uint16_t bits = 0;
+    uint16_t block_align = 0;
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        const uint8_t* chunk = data + offset;
+        const size_t chunk_size = read_u32(chunk + 4);
+        const size_t body = offset + 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunk_size < 16 || body + chunk_size > size) {
+                throw wav_error(path, "truncated format chunk");
+            }
+            format = read_u16(data + body);
+            channels_ = read_u16(data + body + 2);
+            sample_rate_ = static_cast<int>(read_u32(data + body + 4));
+            block_align = read_u16(data + body + 12);
+            bits = read_u16(data + body + 14);
+            if (format == kFormatExtensible) {
+                // The sub-format GUID starts with the plain format tag
+                if (chunk_size < 40) {
+                    throw wav_error(path, "truncated extensible format chunk");
+                }
+                format = read_u16(data + body + 24);
+            }
+            have_format = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!have_format) {
+                throw wav_error(path, "data chunk before format chunk");
+            }
+            // Streams written without a final size report 0 or 0xFFFFFFFF;
+            // either way the data runs to the end of the file
+            const size_t available = size - body;
+            const size_t length = chunk_size == 0 || chunk_size > available ? available : chunk_size;
+
+            if (format == kFormatPcm && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) {
+                encoding_ = bits == 8 ? Encoding::Uint8 : bits == 16 ? Encoding::Int16
+                          : bits == 24 ? Encoding::Int24 : Encoding::Int32;
+            } else if (format == kFormatFloat && bits == 32) {
+                encoding_ = Encoding::Float32;
+            } else {
+                throw wav_error(path, "unsupported encoding (format " + std::to_string(format) +
+                                      ", " + std::to_string(bits) + " bits)");
+            }
+            bytes_per_sample_ = bits / 8;
+            if (channels_ == 0 || sample_rate_ <= 0 || block_align != channels_ * bytes_per_sample_) {
+                throw wav_error(path, "inconsistent format chunk");
+            }
+            frames_ = length / block_align;
+            samples_ = data + body;
+            return;
+        }
+
+        offset = body + chunk_size + (chunk_size & 1);
+    }
+    throw wav_error(path, "no data chunk");
+}
+
+void WavFile::read(size_t first, size_t count, float* out) const {
+    if (first > frames_ || count > frames_ - first) {
+        throw std::out_of_range("WAV frames [" + std::to_string(first) + ", " +
+                                std::to_string(first + count) + ") out of range");
+    }
+    const size_t n = count * channels_;
+    visit([&](const uint8_t* samples, auto format) {
+        using Format = decltype(format);
+        const uint8_t* src = samples + first * channels_ * Format::kBytes;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = Format::load(src + i * Format::kBytes);
+        }
+    });
+}
+
+void WavFile::will_need(size_t first, size_t count) const {
+    const size_t frame_bytes = channels_ * bytes_per_sample_;
+    file_.will_need(static_cast<size_t>(samples_ - file_.data()) + first * frame_bytes, count * frame_bytes);
+}
+
+const char* wav_encoding_name(WavFile::Encoding encoding) {
+    switch (encoding) {
+        case WavFile::Encoding::Uint8: return "uint8";
+        case WavFile::Encoding::Int16: return "int16";
+        case WavFile::Encoding::Int24: return "int24";
+        case WavFile::Encoding::Int32: return "int32";
+        case WavFile::Encoding::Float32: return "float32";
+    }
+    return "unknown";
+}
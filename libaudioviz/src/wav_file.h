@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "mapped_file.h"
+
+/**
+ * Zero-copy reader for PCM and IEEE-float WAV files.
+ * The file is memory mapped and only the RIFF header is parsed; samples stay
+ * in their stored encoding and are converted to float32 where they are
+ * consumed (read() or the STFT windowing in batch_stft()), so a long file
+ * costs page cache rather than a decoded copy. Conversion matches
+ * libsndfile's float normalisation (full scale = 1.0).
+ */
+class WavFile {
+public:
+    enum class Encoding { Uint8, Int16, Int24, Int32, Float32 };
+
+    // Throws std::runtime_error if the file is not a WAV file or uses an
+    // encoding other than the ones above
+    explicit WavFile(const std::string& path, MappedFile::Access access = MappedFile::Access::Sequential);
+
+    int sample_rate() const { return sample_rate_; }
+    size_t channels() const { return channels_; }
+    size_t frames() const { return frames_; }
+    Encoding encoding() const { return encoding_; }
+    size_t bytes_per_sample() const { return bytes_per_sample_; }
+
+    // Interleaved samples in the stored encoding, frames() * channels() of them
+    const uint8_t* samples() const { return samples_; }
+
+    // Convert frames [first, first + count) to interleaved float32
+    void read(size_t first, size_t count, float* out) const;
+
+    // Hint that frames [first, first + count) will be read soon
+    void will_need(size_t first, size_t count) const;
+
+    // Call fn(samples, SampleFormat{}) with the format type matching encoding()
+    template <typename Fn>
+    void visit(Fn&& fn) const;
+
+private:
+    MappedFile file_;
+    int sample_rate_ = 0;
+    size_t channels_ = 0;
+    size_t frames_ = 0;
+    Encoding encoding_ = Encoding::Int16;
+    size_t bytes_per_sample_ = 0;
+    const uint8_t* samples_ = nullptr;
+};
+
+// Per-encoding sample loaders, for kernels templated on the stored format
+namespace pcm {
+
+struct Uint8 {
+    static constexpr size_t kBytes = 1;
+    static float load(const uint8_t* p) { return (static_cast<int>(p[0]) - 128) * (1.0f / 128.0f); }
+};
+
+struct Int16 {
+    static constexpr size_t kBytes = 2;
+    static float load(const uint8_t* p) {
+        const int16_t v = static_cast<int16_t>(p[0] | (p[1] << 8));
+        return v * (1.0f / 32768.0f);
+    }
+};
+
+struct Int24 {
+    static constexpr size_t kBytes = 3;
+    static float load(const uint8_t* p) {
+        const int32_t v = static_cast<int32_t>(static_cast<uint32_t>(p[0]) << 8 |
+                                               static_cast<uint32_t>(p[1]) << 16 |
+                                               static_cast<uint32_t>(p[2]) << 24) >> 8;
+        return v * (1.0f / 8388608.0f);
+    }
+};
+
+struct Int32 {
+    static constexpr size_t kBytes = 4;
+    static float load(const uint8_t* p) {
+        int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return static_cast<float>(v) * (1.0f / 2147483648.0f);
+    }
+};
+
+struct Float32 {
+    static constexpr size_t kBytes = 4;
+    static float load(const uint8_t* p) {
+        float v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+};
+
+}  // namespace pcm
+
+template <typename Fn>
+void WavFile::visit(Fn&& fn) const {
+    switch (encoding_) {
+        case Encoding::Uint8: fn(samples_, pcm::Uint8{}); break;
+        case Encoding::Int16: fn(samples_, pcm::Int16{}); break;
+        case Encoding::Int24: fn(samples_, pcm::Int24{}); break;
+        case Encoding::Int32: fn(samples_, pcm::Int32{}); break;
+        case Encoding::Float32: fn(samples_, pcm::Float32{}); break;
+    }
+}
+
+const char* wav_encoding_name(WavFile::Encoding encoding);
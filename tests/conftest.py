@@ -1,6 +1,13 @@
 """Pytest configuration and shared fixtures."""
 
+from pathlib import Path
+from typing import Callable
+
+import numpy as np
 import pytest
+import soundfile as sf
+
+import libaudioviz
 
 
 def pytest_configure(config: pytest.Config) -> None:
@@ -36,3 +43,50 @@ def chunk_size() -> int:
 def stereo_channels() -> int:
     """Number of stereo channels."""
     return 2
+
+
+@pytest.fixture
+def sample_wav_file(
+    tmp_path: Path,
+    sample_rate: int,
+    duration_sec: float,
+    frequency_hz: int,
+) -> Path:
+    """Create a simple test WAV file."""
+    t = np.linspace(0, duration_sec, int(sample_rate * duration_sec))
+    samples = np.sin(2 * np.pi * frequency_hz * t)
+    
+    filepath = tmp_path / "test.wav"
+    sf.write(filepath, samples, sample_rate)
+    return filepath
+
+
+@pytest.fixture
+def stereo_wav_file(
+    tmp_path: Path,
+    sample_rate: int,
+    duration_sec: float,
+    frequency_hz: int,
+) -> Path:
+    """Create a stereo test WAV file."""
+    t = np.linspace(0, duration_sec, int(sample_rate * duration_sec))
+    left = np.sin(2 * np.pi * frequency_hz * t)
+    right = np.sin(2 * np.pi * frequency_hz * 2 * t)  # Octave higher
+    stereo = np.column_stack([left, right])
+    
+    filepath = tmp_path / "stereo.wav"
+    sf.write(filepath, stereo, sample_rate)
+    return filepath
+
+
+@pytest.fixture
+def render_headless() -> Callable[..., np.ndarray]:
+    """Render one frame: `render_headless(width, height, draw)` returns its pixels."""
+    def render(width: int, height: int, draw: Callable[[libaudioviz.Renderer], None]) -> np.ndarray:
+        renderer = libaudioviz.Renderer(width, height)
+        renderer.initialize_headless()
+        renderer.clear(0, 0, 0, 255)
+        draw(renderer)
+        renderer.present()
+        return renderer.read_pixels()
+    return render
@@ -4,43 +4,9 @@ from pathlib import Path
 
 import numpy as np
 import pytest
-import soundfile as sf
 
-from audioviz.audioviz.audio import AudioChunk, AudioInfo, audio_info, stream_audio
-
-
-@pytest.fixture
-def sample_wav_file(
-    tmp_path: Path,
-    sample_rate: int,
-    duration_sec: float,
-    frequency_hz: int,
-) -> Path:
-    """Create a simple test WAV file."""
-    t = np.linspace(0, duration_sec, int(sample_rate * duration_sec))
-    samples = np.sin(2 * np.pi * frequency_hz * t)
-    
-    filepath = tmp_path / "test.wav"
-    sf.write(filepath, samples, sample_rate)
-    return filepath
-
-
-@pytest.fixture
-def stereo_wav_file(
-    tmp_path: Path,
-    sample_rate: int,
-    duration_sec: float,
-    frequency_hz: int,
-) -> Path:
-    """Create a stereo test WAV file."""
-    t = np.linspace(0, duration_sec, int(sample_rate * duration_sec))
-    left = np.sin(2 * np.pi * frequency_hz * t)
-    right = np.sin(2 * np.pi * frequency_hz * 2 * t)  # Octave higher
-    stereo = np.column_stack([left, right])
-    
-    filepath = tmp_path / "stereo.wav"
-    sf.write(filepath, stereo, sample_rate)
-    return filepath
+import libaudioviz
+from audioviz.audioviz.audio import AudioChunk, AudioInfo, audio_info, prefetch_audio, stream_audio
 
 
 def test_audio_info(
@@ -97,3 +63,53 @@ def test_stream_audio_stereo_preserves_channels(
         assert chunk.samples.ndim == stereo_channels
         assert chunk.samples.shape[1] == stereo_channels
         assert chunk.channels == stereo_channels
+
+
+def test_stream_audio_defaults_to_float32(sample_wav_file: Path) -> None:
+    """Test that stream_audio yields float32 samples unless asked otherwise."""
+    assert next(stream_audio(sample_wav_file)).samples.dtype == np.float32
+    assert next(stream_audio(sample_wav_file, dtype=None)).samples.dtype == np.float64
+
+
+@pytest.mark.parametrize("depth", [1, 3])
+def test_prefetch_audio_matches_stream_audio(stereo_wav_file: Path, depth: int) -> None:
+    """Test that prefetched chunks carry the same float32 samples as stream_audio."""
+    expected = list(stream_audio(stereo_wav_file, chunk_size=1000, dtype='float32'))
+    chunks = list(prefetch_audio(stereo_wav_file, chunk_size=1000, depth=depth))
+
+    assert [len(c.samples) for c in chunks] == [len(c.samples) for c in expected]
+    assert [c.is_last for c in chunks] == [c.is_last for c in expected]
+    np.testing.assert_array_equal(
+        np.concatenate([c.samples for c in chunks]),
+        np.concatenate([c.samples for c in expected]),
+    )
+
+
+def test_prefetch_audio_mono_is_one_dimensional(sample_wav_file: Path) -> None:
+    """Test that mono files keep stream_audio's 1-D sample layout."""
+    chunk = next(prefetch_audio(sample_wav_file))
+
+    assert chunk.samples.ndim == 1
+    assert chunk.samples.dtype == np.float32
+
+
+def test_prefetch_decoder_reuses_out(stereo_wav_file: Path) -> None:
+    """Test that read(out=...) fills the caller's buffer and views it for the short tail."""
+    try:
+        decoder = libaudioviz.PrefetchDecoder(str(stereo_wav_file), block_frames=4096, depth=2)
+    except RuntimeError:
+        pytest.skip("libaudioviz built without libsndfile")
+    out = np.empty((4096, 2), dtype=np.float32)
+
+    total = 0
+    while (block := decoder.read(out)) is not None:
+        assert np.shares_memory(block, out)
+        total += len(block)
+
+    assert total == decoder.frames
+
+
+def test_prefetch_audio_missing_file_raises(tmp_path: Path) -> None:
+    """Test that a missing file is reported as FileNotFoundError."""
+    with pytest.raises(FileNotFoundError):
+        next(prefetch_audio(tmp_path / "missing.wav"))
@@ -0,0 +1,68 @@
+"""Tests for the parallel whole-signal STFT."""
+
+import numpy as np
+import pytest
+import scipy.signal
+
+import libaudioviz
+from audioviz.audioviz.stft import compute_spectrogram
+
+
+@pytest.fixture
+def multichannel() -> np.ndarray:
+    """A few seconds of 6-channel noise, long enough to split into many segments."""
+    rng = np.random.default_rng(2)
+    return rng.standard_normal((3 * 44100 + 17, 6)).astype(np.float32)
+
+
+def test_batch_stft_matches_scipy_per_channel(multichannel: np.ndarray) -> None:
+    """Test that every channel matches scipy.signal.stft magnitudes."""
+    nperseg, hop = 1024, 256
+    
+    frames = libaudioviz.batch_stft(multichannel, nperseg, hop)
+    
+    for ch in range(multichannel.shape[1]):
+        _, _, Zxx = scipy.signal.stft(multichannel[:, ch], nperseg=nperseg, noverlap=nperseg - hop)
+        assert frames.shape == (Zxx.shape[1], multichannel.shape[1], Zxx.shape[0])
+        np.testing.assert_allclose(frames[:, ch, :], np.abs(Zxx.T), atol=1e-5)
+
+
+def test_batch_stft_matches_streaming_exactly(multichannel: np.ndarray) -> None:
+    """Test that the batch and streaming engines produce identical frames."""
+    stft = libaudioviz.StreamingSTFT(512, 128, multichannel.shape[1])
+    stft.push(multichannel)
+    stft.finish()
+    streamed = np.stack([stft.pop() for _ in range(stft.frames_available)])
+    
+    np.testing.assert_array_equal(libaudioviz.batch_stft(multichannel, 512, 128), streamed)
+
+
+@pytest.mark.parametrize("threads", [1, 2, 3, 8])
+def test_batch_stft_is_independent_of_thread_count(multichannel: np.ndarray, threads: int) -> None:
+    """Test that segment boundaries do not change any frame."""
+    expected = libaudioviz.batch_stft(multichannel, 1024, 512, threads=1)
+    
+    actual = libaudioviz.batch_stft(multichannel, 1024, 512, threads=threads)
+    
+    np.testing.assert_array_equal(actual, expected)
+
+
+def test_batch_stft_writes_into_out(multichannel: np.ndarray) -> None:
+    """Test that a preallocated output is filled in place."""
+    frames = libaudioviz.StreamingSTFT.frame_count(len(multichannel), 1024, 512)
+    out = np.empty((frames, multichannel.shape[1], 513), dtype=np.float32)
+    
+    result = libaudioviz.batch_stft(multichannel, 1024, 512, out=out)
+    
+    assert np.shares_memory(result, out)
+    with pytest.raises(ValueError):
+        libaudioviz.batch_stft(multichannel, 1024, 512, out=out[:-1])
+
+
+def test_compute_spectrogram_accepts_mono() -> None:
+    """Test that 1-D input becomes a single channel."""
+    samples = np.sin(np.linspace(0, 200 * np.pi, 8000))
+    
+    frames = compute_spectrogram(samples, nperseg=256)
+    
+    assert frames.shape == (libaudioviz.StreamingSTFT.frame_count(8000, 256, 128), 1, 129)
@@ -0,0 +1,85 @@
+"""Tests for per-primitive colours submitted in one geometry batch."""
+
+from typing import Callable
+
+import numpy as np
+import pytest
+
+import libaudioviz
+from audioviz.audioviz.outputs import render_frame
+from audioviz.audioviz.primitives import (
+    CYAN, GREEN, MAGENTA, DrawBatch, FrameCommands, Line, Rect, gradient,
+)
+
+
+WIDTH, HEIGHT = 128, 96
+
+
+@pytest.fixture
+def rects() -> np.ndarray:
+    """Non-overlapping bars of varying height."""
+    return np.array([[x, HEIGHT - 10 - x // 2, 6, 10 + x // 2] for x in range(0, WIDTH, 8)], dtype=np.int32)
+
+
+def test_colored_rectangles_match_one_call_per_colour(
+    render_headless: Callable[..., np.ndarray], rects: np.ndarray,
+) -> None:
+    """Test that per-rect colours draw the same pixels as one fill per colour."""
+    colors = gradient(GREEN, MAGENTA, len(rects))
+
+    def per_colour(renderer: libaudioviz.Renderer) -> None:
+        for rect, color in zip(rects, colors):
+            renderer.draw_rectangles(rect[np.newaxis], *color.tolist())
+
+    actual = render_headless(WIDTH, HEIGHT, lambda r: r.draw_colored_rectangles(rects, colors))
+    np.testing.assert_array_equal(actual, render_headless(WIDTH, HEIGHT, per_colour))
+
+
+def test_colored_lines_match_one_call_per_colour(render_headless: Callable[..., np.ndarray]) -> None:
+    """Test that per-line colours draw the same pixels as one batch per colour."""
+    lines = np.array([[10, 10, 100, 80], [5, 90, 120, 20], [64, 0, 64, 95]], dtype=np.int32)
+    colors = np.array([[255, 0, 0, 255], [0, 255, 0, 255], [0, 0, 255, 255]], dtype=np.uint8)
+
+    def per_colour(renderer: libaudioviz.Renderer) -> None:
+        for line, color in zip(lines, colors):
+            renderer.draw_lines(line[np.newaxis], *color.tolist())
+
+    actual = render_headless(WIDTH, HEIGHT, lambda r: r.draw_colored_lines(lines, colors))
+    np.testing.assert_array_equal(actual, render_headless(WIDTH, HEIGHT, per_colour))
+
+
+def test_colour_count_must_match(rects: np.ndarray) -> None:
+    """Test that a colour array of the wrong length is rejected."""
+    renderer = libaudioviz.Renderer(WIDTH, HEIGHT)
+    renderer.initialize_headless()
+    with pytest.raises(ValueError):
+        renderer.draw_colored_rectangles(rects, gradient(GREEN, CYAN, len(rects) - 1))
+    with pytest.raises(ValueError):
+        DrawBatch.from_colored_rects([Rect(0, 0, 1, 1)], gradient(GREEN, CYAN, 2))
+
+
+def test_gradient_spans_endpoints() -> None:
+    """Test that gradient runs from the start colour to the end colour."""
+    colors = gradient(GREEN, MAGENTA, 5)
+
+    assert colors.shape == (5, 4)
+    assert colors.dtype == np.uint8
+    np.testing.assert_array_equal(colors[0], GREEN.as_tuple())
+    np.testing.assert_array_equal(colors[-1], MAGENTA.as_tuple())
+
+
+def test_render_frame_keeps_batch_colours(render_headless: Callable[..., np.ndarray]) -> None:
+    """Test that single-colour and per-primitive batches render with their colours."""
+    commands = FrameCommands(batches=(
+        DrawBatch.from_rects([Rect(0, 0, 10, 10)], GREEN),
+        DrawBatch.from_colored_rects([Rect(20, 0, 10, 10), Rect(40, 0, 10, 10)],
+                                     gradient(CYAN, MAGENTA, 2)),
+        DrawBatch.from_lines([Line(0, 50, 127, 50)], MAGENTA),
+    ))
+
+    pixels = render_headless(WIDTH, HEIGHT, lambda r: render_frame(r, commands))
+
+    np.testing.assert_array_equal(pixels[5, 5], GREEN.as_tuple())
+    np.testing.assert_array_equal(pixels[5, 25], CYAN.as_tuple())
+    np.testing.assert_array_equal(pixels[5, 45], MAGENTA.as_tuple())
+    np.testing.assert_array_equal(pixels[50, 64], MAGENTA.as_tuple())
@@ -0,0 +1,98 @@
+"""Tests for native band smoothing and peak hold."""
+
+import math
+
+import numpy as np
+import pytest
+
+import libaudioviz
+
+
+BANDS = 16
+
+
+@pytest.fixture
+def follower() -> libaudioviz.EnvelopeFollower:
+    """Follower with an instant attack and round-number time constants."""
+    return libaudioviz.EnvelopeFollower(BANDS, attack_ms=0.0, release_ms=100.0,
+                                        peak_hold_ms=50.0, peak_release_ms=200.0)
+
+
+def test_attack_and_release_follow_time_constants(follower: libaudioviz.EnvelopeFollower) -> None:
+    """Test that rises are immediate and falls decay by exp(-dt / release)."""
+    loud = np.full(BANDS, 0.5, dtype=np.float32)
+    silent = np.zeros(BANDS, dtype=np.float32)
+
+    np.testing.assert_allclose(follower.process(loud, 10.0), loud)
+    released = follower.process(silent, 30.0)
+
+    np.testing.assert_allclose(released, 0.5 * math.exp(-30.0 / 100.0), rtol=1e-5)
+
+
+def test_smoothing_does_not_depend_on_frame_rate() -> None:
+    """Test that one long step and several short ones end at the same envelope."""
+    magnitudes = np.linspace(0.0, 1.0, BANDS, dtype=np.float32)
+    coarse = libaudioviz.EnvelopeFollower(BANDS)
+    fine = libaudioviz.EnvelopeFollower(BANDS)
+
+    coarse.process(magnitudes, 40.0)
+    for _ in range(4):
+        fine.process(magnitudes, 10.0)
+
+    np.testing.assert_allclose(coarse.envelope, fine.envelope, rtol=1e-5)
+
+
+def test_peaks_hold_then_fall(follower: libaudioviz.EnvelopeFollower) -> None:
+    """Test that a peak stays put for the hold time, then decays but never below the envelope."""
+    follower.process(np.full(BANDS, 1.0, dtype=np.float32), 10.0)
+    silent = np.zeros(BANDS, dtype=np.float32)
+
+    follower.process(silent, 40.0)
+    np.testing.assert_allclose(follower.peaks, 1.0)
+
+    follower.process(silent, 20.0)
+    assert np.all(follower.peaks < 1.0)
+    assert np.all(follower.peaks >= follower.envelope)
+
+
+def test_updates_in_place(follower: libaudioviz.EnvelopeFollower) -> None:
+    """Test that every update returns a read-only view of the same state arrays."""
+    magnitudes = np.ones(BANDS, dtype=np.float32)
+    first = follower.process(magnitudes, 10.0)
+    second = follower.process(magnitudes * 0.5, 10.0)
+
+    assert np.shares_memory(first, second)
+    assert np.shares_memory(second, follower.envelope)
+    assert not second.flags.writeable
+
+
+def test_zero_step_and_band_changes(follower: libaudioviz.EnvelopeFollower) -> None:
+    """Test that dt 0 leaves state alone and a new band count starts from silence."""
+    follower.process(np.ones(BANDS, dtype=np.float32), 10.0)
+    follower.process(np.zeros(BANDS, dtype=np.float32), 0.0)
+    np.testing.assert_allclose(follower.envelope, 1.0)
+
+    follower.process(np.ones(BANDS // 2, dtype=np.float32), 0.0)
+    assert follower.size == BANDS // 2
+    np.testing.assert_array_equal(follower.peaks, 0.0)
+
+
+def test_peak_markers_sit_on_bar_tops() -> None:
+    """Test that peak markers for the bar magnitudes cover the top rows of the bars."""
+    width, height = 160, 120
+    magnitudes = np.full(BANDS, 0.05, dtype=np.float32)
+    renderer = libaudioviz.Renderer(width, height)
+    renderer.initialize_headless()
+
+    renderer.clear(0, 0, 0, 255)
+    renderer.draw_bars(magnitudes, 0, 255, 0, 255, mirror=False)
+    renderer.draw_peak_markers(magnitudes, 255, 255, 255, 255, thickness=2, mirror=False)
+    renderer.present()
+    pixels = renderer.read_pixels()
+
+    column = pixels[:, 0, :3]
+    lit = np.flatnonzero(column.any(axis=1))
+    top = lit[0]
+    np.testing.assert_array_equal(column[top:top + 2], 255)
+    np.testing.assert_array_equal(column[top + 2:, 1], 255)
+    assert np.all(column[top + 2:, 0] == 0)
@@ -0,0 +1,54 @@
+"""Tests for headless rendering and offline frame export."""
+
+import io
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+import libaudioviz
+from audioviz.audioviz.audio import audio_info
+from audioviz.audioviz.export import export_video, frame_schedule, video_frame_count
+
+
+def test_frame_schedule_follows_stft_hops(sample_rate: int) -> None:
+    """Test that video frames map to the nearest STFT frame and stay in range."""
+    num_samples = sample_rate * 2
+    hop = 512
+    stft_frames = libaudioviz.StreamingSTFT.frame_count(num_samples, 1024, hop)
+
+    schedule = list(frame_schedule(num_samples, sample_rate, 30.0, hop, stft_frames))
+
+    assert len(schedule) == video_frame_count(num_samples, sample_rate, 30.0) == 60
+    assert schedule[0] == 0
+    assert schedule[30] == round(sample_rate / hop)
+    assert all(a <= b for a, b in zip(schedule, schedule[1:]))
+    assert max(schedule) < stft_frames
+
+
+def test_headless_renderer_reads_back_clear_color() -> None:
+    """Test that a headless frame can be read back as RGBA pixels."""
+    renderer = libaudioviz.Renderer(64, 48)
+    renderer.initialize_headless()
+
+    renderer.clear(10, 20, 30, 255)
+    renderer.draw_rectangles(np.array([[0, 0, 8, 4]], dtype=np.int32), 255, 0, 0, 255)
+    renderer.present()
+    pixels = renderer.read_pixels()
+
+    assert renderer.is_headless()
+    assert pixels.shape == (48, 64, 4)
+    assert pixels.dtype == np.uint8
+    np.testing.assert_array_equal(pixels[0, 0], [255, 0, 0, 255])
+    np.testing.assert_array_equal(pixels[47, 63], [10, 20, 30, 255])
+
+
+def test_export_video_writes_every_frame(sample_wav_file: Path) -> None:
+    """Test that export writes one full RGBA frame per video frame."""
+    info = audio_info(sample_wav_file)
+    sink = io.BytesIO()
+
+    frames = export_video(str(sample_wav_file), info, sink, fps=24.0, width=160, height=120)
+
+    assert frames == video_frame_count(info.frames, info.sample_rate, 24.0)
+    assert len(sink.getvalue()) == frames * 160 * 120 * 4
@@ -0,0 +1,60 @@
+"""Tests that steady-state frames do not allocate in the native renderer."""
+
+import numpy as np
+
+import libaudioviz
+
+
+def draw_frame(renderer: libaudioviz.Renderer, magnitudes: np.ndarray) -> None:
+    """One frame touching every recording path: lists, arrays, kernels, events."""
+    renderer.clear(0, 0, 0, 255)
+    renderer.draw_rectangles([libaudioviz.Rect(i, 0, 2, 10) for i in range(0, 200, 4)], 255, 0, 0, 255)
+    renderer.draw_lines([libaudioviz.Line(0, i, 100, i) for i in range(0, 100, 5)], 0, 255, 0, 255)
+    renderer.draw_rectangles(np.array([[0, 0, 4, 4]] * 64, dtype=np.int32), 0, 0, 255, 255)
+    renderer.draw_bars(magnitudes, 255, 255, 255, 255)
+    renderer.draw_radial(magnitudes, 255, 255, 0, 255)
+    renderer.draw_waterfall(magnitudes, history=128)
+    renderer.poll_events()
+    renderer.present()
+
+
+def test_steady_state_frames_make_no_heap_allocations() -> None:
+    """Test that the allocation counter stays flat once frames are warmed up."""
+    renderer = libaudioviz.Renderer(320, 240)
+    renderer.initialize_headless()
+    rng = np.random.default_rng(0)
+    
+    for _ in range(5):
+        draw_frame(renderer, rng.random(513, dtype=np.float32))
+    warmed_up = renderer.heap_allocations()
+    for _ in range(200):
+        draw_frame(renderer, rng.random(513, dtype=np.float32))
+    
+    assert warmed_up > 0
+    assert renderer.heap_allocations() == warmed_up
+    assert renderer.get_stats()['heap_allocations'] == warmed_up
+
+
+def test_list_and_array_draws_accept_empty_batches() -> None:
+    """Test that empty batches are accepted by both binding paths."""
+    renderer = libaudioviz.Renderer(64, 64)
+    renderer.initialize_headless()
+    
+    renderer.draw_rectangles([], 0, 0, 0, 255)
+    renderer.draw_lines(np.empty((0, 4), dtype=np.int32), 0, 0, 0, 255)
+    renderer.present()
+
+
+def test_default_dtype_arrays_are_converted() -> None:
+    """Test that int64 and float arrays still take the array path instead of failing as sequences."""
+    renderer = libaudioviz.Renderer(16, 16)
+    renderer.initialize_headless()
+
+    renderer.clear(0, 0, 0, 255)
+    renderer.draw_rectangles(np.array([[0, 0, 4, 4]]), 255, 0, 0, 255)
+    renderer.draw_lines(np.array([[0.0, 8.0, 15.0, 8.0]]), 0, 255, 0, 255)
+    renderer.present()
+
+    pixels = renderer.read_pixels()
+    assert pixels[1, 1, 0] == 255
+    assert pixels[8, 4, 1] == 255
@@ -0,0 +1,122 @@
+"""Tests for the playback-clock-driven frame scheduler."""
+
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+import libaudioviz
+from audioviz.audioviz.cache import CachedSpectrum
+
+
+RATE = 48000
+NPERSEG = 1024
+HOP = 512
+
+
+def test_holds_until_the_next_frame_is_due() -> None:
+    """Test that an unchanged frame is held, with the wait until the next one."""
+    scheduler = libaudioviz.FrameScheduler(RATE, NPERSEG, HOP)
+
+    first = scheduler.tick(NPERSEG // 2)
+    again = scheduler.tick(NPERSEG // 2 + 100)
+    after = scheduler.tick(NPERSEG // 2 + HOP)
+
+    assert (first.render, first.frame) == (True, 0)
+    assert (again.render, again.frame) == (False, 0)
+    assert again.wait_ms == pytest.approx((HOP - 100) * 1000.0 / RATE)
+    assert (after.render, after.frame) == (True, 1)
+
+
+def test_renders_blank_once_before_the_first_frame() -> None:
+    """Test that frame -1 is drawn once and then held until frame 0 is complete."""
+    scheduler = libaudioviz.FrameScheduler(RATE, NPERSEG, HOP)
+
+    assert scheduler.tick(0).render
+    held = scheduler.tick(10)
+    assert (held.render, held.frame) == (False, -1)
+    assert held.wait_ms == pytest.approx((NPERSEG // 2 - 10) * 1000.0 / RATE)
+
+
+def test_force_renders_an_unchanged_frame() -> None:
+    """Test that force redraws the shown frame without counting a skip."""
+    scheduler = libaudioviz.FrameScheduler(RATE, NPERSEG, HOP)
+    scheduler.tick(NPERSEG)
+
+    tick = scheduler.tick(NPERSEG, force=True)
+
+    assert tick.render
+    assert tick.skipped == 0
+
+
+def test_stale_frames_are_skipped() -> None:
+    """Test that only the newest due frame is drawn and the jumped frames are counted."""
+    scheduler = libaudioviz.FrameScheduler(RATE, NPERSEG, HOP)
+    scheduler.tick(scheduler.frame_end(2))
+
+    tick = scheduler.tick(scheduler.frame_end(7))
+
+    assert (tick.frame, tick.skipped) == (7, 4)
+    assert scheduler.summary()['skipped'] == 4
+
+
+def test_display_latency_leads_the_played_position() -> None:
+    """Test that the frame shown is the one due when the image reaches the screen."""
+    latency_ms = 1000.0 * 3 * HOP / RATE
+    scheduler = libaudioviz.FrameScheduler(RATE, NPERSEG, HOP, display_latency_ms=latency_ms)
+
+    assert scheduler.tick(scheduler.frame_end(1)).frame == 4
+
+
+def test_interpolation_renders_between_frames() -> None:
+    """Test that interpolation reports the position between frames and only holds when paused."""
+    scheduler = libaudioviz.FrameScheduler(RATE, NPERSEG, HOP, interpolate=True)
+
+    tick = scheduler.tick(scheduler.frame_end(3) + HOP // 4)
+    paused = scheduler.tick(scheduler.frame_end(3) + HOP // 4)
+
+    assert (tick.render, tick.frame) == (True, 3)
+    assert tick.fraction == pytest.approx(0.25)
+    assert not paused.render
+
+
+def test_pacing_jitter_from_present_intervals() -> None:
+    """Test that jitter is the spread of present-to-present intervals."""
+    scheduler = libaudioviz.FrameScheduler(RATE, NPERSEG, HOP)
+    for at_ms in (0.0, 16.0, 32.0, 50.0, 64.0):
+        scheduler.frame_presented(at_ms)
+
+    intervals = np.array([16.0, 16.0, 18.0, 14.0])
+    summary = scheduler.summary()
+
+    assert summary['presents'] == 5
+    assert summary['mean_interval_ms'] == pytest.approx(intervals.mean())
+    assert summary['jitter_ms'] == pytest.approx(intervals.std())
+    assert summary['max_deviation_ms'] == pytest.approx(2.0)
+
+
+def test_invalid_configuration_raises() -> None:
+    """Test that a zero hop or sample rate is rejected."""
+    with pytest.raises(ValueError):
+        libaudioviz.FrameScheduler(RATE, NPERSEG, 0)
+    with pytest.raises(ValueError):
+        libaudioviz.FrameScheduler(0, NPERSEG, HOP)
+
+
+def test_cached_spectrum_interpolates_between_frames(tmp_path: Path) -> None:
+    """Test that CachedSpectrum.interpolate blends neighbouring frames and holds the last."""
+    bins = NPERSEG // 2 + 1
+    frames = np.stack([np.full((1, bins), 10.0 ** -(i + 1), dtype=np.float32) for i in range(3)])
+    path = tmp_path / "blend.avzspec"
+    writer = libaudioviz.SpectrogramCacheWriter(str(path), NPERSEG, HOP, 1, RATE, bytes(32))
+    for frame in frames:
+        writer.append(frame)
+    writer.commit()
+    cache = libaudioviz.SpectrogramCache(str(path))
+    spectrum = CachedSpectrum(cache)
+
+    first, second = cache.frame(0), cache.frame(1)
+    blended = spectrum.interpolate(0, 0.25)
+
+    np.testing.assert_allclose(blended, first + 0.25 * (second - first), rtol=1e-6)
+    np.testing.assert_array_equal(spectrum.interpolate(5, 0.5), cache.frame(2))
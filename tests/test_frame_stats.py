@@ -0,0 +1,55 @@
+"""Tests for the renderer's frame-time instrumentation."""
+
+import time
+
+import numpy as np
+
+import libaudioviz
+
+
+def render_frames(renderer: libaudioviz.Renderer, count: int, sleep_every: int = 0) -> None:
+    """Render `count` small frames, stalling every `sleep_every` frames."""
+    rects = np.array([[0, 0, 8, 8], [16, 0, 8, 8]], dtype=np.int32)
+    for i in range(count):
+        renderer.clear(0, 0, 0, 255)
+        renderer.draw_rectangles(rects, 255, 255, 255, 255)
+        if sleep_every and i % sleep_every == sleep_every - 1:
+            time.sleep(0.05)
+        renderer.present()
+
+
+def test_stats_count_every_stage() -> None:
+    """Test that each instrumented call contributes one sample to its stage."""
+    renderer = libaudioviz.Renderer(64, 64)
+    renderer.initialize_headless()
+    
+    render_frames(renderer, 20)
+    renderer.poll_events()
+    stats = renderer.get_stats()
+    
+    assert stats['frames'] == 20
+    assert stats['stages']['clear']['count'] == 20
+    assert stats['stages']['draw']['count'] == 20
+    assert stats['stages']['present']['count'] == 20
+    assert stats['stages']['frame']['count'] == 19
+    assert stats['stages']['events']['count'] == 1
+    for stage in stats['stages'].values():
+        if stage['count']:
+            assert 0.0 <= stage['p50_ms'] <= stage['p95_ms'] <= stage['p99_ms'] <= stage['max_ms']
+
+
+def test_stats_flag_late_frames_against_target() -> None:
+    """Test that stalled frames are counted as late once a target is set."""
+    renderer = libaudioviz.Renderer(64, 64)
+    renderer.initialize_headless()
+    renderer.set_target_fps(60.0)
+    
+    render_frames(renderer, 12, sleep_every=4)
+    stats = renderer.get_stats()
+    
+    assert stats['late_frames'] >= 3
+    assert stats['dropped_frames'] >= stats['late_frames']
+    assert renderer.last_frame_ms() > 0.0
+    
+    renderer.reset_stats()
+    assert renderer.get_stats()['frames'] == 0
@@ -0,0 +1,60 @@
+"""Tests for the registry of templated native visualizer kernels."""
+
+from typing import Callable
+
+import numpy as np
+import pytest
+
+import libaudioviz
+from audioviz.audioviz.visualizers import MODE_ORDER
+
+
+WIDTH, HEIGHT = 320, 240
+
+
+@pytest.fixture
+def magnitudes() -> np.ndarray:
+    """Random magnitudes spanning the visible dB range."""
+    return np.random.default_rng(0).uniform(0, 0.1, 200).astype(np.float32)
+
+
+def test_builtin_modes_are_registered() -> None:
+    """Test that the built-in modes are registered natively and cycle in order."""
+    modes = libaudioviz.visualizer_modes()
+    assert {"bars", "circle"} <= set(modes)
+    assert set(modes) <= set(MODE_ORDER)
+
+
+def test_unknown_mode_raises() -> None:
+    """Test that making a kernel for an unregistered mode raises ValueError."""
+    with pytest.raises(ValueError, match="nope"):
+        libaudioviz.Visualizer("nope")
+
+
+@pytest.mark.parametrize("mirror", [True, False])
+@pytest.mark.parametrize("log_scale", [True, False])
+def test_bar_kernel_matches_draw_bars(
+    render_headless: Callable[..., np.ndarray], magnitudes: np.ndarray, mirror: bool, log_scale: bool,
+) -> None:
+    """Test that every bar specialisation draws the same pixels as draw_bars."""
+    kernel = libaudioviz.Visualizer("bars", mirror=mirror, log_scale=log_scale, scale=0.8)
+
+    actual = render_headless(WIDTH, HEIGHT, lambda r: kernel.draw(r, magnitudes, 0, 255, 0, 255))
+    expected = render_headless(WIDTH, HEIGHT, lambda r: r.draw_bars(
+        magnitudes, 0, 255, 0, 255, scale=0.8, mirror=mirror, log_scale=log_scale))
+    np.testing.assert_array_equal(actual, expected)
+    assert actual[..., 1].any()
+
+
+@pytest.mark.parametrize("mirror", [True, False])
+def test_radial_kernel_matches_draw_radial(
+    render_headless: Callable[..., np.ndarray], magnitudes: np.ndarray, mirror: bool,
+) -> None:
+    """Test that the radial kernel draws the same pixels as draw_radial, mirrored or not."""
+    kernel = libaudioviz.Visualizer("circle", mirror=mirror, base_radius_ratio=0.3)
+
+    actual = render_headless(WIDTH, HEIGHT, lambda r: kernel.draw(r, magnitudes, 0, 255, 255, 255))
+    expected = render_headless(WIDTH, HEIGHT, lambda r: r.draw_radial(
+        magnitudes, 0, 255, 255, 255, base_radius_ratio=0.3, mirror=mirror))
+    np.testing.assert_array_equal(actual, expected)
+    assert actual[..., 2].any()
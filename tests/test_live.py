@@ -0,0 +1,72 @@
+"""Tests for live-input analysis and the mic-to-photon latency stage."""
+
+import numpy as np
+import pytest
+
+import libaudioviz
+from audioviz.audioviz.analysis import RingSpectrum
+
+
+NPERSEG, HOP = 512, 128
+
+
+def tone(frames: int) -> np.ndarray:
+    """A mono test tone of `frames` samples."""
+    return np.sin(0.05 * np.arange(frames, dtype=np.float32)).astype(np.float32)
+
+
+def test_newest_frame_end_follows_analysed_frames() -> None:
+    """Test that the newest frame's end sits on the STFT grid of the samples read."""
+    ring = libaudioviz.SampleRing(8192, 1)
+    spectrum = RingSpectrum(ring, NPERSEG, HOP)
+    assert spectrum.newest_frame_end() is None
+
+    ring.push(tone(1000))
+    spectrum.advance(1000)
+
+    # Frame k ends at k * hop + nperseg / 2 and needs every sample before it
+    assert spectrum.frames == (1000 - NPERSEG // 2) // HOP + 1
+    end = spectrum.newest_frame_end()
+    assert end == (spectrum.frames - 1) * HOP + NPERSEG // 2
+    assert end <= spectrum.consumed < end + HOP
+
+
+def test_catch_up_drops_backlog_and_restarts() -> None:
+    """Test that catch_up skips stale audio so the next frames end at the newest samples."""
+    ring = libaudioviz.SampleRing(8192, 1)
+    spectrum = RingSpectrum(ring, NPERSEG, HOP)
+    ring.push(tone(5000))
+
+    dropped = spectrum.catch_up(NPERSEG)
+    assert dropped == 5000 - NPERSEG
+    assert spectrum.consumed == dropped
+    assert spectrum.catch_up(NPERSEG) == 0
+
+    frames_before = spectrum.frames
+    spectrum.advance(spectrum.consumed + ring.available)
+    assert spectrum.frames > frames_before
+    assert 5000 - HOP < spectrum.newest_frame_end() <= 5000
+
+
+def test_capture_time_records_latency_stage() -> None:
+    """Test that a frame marked with a capture time records its age at the swap, and unmarked ones do not."""
+    renderer = libaudioviz.Renderer(64, 64)
+    renderer.initialize_headless()
+
+    renderer.clear(0, 0, 0, 255)
+    renderer.set_capture_time(libaudioviz.FrameScheduler.now_ms() - 30.0)
+    renderer.present()
+    renderer.clear(0, 0, 0, 255)
+    renderer.present()
+
+    latency = renderer.get_stats()['stages']['latency']
+    assert latency['count'] == 1
+    assert latency['max_ms'] >= 30.0
+
+
+def test_audio_capture_rejects_bad_parameters() -> None:
+    """Test that capture parameters are validated before any device is opened."""
+    with pytest.raises(ValueError):
+        libaudioviz.AudioCapture(sample_rate=0)
+    with pytest.raises(ValueError):
+        libaudioviz.AudioCapture(period=0)
@@ -0,0 +1,67 @@
+"""Tests for several outputs drawing one shared analysis frame."""
+
+import numpy as np
+import pytest
+
+import libaudioviz
+from audioviz.audioviz.outputs import Output, OutputSpec
+from audioviz.audioviz.quality import QualityLevel
+
+
+@pytest.fixture
+def magnitudes() -> np.ndarray:
+    """Random magnitudes spanning the visible dB range."""
+    return np.random.default_rng(0).uniform(0, 0.1, 128).astype(np.float32)
+
+
+def headless(spec: OutputSpec) -> Output:
+    """An offscreen output for `spec` with auto-switching off."""
+    return Output(spec, auto_switch_interval=None, headless=True)
+
+
+def test_parse_output_spec() -> None:
+    """Test that output specs parse mode, optional size and optional display."""
+    assert OutputSpec.parse("bars") == OutputSpec("bars")
+    assert OutputSpec.parse("circle:640x360") == OutputSpec("circle", 640, 360, 0)
+    assert OutputSpec.parse("bars:1920x1080@2") == OutputSpec("bars", 1920, 1080, 2)
+    assert OutputSpec.parse("circle@1") == OutputSpec("circle", display=1)
+
+
+@pytest.mark.parametrize("text", ["", "bars:640", "bars:0x100", "bars@x", "nope:640x360"])
+def test_parse_rejects_bad_specs(text: str) -> None:
+    """Test that malformed specs and unknown modes raise ValueError."""
+    with pytest.raises(ValueError):
+        OutputSpec.parse(text)
+
+
+def test_outputs_draw_shared_frame_in_own_mode(magnitudes: np.ndarray) -> None:
+    """Test that outputs of different modes and sizes each match a lone renderer drawing the same frame."""
+    specs = [OutputSpec("bars", 320, 240), OutputSpec("circle", 200, 200), OutputSpec("bars", 160, 120)]
+    outputs = [headless(spec) for spec in specs]
+    before = magnitudes.copy()
+    level = QualityLevel(len(magnitudes))
+
+    # Interleaved, so per-mode caches see alternating window sizes
+    for _ in range(2):
+        for output in outputs:
+            output.draw(magnitudes, level)
+    np.testing.assert_array_equal(magnitudes, before)
+
+    for spec, output in zip(specs, outputs):
+        alone = headless(spec)
+        alone.draw(magnitudes, level)
+        pixels = output.renderer.read_pixels()
+        assert pixels.shape[:2] == (spec.height, spec.width)
+        assert pixels[..., :3].any()
+        np.testing.assert_array_equal(pixels, alone.renderer.read_pixels())
+        assert output.shown_mode == spec.mode
+
+
+def test_headless_output_polls_nothing() -> None:
+    """Test that a headless output has no window id and no events, so one poll only forces its first frame."""
+    output = headless(OutputSpec("circle", 160, 120))
+    assert output.renderer.window_id == 0
+    assert output.poll()
+    output.draw(np.zeros(64, dtype=np.float32), QualityLevel(64))
+    assert not output.poll()
+    assert output.running
@@ -0,0 +1,109 @@
+"""Tests for the adaptive level-of-detail controller."""
+
+import pytest
+
+from audioviz.audioviz.quality import (
+    QualityController,
+    QualityControllerConfig,
+    QualityLevel,
+    quality_ladder,
+)
+
+
+BUDGET_MS = 16.7
+CONFIG = QualityControllerConfig(cooldown_frames=10, recover_frames=50, max_recover_frames=400)
+
+
+def feed(controller: QualityController, frame_ms: float, frames: int) -> QualityLevel:
+    level = controller.level
+    for _ in range(frames):
+        level = controller.update(frame_ms)
+    return level
+
+
+def test_ladder_drops_mirroring_before_bands() -> None:
+    """Test that the ladder turns mirroring off first, then halves the bands."""
+    assert quality_ladder(128) == [
+        QualityLevel(128, True),
+        QualityLevel(128, False),
+        QualityLevel(64, False),
+        QualityLevel(32, False),
+        QualityLevel(16, False),
+    ]
+
+
+def test_on_budget_frames_keep_full_detail() -> None:
+    """Test that frames at the refresh interval never lower detail."""
+    controller = QualityController(quality_ladder(128), BUDGET_MS, CONFIG)
+
+    assert feed(controller, BUDGET_MS, 1000) == QualityLevel(128, True)
+    assert controller.changes == 0
+
+
+def test_overrun_steps_down_once_per_cooldown() -> None:
+    """Test that sustained overruns lower detail one level per cooldown period."""
+    controller = QualityController(quality_ladder(128), BUDGET_MS, CONFIG)
+
+    feed(controller, 2 * BUDGET_MS, 1)
+    assert controller.level_index == 0
+    feed(controller, 2 * BUDGET_MS, CONFIG.cooldown_frames)
+    assert controller.level_index == 1
+    feed(controller, 2 * BUDGET_MS, CONFIG.cooldown_frames)
+    assert controller.level_index == 2
+
+
+def test_single_spike_is_smoothed_out() -> None:
+    """Test that one long frame does not trigger a change."""
+    controller = QualityController(quality_ladder(128), BUDGET_MS, CONFIG)
+    feed(controller, BUDGET_MS, 100)
+
+    controller.update(3 * BUDGET_MS)
+    feed(controller, BUDGET_MS, 100)
+
+    assert controller.changes == 0
+
+
+def frames_until_change(controller: QualityController, frame_ms: float, limit: int = 10000) -> int:
+    index = controller.level_index
+    for frames in range(1, limit + 1):
+        controller.update(frame_ms)
+        if controller.level_index != index:
+            return frames
+    return limit
+
+
+def test_headroom_restores_detail_after_recovery_period() -> None:
+    """Test that detail comes back one level, and only after the recovery period."""
+    controller = QualityController(quality_ladder(128), BUDGET_MS, CONFIG)
+    feed(controller, 2 * BUDGET_MS, 100)
+    lowered = controller.level_index
+    assert lowered > 0
+
+    assert frames_until_change(controller, BUDGET_MS) >= CONFIG.recover_frames
+    assert controller.level_index == lowered - 1
+
+
+def test_failed_step_up_backs_off() -> None:
+    """Test that a step up that overruns again makes the next one wait longer."""
+    controller = QualityController(quality_ladder(128), BUDGET_MS, CONFIG)
+    feed(controller, 2 * BUDGET_MS, CONFIG.cooldown_frames + 5)
+    assert controller.level_index == 1
+
+    # Full detail costs too much: recover, step up, overrun, step down again
+    first_wait = frames_until_change(controller, BUDGET_MS)
+    assert controller.level_index == 0
+    frames_until_change(controller, 2 * BUDGET_MS)
+    assert controller.level_index == 1
+
+    second_wait = frames_until_change(controller, BUDGET_MS)
+    assert controller.level_index == 0
+    assert second_wait > first_wait
+    assert second_wait >= 2 * CONFIG.recover_frames
+
+
+def test_invalid_arguments_raise() -> None:
+    """Test that an empty ladder or a non-positive budget is rejected."""
+    with pytest.raises(ValueError):
+        QualityController([], BUDGET_MS)
+    with pytest.raises(ValueError):
+        QualityController(quality_ladder(64), 0.0)
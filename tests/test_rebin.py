@@ -0,0 +1,96 @@
+"""Tests for the native log/mel/bark band rebinner."""
+
+import numpy as np
+import pytest
+
+import libaudioviz
+from audioviz.audioviz.analysis import band_rebinner
+
+
+NPERSEG = 1024
+BINS = NPERSEG // 2 + 1
+SAMPLE_RATE = 44100
+
+
+@pytest.mark.parametrize("scale", ["log", "mel", "bark"])
+def test_flat_spectrum_stays_flat(scale: str) -> None:
+    """Test that unit-sum weights map a constant spectrum to the same constant."""
+    rebinner = libaudioviz.BandRebinner(BINS, SAMPLE_RATE, 64, scale)
+    magnitudes = np.full(BINS, 0.25, dtype=np.float32)
+
+    bands = rebinner.apply(magnitudes)
+
+    assert bands.shape == (64,)
+    np.testing.assert_allclose(bands, 0.25, rtol=1e-5)
+
+
+@pytest.mark.parametrize("scale", ["log", "mel", "bark"])
+def test_centres_are_increasing_within_range(scale: str) -> None:
+    """Test that band centres run from fmin to Nyquist in increasing order."""
+    rebinner = libaudioviz.BandRebinner(BINS, SAMPLE_RATE, 48, scale, fmin=30.0)
+    centres = rebinner.center_frequencies
+
+    assert np.all(np.diff(centres) > 0)
+    assert centres[0] == pytest.approx(30.0, rel=1e-3)
+    assert centres[-1] == pytest.approx(SAMPLE_RATE / 2, rel=1e-3)
+
+
+def test_tone_peaks_in_nearest_band() -> None:
+    """Test that a single-bin tone lands in the band centred closest to it."""
+    rebinner = libaudioviz.BandRebinner(BINS, SAMPLE_RATE, 64)
+    magnitudes = np.zeros(BINS, dtype=np.float32)
+    magnitudes[100] = 1.0
+    tone_hz = 100 * SAMPLE_RATE / NPERSEG
+
+    bands = rebinner.apply(magnitudes)
+
+    centres = np.log(rebinner.center_frequencies)
+    assert np.argmax(bands) == np.argmin(np.abs(centres - np.log(tone_hz)))
+
+
+def test_narrow_low_bands_are_not_empty() -> None:
+    """Test that bands narrower than one bin interpolate rather than read zero."""
+    rebinner = libaudioviz.BandRebinner(BINS, SAMPLE_RATE, 256, fmin=20.0)
+    magnitudes = np.linspace(1.0, 2.0, BINS, dtype=np.float32)
+
+    bands = rebinner.apply(magnitudes)
+
+    assert np.all(bands > 0.99)
+
+
+def test_sparse_cost_is_bounded() -> None:
+    """Test that the weight matrix stores at most two taps per bin and per band."""
+    rebinner = libaudioviz.BandRebinner(BINS, SAMPLE_RATE, 128, "mel")
+
+    assert rebinner.taps <= 2 * BINS + 2 * rebinner.bands
+
+
+def test_apply_matches_per_channel_and_writes_out() -> None:
+    """Test that (channels, bins) input is rebinned row by row into `out`."""
+    rebinner = libaudioviz.BandRebinner(BINS, SAMPLE_RATE, 32, "bark")
+    rng = np.random.default_rng(0)
+    frame = rng.random((2, BINS), dtype=np.float32)
+    out = np.empty((2, 32), dtype=np.float32)
+
+    result = rebinner.apply(frame, out=out)
+
+    assert result is out or np.shares_memory(result, out)
+    np.testing.assert_array_equal(out[1], rebinner.apply(frame[1]))
+
+
+def test_invalid_arguments_raise() -> None:
+    """Test that bad shapes, scales and ranges are rejected."""
+    with pytest.raises(ValueError):
+        libaudioviz.BandRebinner(BINS, SAMPLE_RATE, 32, "octave")
+    with pytest.raises(ValueError):
+        libaudioviz.BandRebinner(BINS, SAMPLE_RATE, 32, fmin=0.0)
+    with pytest.raises(ValueError):
+        libaudioviz.BandRebinner(BINS, SAMPLE_RATE, 0)
+    with pytest.raises(ValueError):
+        libaudioviz.BandRebinner(BINS, SAMPLE_RATE, 32).apply(np.zeros(BINS - 1, dtype=np.float32))
+
+
+def test_band_rebinner_disabled_for_zero_bands() -> None:
+    """Test that the helper returns None when rebinning is turned off."""
+    assert band_rebinner(NPERSEG, SAMPLE_RATE, 0) is None
+    assert band_rebinner(NPERSEG, SAMPLE_RATE, 16, "mel").bands == 16
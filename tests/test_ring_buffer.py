@@ -0,0 +1,51 @@
+"""Tests for the native SPSC sample ring buffer."""
+
+import numpy as np
+import pytest
+
+import libaudioviz
+
+
+def test_sample_ring_round_trip(stereo_channels: int) -> None:
+    """Test that samples come out in order across the wrap-around point."""
+    ring = libaudioviz.SampleRing(1000, stereo_channels)
+    samples = np.arange(2 * 700 * stereo_channels, dtype=np.float32).reshape(-1, stereo_channels)
+    
+    received = []
+    for block in np.split(samples, 2):
+        assert ring.push(block) == len(block)
+        received.append(ring.pop(len(block)))
+    
+    np.testing.assert_array_equal(np.concatenate(received), samples)
+    assert ring.frames_written == len(samples)
+
+
+@pytest.mark.parametrize("capacity_frames, channels", [(16, 0), (0, 1)])
+def test_sample_ring_rejects_empty_shape(capacity_frames: int, channels: int) -> None:
+    """Test that a ring without frames or channels is refused."""
+    with pytest.raises(ValueError):
+        libaudioviz.SampleRing(capacity_frames, channels)
+
+
+def test_sample_ring_drops_when_full() -> None:
+    """Test that a full ring accepts what fits and counts the rest as dropped."""
+    ring = libaudioviz.SampleRing(16, 1)
+    
+    accepted = ring.push(np.ones(ring.capacity + 5, dtype=np.float32))
+    
+    assert accepted == ring.capacity
+    assert ring.available == ring.capacity
+    assert ring.frames_dropped == 5
+
+
+def test_sample_ring_pop_into_preallocated() -> None:
+    """Test that pop_into fills a caller-owned buffer and reports the count."""
+    ring = libaudioviz.SampleRing(64, 1)
+    ring.push(np.arange(10, dtype=np.float32))
+    out = np.zeros((32, 1), dtype=np.float32)
+    
+    n = ring.pop_into(out)
+    
+    assert n == 10
+    np.testing.assert_array_equal(out[:n, 0], np.arange(10))
+    assert ring.available == 0
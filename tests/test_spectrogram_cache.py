@@ -0,0 +1,169 @@
+"""Tests for the memory-mapped spectrogram cache."""
+
+import os
+from pathlib import Path
+import threading
+
+import numpy as np
+import pytest
+import soundfile as sf
+
+import libaudioviz
+from audioviz.audioviz.analysis import SpectrumStream
+from audioviz.audioviz.audio import audio_info, stream_audio
+from audioviz.audioviz.cache import (
+    BackgroundCacheBuild, CachedSpectrum, build_cache, cache_path, file_key, load_cache, open_cache,
+)
+
+
+NPERSEG = 1024
+HOP = 512
+
+
+def to_db(magnitudes: np.ndarray) -> np.ndarray:
+    return 20.0 * np.log10(np.asarray(magnitudes, dtype=np.float64) + 1e-10)
+
+
+def test_cache_round_trip_within_quantisation_step(tmp_path: Path) -> None:
+    """Test that frames decode to within half a uint8 dB step inside the range."""
+    rng = np.random.default_rng(0)
+    frames = 10.0 ** rng.uniform(-5.5, 0, (20, 2, NPERSEG // 2 + 1))
+    frames = frames.astype(np.float32)
+    path = tmp_path / "round_trip.avzspec"
+
+    writer = libaudioviz.SpectrogramCacheWriter(str(path), NPERSEG, HOP, 2, 44100, bytes(32))
+    for frame in frames:
+        writer.append(frame)
+    writer.commit()
+    cache = libaudioviz.SpectrogramCache(str(path))
+
+    assert (cache.frames, cache.channels, cache.bins) == (20, 2, NPERSEG // 2 + 1)
+    assert cache.codes.shape == (20, 2, NPERSEG // 2 + 1)
+    assert not cache.codes.flags.writeable
+    step_db = 120.0 / 255.0
+    np.testing.assert_allclose(to_db(cache.frame(7)), to_db(frames[7]), atol=step_db / 2 + 1e-3)
+    with pytest.raises(IndexError):
+        cache.frame(20)
+
+
+def test_uncommitted_writer_leaves_no_file(tmp_path: Path) -> None:
+    """Test that an abandoned writer removes its temporary file."""
+    path = tmp_path / "abandoned.avzspec"
+    writer = libaudioviz.SpectrogramCacheWriter(str(path), NPERSEG, HOP, 1, 44100, bytes(32))
+    writer.append(np.zeros((1, NPERSEG // 2 + 1), dtype=np.float32))
+    del writer
+
+    assert list(tmp_path.iterdir()) == []
+
+
+def test_open_cache_builds_once_and_reuses(stereo_wav_file: Path, tmp_path: Path) -> None:
+    """Test that the first open analyses the file and the second maps the result."""
+    info = audio_info(stereo_wav_file)
+    directory = tmp_path / "cache"
+
+    first = open_cache(stereo_wav_file, info, NPERSEG, HOP, directory)
+    path = cache_path(file_key(stereo_wav_file), NPERSEG, HOP, directory)
+    built_at = path.stat().st_mtime_ns
+    second = open_cache(stereo_wav_file, info, NPERSEG, HOP, directory)
+
+    assert path.stat().st_mtime_ns == built_at
+    assert first.frames == second.frames == libaudioviz.StreamingSTFT.frame_count(info.frames, NPERSEG, HOP)
+    np.testing.assert_array_equal(first.codes, second.codes)
+
+
+def test_file_key_follows_size_mtime_and_ends(tmp_path: Path) -> None:
+    """Test that the key is stable for an untouched file and changes when it is rewritten."""
+    path = tmp_path / "track.bin"
+    path.write_bytes(bytes(3000))
+    key = file_key(path, block_size=1024)
+    assert file_key(path, block_size=1024) == key
+
+    # Same size and mtime, but a changed tail block
+    stat = path.stat()
+    path.write_bytes(bytes(2999) + b"\x01")
+    os.utime(path, ns=(stat.st_atime_ns, stat.st_mtime_ns))
+    assert file_key(path, block_size=1024) != key
+
+    # Touching the file alone also invalidates it
+    tail_key = file_key(path, block_size=1024)
+    os.utime(path, ns=(stat.st_atime_ns, stat.st_mtime_ns + 1_000_000_000))
+    assert file_key(path, block_size=1024) != tail_key
+
+
+def test_open_cache_rebuilds_corrupt_file(stereo_wav_file: Path, tmp_path: Path) -> None:
+    """Test that a truncated cache file is replaced instead of trusted."""
+    info = audio_info(stereo_wav_file)
+    path = cache_path(file_key(stereo_wav_file), NPERSEG, HOP, tmp_path)
+    path.write_bytes(b"AVZSPEC\0 truncated")
+
+    cache = open_cache(stereo_wav_file, info, NPERSEG, HOP, tmp_path)
+
+    assert cache.frames > 0
+    assert path.stat().st_size > 4096
+
+
+def test_cached_spectrum_matches_streaming_analysis(stereo_wav_file: Path, tmp_path: Path) -> None:
+    """Test that advance() picks the same frame as live analysis would."""
+    info = audio_info(stereo_wav_file)
+    spectrum = CachedSpectrum(open_cache(stereo_wav_file, info, NPERSEG, HOP, tmp_path))
+    stream = SpectrumStream(stream_audio(stereo_wav_file, dtype='float32'),
+                            info.frames, info.channels, NPERSEG, HOP)
+
+    assert not spectrum.advance(NPERSEG // 2 - 1).any()
+
+    played = 10 * HOP + NPERSEG // 2 + 100
+    cached = spectrum.advance(played).copy()
+    live = stream.frame(10)
+
+    loud = live > 1e-3
+    np.testing.assert_allclose(to_db(cached[loud]), to_db(live[loud]), atol=0.3)
+
+
+def test_background_build_matches_open_cache(stereo_wav_file: Path, tmp_path: Path) -> None:
+    """Test that a background build writes the same cache open_cache() would, and load_cache() finds it."""
+    info = audio_info(stereo_wav_file)
+    key = file_key(stereo_wav_file)
+    path = cache_path(key, NPERSEG, HOP, tmp_path / "background")
+    assert load_cache(path, key, info, NPERSEG, HOP) is None
+
+    build = BackgroundCacheBuild(stereo_wav_file, info, NPERSEG, HOP, path, key)
+    built = build.result()
+    expected = open_cache(stereo_wav_file, info, NPERSEG, HOP, tmp_path / "foreground")
+
+    assert build.done
+    np.testing.assert_array_equal(built.codes, expected.codes)
+    assert load_cache(path, key, info, NPERSEG, HOP) is not None
+
+
+def test_cancelled_build_writes_nothing(stereo_wav_file: Path, tmp_path: Path) -> None:
+    """Test that a cancelled build returns None and leaves no cache file."""
+    info = audio_info(stereo_wav_file)
+    key = file_key(stereo_wav_file)
+    path = cache_path(key, NPERSEG, HOP, tmp_path)
+    cancel = threading.Event()
+    cancel.set()
+
+    assert build_cache(stereo_wav_file, info, NPERSEG, HOP, path, key, cancel=cancel) is None
+    assert list(tmp_path.iterdir()) == []
+
+
+def test_decoded_formats_build_in_chunks(stereo_wav_file: Path, tmp_path: Path) -> None:
+    """Test that a FLAC build streams in chunks, matches the WAV build and can be cancelled."""
+    samples, sample_rate = sf.read(stereo_wav_file)
+    flac = tmp_path / "stereo.flac"
+    sf.write(flac, samples, sample_rate)
+    info = audio_info(flac)
+    key = file_key(flac)
+
+    cancel = threading.Event()
+    cancel.set()
+    path = cache_path(key, NPERSEG, HOP, tmp_path / "cancelled")
+    assert build_cache(flac, info, NPERSEG, HOP, path, key, cancel=cancel) is None
+    assert not path.exists()
+
+    built = build_cache(flac, info, NPERSEG, HOP, cache_path(key, NPERSEG, HOP, tmp_path), key, chunk_frames=7)
+    expected = open_cache(stereo_wav_file, audio_info(stereo_wav_file), NPERSEG, HOP, tmp_path / "wav")
+
+    assert built.frames == expected.frames
+    # Both files hold the same 16-bit samples; the two STFT paths may round differently
+    assert np.abs(built.codes.astype(np.int16) - expected.codes.astype(np.int16)).max() <= 1
@@ -0,0 +1,54 @@
+"""Tests for the native spectrum normalisation kernel."""
+
+import numpy as np
+import pytest
+
+import libaudioviz
+
+
+def reference_normalize(magnitudes: np.ndarray, db_floor: float, db_ceiling: float) -> np.ndarray:
+    """The NumPy formulation used by bars_visualizer."""
+    db_values = 20.0 * np.log10(magnitudes.astype(np.float64) + 1e-10)
+    return np.clip((db_values - db_floor) / (db_ceiling - db_floor), 0.0, 1.0)
+
+
+@pytest.fixture
+def bins() -> np.ndarray:
+    """Complex bins spanning a wide dynamic range, with an odd length to hit the tail loop."""
+    rng = np.random.default_rng(0)
+    scale = 10.0 ** rng.uniform(-5, 0, 1027)
+    return (rng.standard_normal(1027) + 1j * rng.standard_normal(1027)) * scale
+
+
+def test_normalize_db_matches_numpy_for_magnitudes(bins: np.ndarray) -> None:
+    """Test that float32 magnitudes normalise like the NumPy reference."""
+    magnitudes = np.abs(bins).astype(np.float32)
+    
+    heights = libaudioviz.normalize_db(magnitudes, -60.0, -10.0)
+    
+    assert heights.dtype == np.float32
+    assert heights.shape == magnitudes.shape
+    np.testing.assert_allclose(heights, reference_normalize(magnitudes, -60.0, -10.0), atol=1e-5)
+
+
+def test_normalize_db_fuses_complex_magnitude(bins: np.ndarray) -> None:
+    """Test that complex bins give the same heights as their magnitudes."""
+    heights = libaudioviz.normalize_db(bins.astype(np.complex64), -60.0, -10.0)
+    
+    np.testing.assert_allclose(heights, reference_normalize(np.abs(bins), -60.0, -10.0), atol=1e-5)
+
+
+def test_normalize_db_writes_into_out(bins: np.ndarray) -> None:
+    """Test that a preallocated output buffer is filled in place."""
+    magnitudes = np.abs(bins).astype(np.float32)
+    out = np.empty_like(magnitudes)
+    
+    result = libaudioviz.normalize_db(magnitudes, out=out)
+    
+    assert np.shares_memory(result, out)
+    assert np.all((out >= 0.0) & (out <= 1.0))
+
+
+def test_simd_backend_is_known() -> None:
+    """Test that the runtime dispatch reports a known kernel."""
+    assert libaudioviz.simd_backend() in {"avx2", "neon", "scalar"}
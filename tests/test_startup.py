@@ -0,0 +1,58 @@
+"""Tests for the startup timeline."""
+
+import threading
+import time
+
+from audioviz.audioviz.startup import StartupTimeline
+
+
+def test_phases_from_several_threads_are_recorded() -> None:
+    """Test that concurrent phases are all recorded, ordered by start, with overlapping spans."""
+    timeline = StartupTimeline()
+    started = threading.Barrier(3)
+
+    def run_phase(name: str) -> None:
+        """Hold the phase open until every thread has entered its own."""
+        with timeline.phase(name):
+            started.wait()
+            time.sleep(0.01)
+
+    workers = [threading.Thread(target=run_phase, args=(name,)) for name in ("audio", "cache lookup")]
+    for worker in workers:
+        worker.start()
+    run_phase("window")
+    for worker in workers:
+        worker.join()
+
+    phases = timeline.phases
+    assert sorted(span.name for span in phases) == ["audio", "cache lookup", "window"]
+    assert [span.start_ms for span in phases] == sorted(span.start_ms for span in phases)
+    assert all(span.duration_ms >= 10.0 for span in phases)
+    # Overlapping, so the whole startup is shorter than the phases back to back
+    assert max(span.end_ms for span in phases) < sum(span.duration_ms for span in phases)
+
+
+def test_phase_is_recorded_when_it_raises() -> None:
+    """Test that a phase that fails is still recorded."""
+    timeline = StartupTimeline()
+    try:
+        with timeline.phase("audio"):
+            raise RuntimeError("no device")
+    except RuntimeError:
+        pass
+    assert [span.name for span in timeline.phases] == ["audio"]
+
+
+def test_first_frame_is_marked_once() -> None:
+    """Test that first_frame() is True only on the first call and the report shows it."""
+    timeline = StartupTimeline(start=time.perf_counter() - 0.05)
+    assert timeline.first_frame_ms is None
+    assert "first frame" not in timeline.report()
+
+    assert timeline.first_frame()
+    marked = timeline.first_frame_ms
+    assert not timeline.first_frame()
+
+    assert timeline.first_frame_ms == marked
+    assert marked >= 50.0
+    assert "Time to first frame" in timeline.report()
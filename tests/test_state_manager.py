@@ -0,0 +1,75 @@
+"""Tests for event-driven state transitions."""
+
+import numpy as np
+
+import libaudioviz
+from audioviz.audioviz.state_manager import StateManager, StateManagerConfig
+from audioviz.audioviz.visualizers import MODE_ORDER, next_mode
+
+
+def make_events(*events: tuple[libaudioviz.EventType, int, int]) -> np.ndarray:
+    """Build a poll_events()-style record array."""
+    records = np.zeros(len(events), dtype=libaudioviz.EVENT_DTYPE)
+    for i, (event_type, data1, data2) in enumerate(events):
+        records[i] = (int(event_type), data1, data2, i)
+    return records
+
+
+def manager() -> StateManager:
+    return StateManager(StateManagerConfig(initial_mode="bars", auto_switch_interval=None))
+
+
+def test_no_events_keep_state() -> None:
+    """Test that an empty batch leaves the state untouched."""
+    state_manager = manager()
+    before = state_manager.state
+    
+    assert state_manager.update(make_events()) == before
+
+
+def test_last_resize_wins() -> None:
+    """Test that a burst of resizes applies only the final size."""
+    events = make_events(*[(libaudioviz.EventType.RESIZE, 100 + i, 50 + i) for i in range(500)])
+    
+    state = manager().update(events)
+    
+    assert (state.width, state.height) == (599, 549)
+
+
+def test_quit_and_escape_stop() -> None:
+    """Test that quit or Escape stops the app regardless of other events."""
+    assert not manager().update(make_events((libaudioviz.EventType.QUIT, 0, 0))).is_running
+    assert not manager().update(make_events(
+        (libaudioviz.EventType.KEYUP, 27, 0),
+        (libaudioviz.EventType.KEYDOWN, 27, 0),
+    )).is_running
+
+
+def test_mode_switches_are_counted() -> None:
+    """Test that every space press or button click advances the mode once."""
+    events = make_events(
+        (libaudioviz.EventType.KEYDOWN, 32, 0),
+        (libaudioviz.EventType.KEYUP, 32, 0),
+        (libaudioviz.EventType.MOUSEDOWN, 1, 0),
+        (libaudioviz.EventType.KEYDOWN, 32, 0),
+    )
+    
+    state = manager().update(events)
+    
+    expected = "bars"
+    for _ in range(3 % len(MODE_ORDER)):
+        expected = next_mode(expected)
+    assert state.mode == expected
+    assert state.is_running
+
+
+def test_headless_poll_events_returns_empty_records() -> None:
+    """Test that poll_events hands back a typed record array."""
+    renderer = libaudioviz.Renderer(32, 32)
+    renderer.initialize_headless()
+    
+    events = renderer.poll_events()
+    
+    assert events.dtype == libaudioviz.EVENT_DTYPE
+    assert events.dtype.names == ('type', 'data1', 'data2', 'timestamp')
+    assert len(events) == 0
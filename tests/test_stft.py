@@ -1,7 +1,9 @@
 """Tests for STFT computation."""
 
 import numpy as np
+import scipy.signal
 
+import libaudioviz
 from audioviz.audioviz.stft import compute_stft
 
 
@@ -48,3 +50,24 @@ def test_compute_stft_detects_frequency() -> None:
     
     # Should be close to 1000 Hz (within one bin)
     assert abs(peak_freq - frequency) < sample_rate / 2048
+
+
+def test_single_precision_heights_match_scipy_reference() -> None:
+    """Test that the float32 pipeline draws the same bar heights as float64 scipy."""
+    rng = np.random.default_rng(0)
+    sample_rate = 44100
+    t = np.arange(sample_rate) / sample_rate
+    # Tones spanning the display's dB range plus a noise floor near db_floor
+    samples = (0.5 * np.sin(2 * np.pi * 440 * t) + 0.01 * np.sin(2 * np.pi * 5000 * t)
+               + 1e-4 * rng.standard_normal(len(t)))
+    
+    _, _, Zxx = scipy.signal.stft(samples, fs=sample_rate, nperseg=1024, noverlap=512)
+    reference = np.clip((20.0 * np.log10(np.abs(Zxx) + 1e-10) + 60.0) / 50.0, 0.0, 1.0)
+    
+    _, _, magnitudes = compute_stft(samples.astype(np.float32), sample_rate, nperseg=1024)
+    heights = libaudioviz.normalize_db(magnitudes, -60.0, -10.0)
+    
+    assert magnitudes.dtype == np.float32
+    assert heights.dtype == np.float32
+    # Under a thousandth of the bar range: sub-pixel on any realistic window
+    np.testing.assert_allclose(heights, reference, atol=1e-3)
@@ -0,0 +1,72 @@
+"""Tests for the native streaming STFT."""
+
+import numpy as np
+import pytest
+import scipy.signal
+
+import libaudioviz
+from audioviz.audioviz.analysis import SpectrumStream
+from audioviz.audioviz.audio import AudioChunk
+
+
+def stream_all(samples: np.ndarray, nperseg: int, hop: int, block: int) -> np.ndarray:
+    """Feed samples block by block and collect every frame as (Times, Channels, Freqs)."""
+    channels = 1 if samples.ndim == 1 else samples.shape[1]
+    stft = libaudioviz.StreamingSTFT(nperseg, hop, channels)
+    frames = []
+    for start in range(0, len(samples), block):
+        stft.push(samples[start:start + block])
+        while (frame := stft.pop()) is not None:
+            frames.append(frame)
+    stft.finish()
+    while (frame := stft.pop()) is not None:
+        frames.append(frame)
+    return np.stack(frames)
+
+
+@pytest.mark.parametrize("nperseg", [256, 1024])
+def test_streaming_stft_matches_scipy(sample_rate: int, nperseg: int) -> None:
+    """Test that streamed frames match scipy.signal.stft magnitudes."""
+    rng = np.random.default_rng(0)
+    samples = rng.standard_normal(sample_rate // 2).astype(np.float32)
+    hop = nperseg // 2
+    
+    _, _, Zxx = scipy.signal.stft(samples, fs=sample_rate, nperseg=nperseg, noverlap=nperseg - hop)
+    frames = stream_all(samples, nperseg, hop, block=hop)
+    
+    assert frames.shape == (Zxx.shape[1], 1, Zxx.shape[0])
+    np.testing.assert_allclose(frames[:, 0, :], np.abs(Zxx.T), atol=1e-5)
+
+
+def test_streaming_stft_block_size_does_not_matter(stereo_channels: int) -> None:
+    """Test that odd block sizes give the same frames as hop-sized blocks."""
+    rng = np.random.default_rng(1)
+    samples = rng.standard_normal((10000, stereo_channels)).astype(np.float32)
+    
+    expected = stream_all(samples, 512, 256, block=256)
+    actual = stream_all(samples, 512, 256, block=777)
+    
+    np.testing.assert_array_equal(actual, expected)
+
+
+def test_frame_count_matches_scipy(sample_rate: int) -> None:
+    """Test that frame_count predicts scipy's frame count."""
+    for num_samples in (1024, 5000, sample_rate, sample_rate + 123):
+        _, t, _ = scipy.signal.stft(np.zeros(num_samples), nperseg=1024, noverlap=512)
+        assert libaudioviz.StreamingSTFT.frame_count(num_samples, 1024, 512) == len(t)
+
+
+def test_spectrum_stream_indices_survive_short_chunks(sample_rate: int) -> None:
+    """Test that chunks shorter than a hop do not shift SpectrumStream frame indices."""
+    rng = np.random.default_rng(2)
+    samples = rng.standard_normal(5000).astype(np.float32)
+    chunks = (
+        AudioChunk(samples[start:start + 100, np.newaxis], sample_rate, 1, start + 100 >= len(samples))
+        for start in range(0, len(samples), 100)
+    )
+    stream = SpectrumStream(chunks, len(samples), 1, 1024, 512)
+    expected = stream_all(samples, 1024, 512, block=512)
+
+    for index in range(stream.frame_count):
+        np.testing.assert_array_equal(stream.frame(index), expected[index])
+    assert stream.frame(stream.frame_count) is None
@@ -0,0 +1,94 @@
+"""Tests for skipping frames whose image matches the one on screen."""
+
+import numpy as np
+import pytest
+
+import libaudioviz
+
+
+WIDTH, HEIGHT = 64, 64
+
+
+@pytest.fixture
+def renderer() -> libaudioviz.Renderer:
+    """A headless renderer that skips frames within one pixel of the last one drawn."""
+    renderer = libaudioviz.Renderer(WIDTH, HEIGHT)
+    renderer.initialize_headless()
+    renderer.set_skip_unchanged(True, tolerance_px=1.0)
+    return renderer
+
+
+def draw_bar(renderer: libaudioviz.Renderer, height: int, green: int = 255) -> None:
+    """Present one frame holding a single bar of `height` pixels."""
+    renderer.clear(0, 0, 0, 255)
+    renderer.draw_rectangles(np.array([[8, HEIGHT - height, 8, height]], dtype=np.int32), 0, green, 0, 255)
+    renderer.present()
+
+
+def unchanged(renderer: libaudioviz.Renderer) -> int:
+    """Frames the renderer skipped so far."""
+    return renderer.get_stats()['unchanged_frames']
+
+
+def test_identical_frames_are_not_redrawn(renderer: libaudioviz.Renderer) -> None:
+    """Test that repeating a frame is counted as unchanged and keeps its pixels on screen."""
+    draw_bar(renderer, 20)
+    expected = renderer.read_pixels()
+    for _ in range(3):
+        draw_bar(renderer, 20)
+
+    stats = renderer.get_stats()
+    assert stats['unchanged_frames'] == 3
+    assert stats['frames'] == 4
+    np.testing.assert_array_equal(renderer.read_pixels(), expected)
+
+
+def test_changes_within_tolerance_are_skipped(renderer: libaudioviz.Renderer) -> None:
+    """Test that moves within the tolerance are skipped against the drawn frame, so they cannot creep."""
+    draw_bar(renderer, 20)
+    draw_bar(renderer, 21)
+    assert unchanged(renderer) == 1
+
+    # 22 is two pixels from the drawn 20, so it is drawn
+    draw_bar(renderer, 22)
+    assert unchanged(renderer) == 1
+    assert renderer.read_pixels()[HEIGHT - 22, 8, 1] == 255
+
+
+def test_colour_changes_are_always_drawn(renderer: libaudioviz.Renderer) -> None:
+    """Test that a frame with the same geometry in another colour is redrawn."""
+    draw_bar(renderer, 20)
+    draw_bar(renderer, 20, green=128)
+    assert unchanged(renderer) == 0
+    assert renderer.read_pixels()[HEIGHT - 1, 8, 1] == 128
+
+
+def test_invalidate_and_disable_force_redraws(renderer: libaudioviz.Renderer) -> None:
+    """Test that invalidate() redraws the next frame and that skipping can be turned off."""
+    draw_bar(renderer, 20)
+    renderer.invalidate()
+    draw_bar(renderer, 20)
+    assert unchanged(renderer) == 0
+
+    renderer.set_skip_unchanged(False)
+    assert not renderer.skip_unchanged
+    draw_bar(renderer, 20)
+    draw_bar(renderer, 20)
+    assert unchanged(renderer) == 0
+
+
+def test_waterfall_frames_always_scroll(renderer: libaudioviz.Renderer) -> None:
+    """Test that waterfall frames are never skipped, since each one scrolls the history."""
+    silence = np.zeros(32, dtype=np.float32)
+    for _ in range(3):
+        renderer.clear(0, 0, 0, 255)
+        renderer.draw_waterfall(silence)
+        renderer.present()
+    assert unchanged(renderer) == 0
+
+
+def test_negative_tolerance_raises() -> None:
+    """Test that a negative tolerance is rejected with ValueError."""
+    renderer = libaudioviz.Renderer(WIDTH, HEIGHT)
+    with pytest.raises(ValueError):
+        renderer.set_skip_unchanged(True, tolerance_px=-1.0)
@@ -0,0 +1,75 @@
+"""Tests for the Python visualizer geometry."""
+
+import math
+
+import numpy as np
+import pytest
+
+from audioviz.audioviz.primitives import Line, PackedLines
+from audioviz.audioviz.visualizers import circle_visualizer, radial_layout
+
+
+def reference_circle_lines(magnitudes: np.ndarray, width: int, height: int,
+                           scale: float, base_radius_ratio: float, mirror: bool) -> list[tuple]:
+    """Per-bin trig formulation of circle_visualizer."""
+    size = len(magnitudes)
+    center_x, center_y = width // 2, height // 2
+    max_radius = min(width, height) / 2.0
+    base_radius = max_radius * base_radius_ratio
+    lines = []
+    for i, mag in enumerate(magnitudes):
+        line_len = min(float(mag) * scale, max_radius - base_radius)
+        for angle in ([i * 2.0 * math.pi / size] +
+                      ([-i * 2.0 * math.pi / size] if mirror and i != 0 and not (size % 2 == 0 and i == size // 2) else [])):
+            lines.append((
+                int(center_x + math.cos(angle) * base_radius),
+                int(center_y + math.sin(angle) * base_radius),
+                int(center_x + math.cos(angle) * (base_radius + line_len)),
+                int(center_y + math.sin(angle) * (base_radius + line_len)),
+            ))
+    return lines
+
+
+@pytest.mark.parametrize("size", [1, 2, 7, 64])
+@pytest.mark.parametrize("mirror", [True, False])
+def test_circle_matches_per_bin_trig(size: int, mirror: bool) -> None:
+    """Test that the precomputed layout draws the same lines as per-bin trig."""
+    magnitudes = np.random.default_rng(size).uniform(0, 0.2, size).astype(np.float32)
+
+    batch = circle_visualizer(magnitudes, 1200, 800, mirror=mirror).batches[0]
+
+    expected = np.array(reference_circle_lines(magnitudes, 1200, 800, 3000.0, 0.2, mirror))
+    assert batch.line_array().shape == expected.shape
+    # np.cos and math.cos may differ in the last ulp, which can move a truncation
+    np.testing.assert_allclose(batch.line_array(), expected, atol=1)
+    assert [(l.x1, l.y1, l.x2, l.y2) for l in batch.lines] == batch.line_array().tolist()
+
+
+def test_radial_layout_is_reused_until_size_changes() -> None:
+    """Test that the layout is rebuilt only on a resize or bin-count change."""
+    first = radial_layout(64, 1200, 800, 0.2, True)
+
+    assert radial_layout(64, 1200, 800, 0.2, True) is first
+    assert radial_layout(64, 1000, 800, 0.2, True) is not first
+    assert radial_layout(32, 1000, 800, 0.2, True).bins.max() == 31
+
+
+def test_radial_layouts_are_kept_per_window_size() -> None:
+    """Test that outputs of different sizes do not rebuild each other's layout."""
+    small = radial_layout(64, 640, 480, 0.2, True)
+    large = radial_layout(64, 1920, 1080, 0.2, True)
+
+    assert radial_layout(64, 640, 480, 0.2, True) is small
+    assert radial_layout(64, 1920, 1080, 0.2, True) is large
+
+
+def test_circle_batch_builds_no_line_objects() -> None:
+    """Test that circle frames keep their lines packed and only build Line objects on access."""
+    magnitudes = np.full(16, 0.1, dtype=np.float32)
+
+    batch = circle_visualizer(magnitudes, 1200, 800).batches[0]
+
+    assert isinstance(batch.lines, PackedLines)
+    assert batch.lines.array is batch.line_array()
+    assert len(batch.lines) == len(batch.line_array()) > 0
+    assert batch.lines[0] == Line(*batch.line_array()[0].tolist())
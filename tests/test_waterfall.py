@@ -0,0 +1,104 @@
+"""Tests for the scrolling spectrogram ring texture."""
+
+import numpy as np
+import pytest
+
+import libaudioviz
+
+
+BINS = 32
+HISTORY = 64
+
+
+def waterfall_renderer() -> libaudioviz.Renderer:
+    """Headless renderer where every history column maps to one pixel column."""
+    renderer = libaudioviz.Renderer(HISTORY, BINS)
+    renderer.initialize_headless()
+    return renderer
+
+
+def push(renderer: libaudioviz.Renderer, magnitudes: np.ndarray) -> np.ndarray:
+    """Draw one waterfall frame and read it back."""
+    renderer.clear(0, 0, 0, 255)
+    renderer.draw_waterfall(magnitudes, history=HISTORY)
+    renderer.present()
+    return renderer.read_pixels()
+
+
+def tone(bin_index: int) -> np.ndarray:
+    """Magnitudes that are silent except for one full-scale bin."""
+    magnitudes = np.zeros(BINS, dtype=np.float32)
+    magnitudes[bin_index] = 1.0
+    return magnitudes
+
+
+def test_newest_column_is_drawn_at_the_right_edge() -> None:
+    """Test that each frame adds one column at the right and scrolls the rest left."""
+    renderer = waterfall_renderer()
+    silence = np.zeros(BINS, dtype=np.float32)
+
+    push(renderer, tone(5))
+    for _ in range(9):
+        pixels = push(renderer, silence)
+
+    # Bin 5 is drawn 5 rows above the bottom, 9 columns in from the right
+    column = HISTORY - 1 - 9
+    row = BINS - 1 - 5
+    assert pixels[row, column, :3].sum() > 600
+    np.testing.assert_array_equal(pixels[row, column + 1], pixels[row, HISTORY - 1])
+    np.testing.assert_array_equal(pixels[row - 1, column], pixels[row, 0])
+
+
+def test_history_wraps_around_the_ring() -> None:
+    """Test that columns older than the history are dropped after the ring wraps."""
+    renderer = waterfall_renderer()
+
+    first = push(renderer, tone(3))
+    for i in range(HISTORY * 2 + 7):
+        pixels = push(renderer, tone(10 + i % 4))
+
+    row = BINS - 1 - 3
+    assert first[row, HISTORY - 1, :3].sum() > 600
+    assert not (pixels[row, :, :3].sum(axis=1) > 600).any()
+    bright = np.flatnonzero(pixels[:, HISTORY - 1, :3].sum(axis=1) > 600)
+    assert list(bright) == [BINS - 1 - (10 + (HISTORY * 2 + 6) % 4)]
+
+
+def test_waterfall_is_a_native_mode() -> None:
+    """Test that the waterfall is reachable through the native mode registry."""
+    assert "waterfall" in libaudioviz.visualizer_modes()
+    renderer = waterfall_renderer()
+    kernel = libaudioviz.Visualizer("waterfall", history=HISTORY)
+
+    renderer.clear(0, 0, 0, 255)
+    kernel.draw(renderer, tone(8), 255, 255, 255, 255)
+    renderer.present()
+
+    assert renderer.read_pixels()[BINS - 1 - 8, HISTORY - 1, :3].sum() > 600
+
+
+def test_nan_magnitudes_draw_as_silence() -> None:
+    """Test that NaN and infinite magnitudes map into the palette instead of past it."""
+    renderer = waterfall_renderer()
+    magnitudes = np.zeros(BINS, dtype=np.float32)
+    magnitudes[3] = np.nan
+    magnitudes[7] = np.inf
+
+    pixels = push(renderer, magnitudes)
+
+    column = pixels[:, -1]
+    np.testing.assert_array_equal(column[BINS - 1 - 3], column[0])
+    assert column[BINS - 1 - 7].any()
+
+
+@pytest.mark.parametrize("options", [
+    {"history": 0},
+    {"history": -4},
+    {"db_floor": -10.0, "db_ceiling": -10.0},
+    {"db_floor": -10.0, "db_ceiling": -60.0},
+])
+def test_invalid_styles_raise(options: dict) -> None:
+    """Test that a non-positive history or an empty dB range is rejected with ValueError."""
+    renderer = waterfall_renderer()
+    with pytest.raises(ValueError):
+        renderer.draw_waterfall(np.zeros(BINS, dtype=np.float32), **options)
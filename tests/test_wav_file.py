@@ -0,0 +1,125 @@
+"""Tests for the memory-mapped WAV reader."""
+
+from pathlib import Path
+
+import numpy as np
+import pytest
+import soundfile as sf
+
+import libaudioviz
+from audioviz.audioviz.audio import open_wav
+
+
+SUBTYPES = {'PCM_U8': 'uint8', 'PCM_16': 'int16', 'PCM_24': 'int24', 'PCM_32': 'int32', 'FLOAT': 'float32'}
+
+
+@pytest.fixture
+def stereo_signal(sample_rate: int, duration_sec: float, frequency_hz: int) -> np.ndarray:
+    """Stereo test signal with a different tone per channel."""
+    t = np.linspace(0, duration_sec, int(sample_rate * duration_sec))
+    return np.column_stack([
+        0.8 * np.sin(2 * np.pi * frequency_hz * t),
+        0.3 * np.sin(2 * np.pi * 3 * frequency_hz * t),
+    ])
+
+
+def write_wav(path: Path, samples: np.ndarray, sample_rate: int, subtype: str) -> Path:
+    sf.write(path, samples, sample_rate, subtype=subtype)
+    return path
+
+
+@pytest.mark.parametrize("subtype", list(SUBTYPES))
+def test_read_matches_soundfile(
+    tmp_path: Path, stereo_signal: np.ndarray, sample_rate: int, subtype: str,
+) -> None:
+    """Test that converted samples match soundfile's float32 decode for every encoding."""
+    path = write_wav(tmp_path / "test.wav", stereo_signal, sample_rate, subtype)
+    expected, _ = sf.read(path, dtype='float32')
+
+    wav = libaudioviz.WavFile(str(path))
+    assert wav.encoding == SUBTYPES[subtype]
+    assert wav.sample_rate == sample_rate
+    assert wav.channels == 2
+    assert wav.frames == len(expected)
+    np.testing.assert_allclose(wav.read(0, wav.frames), expected, atol=1e-6)
+    np.testing.assert_allclose(wav.read(100, 50), expected[100:150], atol=1e-6)
+
+
+def test_samples_view_is_zero_copy_and_read_only(
+    tmp_path: Path, stereo_signal: np.ndarray, sample_rate: int,
+) -> None:
+    """Test that samples exposes the stored int16 data without a copy."""
+    path = write_wav(tmp_path / "test.wav", stereo_signal, sample_rate, 'PCM_16')
+    expected, _ = sf.read(path, dtype='int16')
+
+    view = libaudioviz.WavFile(str(path)).samples
+    assert view.dtype == np.int16
+    assert view.shape == expected.shape
+    assert not view.flags.writeable
+    assert not view.flags.owndata
+    np.testing.assert_array_equal(view, expected)
+
+
+def test_int24_samples_view_is_raw_bytes(
+    tmp_path: Path, stereo_signal: np.ndarray, sample_rate: int,
+) -> None:
+    """Test that int24 samples are exposed as (frames, channels, 3) bytes."""
+    path = write_wav(tmp_path / "test.wav", stereo_signal, sample_rate, 'PCM_24')
+    expected, _ = sf.read(path, dtype='int32')
+
+    view = libaudioviz.WavFile(str(path)).samples
+    assert view.dtype == np.uint8
+    assert view.shape == (*expected.shape, 3)
+    # soundfile returns 24-bit samples in the top bytes of an int32
+    widened = (view[..., 0].astype(np.uint32) << 8 | view[..., 1].astype(np.uint32) << 16
+               | view[..., 2].astype(np.uint32) << 24)
+    np.testing.assert_array_equal(widened.view(np.int32), expected)
+
+
+def test_read_past_end_raises(tmp_path: Path, stereo_signal: np.ndarray, sample_rate: int) -> None:
+    """Test that reading beyond the last frame raises IndexError."""
+    path = write_wav(tmp_path / "test.wav", stereo_signal, sample_rate, 'PCM_16')
+    wav = libaudioviz.WavFile(str(path))
+    with pytest.raises(IndexError):
+        wav.read(wav.frames - 10, 20)
+
+
+@pytest.mark.parametrize("subtype", ['PCM_16', 'PCM_24', 'FLOAT'])
+def test_batch_stft_matches_float_input(
+    tmp_path: Path, stereo_signal: np.ndarray, sample_rate: int, subtype: str,
+) -> None:
+    """Test that batch_stft on a WavFile equals batch_stft on the decoded samples."""
+    path = write_wav(tmp_path / "test.wav", stereo_signal, sample_rate, subtype)
+    wav = libaudioviz.WavFile(str(path))
+
+    expected = libaudioviz.batch_stft(wav.read(0, wav.frames), 1024, 512)
+    np.testing.assert_array_equal(libaudioviz.batch_stft(wav, 1024, 512), expected)
+
+
+def test_batch_stft_frame_ranges_tile_the_full_run(
+    tmp_path: Path, stereo_signal: np.ndarray, sample_rate: int,
+) -> None:
+    """Test that consecutive frame ranges concatenate to the full analysis."""
+    path = write_wav(tmp_path / "test.wav", stereo_signal, sample_rate, 'PCM_16')
+    wav = libaudioviz.WavFile(str(path))
+    full = libaudioviz.batch_stft(wav, 1024, 512)
+
+    parts = [libaudioviz.batch_stft(wav, 1024, 512, first_frame=first, frames=7)
+             for first in range(0, len(full), 7)]
+    np.testing.assert_array_equal(np.concatenate(parts), full)
+    assert len(libaudioviz.batch_stft(wav, 1024, 512, first_frame=len(full))) == 0
+
+
+def test_open_wav_rejects_other_formats(tmp_path: Path, stereo_signal: np.ndarray, sample_rate: int) -> None:
+    """Test that open_wav returns None for files that are not WAV."""
+    path = tmp_path / "test.flac"
+    sf.write(path, stereo_signal, sample_rate)
+    assert open_wav(path) is None
+    with pytest.raises(RuntimeError):
+        libaudioviz.WavFile(str(path))
+
+
+def test_open_wav_missing_file_raises(tmp_path: Path) -> None:
+    """Test that open_wav raises FileNotFoundError for a missing file."""
+    with pytest.raises(FileNotFoundError):
+        open_wav(tmp_path / "missing.wav")